@@ -11,6 +11,7 @@ QT_BEGIN_NAMESPACE
 QQmlProfilerAdapter::QQmlProfilerAdapter(QQmlProfilerService *service, QQmlEnginePrivate *engine)
 {
     engine->profiler = new QQmlProfiler;
+    engine->profiler->setEngine(engine);
     init(service, engine->profiler);
 }
 
@@ -39,6 +40,8 @@ void QQmlProfilerAdapter::init(QQmlProfilerService *service, QQmlProfiler *profi
             profiler, &QQmlProfiler::setTimer);
     connect(profiler, &QQmlProfiler::dataReady,
             this, &QQmlProfilerAdapter::receiveData);
+    connect(profiler, &QQmlProfiler::bindingStatisticsReady,
+            this, &QQmlProfilerAdapter::receiveBindingStatistics);
 }
 
 // convert to QByteArrays that can be sent to the debug client
@@ -100,6 +103,13 @@ qint64 QQmlProfilerAdapter::sendMessages(qint64 until, QList<QByteArray> &messag
         ++next;
     }
 
+    if (!statistics.isEmpty()) {
+        if (statisticsTime > until)
+            return statisticsTime;
+        messages.append(statistics);
+        statistics.clear();
+    }
+
     next = 0;
     data.clear();
     locations.clear();
@@ -122,6 +132,28 @@ void QQmlProfilerAdapter::receiveData(const QVector<QQmlProfilerData> &new_data,
     service->dataReady(this);
 }
 
+// Each message carries the aggregated statistics of one binding location:
+// time, BindingStatistics, Binding, file, line, column, evaluations, total time in ns,
+// captured dependencies, dependency churn, recaptures.
+void QQmlProfilerAdapter::receiveBindingStatistics(
+        qint64 time, const QList<QQmlBindingStatistics::Entry> &entries)
+{
+    QQmlDebugPacket ds;
+    for (const QQmlBindingStatistics::Entry &entry : entries) {
+        ds << time << int(QQmlProfilerDefinitions::BindingStatistics)
+           << int(QQmlProfilerDefinitions::Binding) << entry.location.sourceFile
+           << static_cast<qint32>(entry.location.line)
+           << static_cast<qint32>(entry.location.column)
+           << static_cast<qint64>(entry.evaluations) << entry.totalTime
+           << static_cast<qint64>(entry.capturedDependencies)
+           << static_cast<qint64>(entry.dependencyChurn)
+           << static_cast<qint64>(entry.recaptures);
+        statistics.append(ds.squeezedData());
+        ds.clear();
+    }
+    statisticsTime = time;
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qqmlprofileradapter.cpp"
@@ -29,11 +29,15 @@ public:
 
     void receiveData(const QVector<QQmlProfilerData> &new_data,
                      const QQmlProfiler::LocationHash &locations);
+    void receiveBindingStatistics(qint64 time,
+                                  const QList<QQmlBindingStatistics::Entry> &entries);
 
 private:
     void init(QQmlProfilerService *service, QQmlProfiler *profiler);
     QVector<QQmlProfilerData> data;
     QQmlProfiler::LocationHash locations;
+    QList<QByteArray> statistics;
+    qint64 statisticsTime = 0;
     int next;
 };
 
@@ -103,6 +103,8 @@ static void qQuickProfilerDataToByteArrays(const QQuickProfilerData &data,
                     case QQuickProfiler::SceneGraphWindowsAnimations: ds << data.subtime_1; break;
                     // non-threaded rendering: polish time
                     case QQuickProfiler::SceneGraphPolishFrame: ds << data.subtime_1; break;
+                    // FrameLatency: deferTime, polishAndSyncTime, predicted time until presented
+                    case QQuickProfiler::SceneGraphFrameLatency: ds << data.subtime_1 << data.subtime_2 << data.subtime_3; break;
                     default:break;
                 }
                 break;
@@ -2494,6 +2494,14 @@ function(qt6_target_qml_sources target)
         endforeach()
     endforeach()
 
+    # Also used after the loop, for the batch invocation
+    if(CMAKE_GENERATOR STREQUAL "Ninja Multi-Config" AND CMAKE_VERSION VERSION_GREATER_EQUAL "3.20")
+        set(qmlcachegen_cmd "$<COMMAND_CONFIG:${qmlcachegen}>")
+    else()
+        set(qmlcachegen_cmd "${qmlcachegen}")
+    endif()
+    _qt_internal_get_tool_wrapper_script_path(tool_wrapper)
+
     set(generated_sources_other_scope)
     foreach(qml_file_src IN LISTS arg_QML_FILES)
         # This is to facilitate updating code that used the earlier tech preview
@@ -2634,34 +2642,37 @@ function(qt6_target_qml_sources target)
                 "${CMAKE_CURRENT_BINARY_DIR}/.rcc/qmlcache/${target}_${compiled_file}.cpp")
             get_filename_component(out_dir ${compiled_file} DIRECTORY)
 
-            if(CMAKE_GENERATOR STREQUAL "Ninja Multi-Config" AND CMAKE_VERSION VERSION_GREATER_EQUAL "3.20")
-                set(qmlcachegen_cmd "$<COMMAND_CONFIG:${qmlcachegen}>")
+            if(QT_QMLCACHEGEN_BATCH)
+                # Compiled below, by a single qmlcachegen invocation for all files.
+                string(APPEND cachegen_batch_contents
+                    "${file_absolute}\t${file_resource_path}\t${compiled_file}\n"
+                )
+                list(APPEND cachegen_batch_inputs "${file_absolute}")
+                list(APPEND cachegen_batch_outputs "${compiled_file}")
+                list(APPEND cachegen_batch_dirs "${out_dir}")
             else()
-                set(qmlcachegen_cmd "${qmlcachegen}")
+                add_custom_command(
+                    OUTPUT ${compiled_file}
+                    COMMAND ${CMAKE_COMMAND} -E make_directory ${out_dir}
+                    COMMAND
+                        ${tool_wrapper}
+                        ${qmlcachegen_cmd}
+                        --bare
+                        --resource-path "${file_resource_path}"
+                        ${cachegen_args}
+                        -o "${compiled_file}"
+                        "${file_absolute}"
+                    COMMAND_EXPAND_LISTS
+                    DEPENDS
+                        ${qmlcachegen_cmd}
+                        "${file_absolute}"
+                        $<TARGET_PROPERTY:${target},_qt_generated_qrc_files>
+                        "$<$<BOOL:${qmltypes_file}>:${qmltypes_file}>"
+                        "${qmldir_file}"
+                    VERBATIM
+                )
             endif()
 
-            _qt_internal_get_tool_wrapper_script_path(tool_wrapper)
-            add_custom_command(
-                OUTPUT ${compiled_file}
-                COMMAND ${CMAKE_COMMAND} -E make_directory ${out_dir}
-                COMMAND
-                    ${tool_wrapper}
-                    ${qmlcachegen_cmd}
-                    --bare
-                    --resource-path "${file_resource_path}"
-                    ${cachegen_args}
-                    -o "${compiled_file}"
-                    "${file_absolute}"
-                COMMAND_EXPAND_LISTS
-                DEPENDS
-                    ${qmlcachegen_cmd}
-                    "${file_absolute}"
-                    $<TARGET_PROPERTY:${target},_qt_generated_qrc_files>
-                    "$<$<BOOL:${qmltypes_file}>:${qmltypes_file}>"
-                    "${qmldir_file}"
-                VERBATIM
-            )
-
             target_sources(${target} PRIVATE ${compiled_file})
             set_source_files_properties(${compiled_file} PROPERTIES
                 SKIP_AUTOGEN ON
@@ -2686,6 +2697,35 @@ function(qt6_target_qml_sources target)
         endif()
     endforeach()
 
+    if(cachegen_batch_outputs)
+        # One qmlcachegen process loads the imports once per worker thread and compiles all
+        # files of this call. Any change to one of the files recompiles all of them.
+        string(SHA1 batch_hash "${cachegen_batch_contents}")
+        set(batch_file
+            "${CMAKE_CURRENT_BINARY_DIR}/.rcc/qmlcache/${target}_batch_${batch_hash}.txt")
+        file(GENERATE OUTPUT "${batch_file}" CONTENT "${cachegen_batch_contents}")
+        list(REMOVE_DUPLICATES cachegen_batch_dirs)
+        add_custom_command(
+            OUTPUT ${cachegen_batch_outputs}
+            COMMAND ${CMAKE_COMMAND} -E make_directory ${cachegen_batch_dirs}
+            COMMAND
+                ${tool_wrapper}
+                ${qmlcachegen_cmd}
+                --bare
+                ${cachegen_args}
+                --batch "${batch_file}"
+            COMMAND_EXPAND_LISTS
+            DEPENDS
+                ${qmlcachegen_cmd}
+                ${cachegen_batch_inputs}
+                "${batch_file}"
+                $<TARGET_PROPERTY:${target},_qt_generated_qrc_files>
+                "$<$<BOOL:${qmltypes_file}>:${qmltypes_file}>"
+                "${qmldir_file}"
+            VERBATIM
+        )
+    endif()
+
     if(ANDROID)
         _qt_internal_collect_qml_root_paths("${target}" ${arg_QML_FILES})
     endif()
@@ -3006,6 +3046,27 @@ function(_qt_internal_qml_type_registration target)
         VERBATIM
     )
 
+    # Optionally pre-parse the qmltypes file so that qmlcachegen, qmllint and the other tools
+    # don't have to parse its text every time they import the module.
+    set(preparsed_types_file "")
+    if(QT_QML_PREPARSE_QMLTYPES AND TARGET ${QT_CMAKE_EXPORT_NAMESPACE}::qmlcachegen)
+        set(preparsed_types_file "${plugin_types_file}c")
+        add_custom_command(
+            OUTPUT
+                ${preparsed_types_file}
+            DEPENDS
+                ${plugin_types_file}
+                ${QT_CMAKE_EXPORT_NAMESPACE}::qmlcachegen
+            COMMAND
+                ${tool_wrapper}
+                $<TARGET_FILE:${QT_CMAKE_EXPORT_NAMESPACE}::qmlcachegen>
+                -o ${preparsed_types_file}
+                ${plugin_types_file}
+            COMMENT "Pre-parsing QML type information for target ${target}"
+            VERBATIM
+        )
+    endif()
+
     # The ${target}_qmllint targets need to depend on the generation of all
     # *.qmltypes files in the build. We have no way of reliably working out
     # which QML modules a given target depends on at configure time, so we
@@ -3018,6 +3079,7 @@ function(_qt_internal_qml_type_registration target)
         DEPENDS
             ${type_registration_cpp_file}
             ${plugin_types_file}
+            ${preparsed_types_file}
     )
     _qt_internal_assign_to_internal_targets_folder(${target}_qmltyperegistration)
     if(NOT TARGET all_qmltyperegistrations)
@@ -10,25 +10,51 @@ QQmlProfiler::QQmlProfiler() : featuresEnabled(0)
 {
     static int metatype = qRegisterMetaType<QVector<QQmlProfilerData> >();
     static int metatype2 = qRegisterMetaType<QQmlProfiler::LocationHash> ();
+    static int metatype3 = qRegisterMetaType<QList<QQmlBindingStatistics::Entry>>();
     Q_UNUSED(metatype);
     Q_UNUSED(metatype2);
+    Q_UNUSED(metatype3);
     m_timer.start();
 }
 
 void QQmlProfiler::startProfiling(quint64 features)
 {
     featuresEnabled = features;
+    if (m_engine && (features & (1 << ProfileBindingStatistics)))
+        m_engine->setBindingStatisticsEnabled(true);
 }
 
 void QQmlProfiler::stopProfiling()
 {
+    const bool bindingStatistics = featuresEnabled & (1 << ProfileBindingStatistics);
+    reportBindingStatistics();
     featuresEnabled = false;
     reportData();
     m_locations.clear();
+    if (m_engine && bindingStatistics)
+        m_engine->setBindingStatisticsEnabled(false);
+}
+
+// Binding statistics are sent as aggregates covering the time since the previous report.
+void QQmlProfiler::reportBindingStatistics()
+{
+    if (!m_engine || !m_engine->bindingStatistics
+            || !(featuresEnabled & (1 << ProfileBindingStatistics))) {
+        return;
+    }
+
+    const QList<QQmlBindingStatistics::Entry> entries
+            = m_engine->bindingStatistics->takeEntries();
+    if (!entries.isEmpty())
+        emit bindingStatisticsReady(m_timer.nsecsElapsed(), entries);
 }
 
 void QQmlProfiler::reportData()
 {
+    // Send the statistics first, so that they are already queued when dataReady() makes
+    // the adapter report back to the service.
+    reportBindingStatistics();
+
     LocationHash resolved;
     resolved.reserve(m_locations.size());
     for (auto it = m_locations.begin(), end = m_locations.end(); it != end; ++it) {
@@ -17,6 +17,7 @@
 
 #include <private/qfinitestack_p.h>
 #include <private/qqmlbinding_p.h>
+#include <private/qqmlbindingstatistics_p.h>
 #include <private/qqmlboundsignal_p.h>
 #include <private/qqmlglobal_p.h>
 #include <private/qv4function_p.h>
@@ -352,10 +353,17 @@ public:
     void reportData();
     void setTimer(const QElapsedTimer &timer) { m_timer = timer; }
 
+    // The engine whose binding statistics are switched on by ProfileBindingStatistics.
+    void setEngine(QQmlEnginePrivate *engine) { m_engine = engine; }
+
 Q_SIGNALS:
     void dataReady(const QVector<QQmlProfilerData> &, const QQmlProfiler::LocationHash &);
+    void bindingStatisticsReady(qint64 time, const QList<QQmlBindingStatistics::Entry> &entries);
 
 protected:
+    void reportBindingStatistics();
+
+    QQmlEnginePrivate *m_engine = nullptr;
     QElapsedTimer m_timer;
     QHash<quintptr, RefLocation> m_locations;
     QVector<QQmlProfilerData> m_data;
@@ -35,6 +35,7 @@ struct QQmlProfilerDefinitions {
         MemoryAllocation,
         DebugMessage,
         Quick3DFrame,
+        BindingStatistics,
 
         MaximumMessage
     };
@@ -83,6 +84,7 @@ struct QQmlProfilerDefinitions {
         SceneGraphWindowsRenderShow,    // Unused
         SceneGraphWindowsAnimations,    // GUI Thread
         SceneGraphPolishFrame,          // GUI Thread
+        SceneGraphFrameLatency,         // GUI Thread
 
         MaximumSceneGraphFrameType,
         NumRenderThreadFrameTypes = SceneGraphPolishAndSync,
@@ -119,6 +121,7 @@ struct QQmlProfilerDefinitions {
         ProfileInputEvents,
         ProfileDebugMessages,
         ProfileQuick3D,
+        ProfileBindingStatistics,
 
         MaximumProfileFeature
     };
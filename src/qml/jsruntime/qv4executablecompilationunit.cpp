@@ -26,6 +26,8 @@
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qcryptographichash.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 namespace QV4 {
@@ -139,30 +141,20 @@ void ExecutableCompilationUnit::populate()
         }
     }
 
+    // The functions themselves are only created once they are used. Nested functions that
+    // are never reached and anything in components that are never instantiated don't need one.
     runtimeFunctions.resize(data->functionTableSize);
     static bool ignoreAotCompiledFunctions
             = qEnvironmentVariableIsSet("QV4_FORCE_INTERPRETER")
             || !(engine->diskCacheOptions() & ExecutionEngine::DiskCache::AotNative);
 
-    const QQmlPrivate::AOTCompiledFunction *aotFunction
-            = ignoreAotCompiledFunctions ? nullptr : m_compilationUnit->aotCompiledFunctions;
-
-    auto advanceAotFunction = [&](int i) -> const QQmlPrivate::AOTCompiledFunction * {
-        if (aotFunction) {
-            if (aotFunction->functionPtr) {
-                if (aotFunction->extraData == i)
-                    return aotFunction++;
-            } else {
-                aotFunction = nullptr;
-            }
-        }
-        return nullptr;
-    };
-
-    for (int i = 0 ;i < runtimeFunctions.size(); ++i) {
-        const QV4::CompiledData::Function *compiledFunction = data->functionAt(i);
-        runtimeFunctions[i] = QV4::Function::create(engine, this, compiledFunction,
-                                                    advanceAotFunction(i));
+    m_aotFunctionsBegin = ignoreAotCompiledFunctions
+            ? nullptr
+            : m_compilationUnit->aotCompiledFunctions;
+    m_aotFunctionsEnd = m_aotFunctionsBegin;
+    if (m_aotFunctionsEnd) {
+        while (m_aotFunctionsEnd->functionPtr)
+            ++m_aotFunctionsEnd;
     }
 
     Scope scope(engine);
@@ -190,14 +182,42 @@ void ExecutableCompilationUnit::populate()
         for (uint i = 0, end = totalStringCount(); i < end; ++i)
             qDebug() << "    " << i << ":" << runtimeStrings[i]->toQString();
         qDebug() << "=== Closure table";
-        for (uint i = 0; i < data->functionTableSize; ++i)
-            qDebug() << "    " << i << ":" << runtimeFunctions[i]->name()->toQString();
+        for (uint i = 0; i < data->functionTableSize; ++i) {
+            qDebug() << "    " << i << ":"
+                     << runtimeStrings[data->functionAt(i)->nameIndex]->toQString();
+        }
         qDebug() << "root function at index "
                  << (data->indexOfRootFunction != -1
                              ? data->indexOfRootFunction : 0);
     }
 }
 
+QV4::Function *ExecutableCompilationUnit::createRuntimeFunction(int index) const
+{
+    Q_ASSERT(engine);
+    Q_ASSERT(!runtimeFunctions.at(index));
+
+    const auto aotFunction = std::lower_bound(
+            m_aotFunctionsBegin, m_aotFunctionsEnd, index,
+            [](const QQmlPrivate::AOTCompiledFunction &function, int functionIndex) {
+                return function.extraData < functionIndex;
+            });
+
+    QV4::Function *function = QV4::Function::create(
+            engine, const_cast<ExecutableCompilationUnit *>(this), unitData()->functionAt(index),
+            (aotFunction != m_aotFunctionsEnd && aotFunction->extraData == index)
+                    ? aotFunction
+                    : nullptr);
+    runtimeFunctions[index] = function;
+    return function;
+}
+
+qsizetype ExecutableCompilationUnit::createdRuntimeFunctionCount() const
+{
+    return std::count_if(runtimeFunctions.cbegin(), runtimeFunctions.cend(),
+                         [](const QV4::Function *function) { return function != nullptr; });
+}
+
 Heap::Object *ExecutableCompilationUnit::templateObjectAt(int index) const
 {
     const CompiledData::Unit *data = m_compilationUnit->data;
@@ -246,9 +266,12 @@ void ExecutableCompilationUnit::clear()
     delete [] runtimeLookups;
     runtimeLookups = nullptr;
 
-    for (QV4::Function *f : std::as_const(runtimeFunctions))
-        f->destroy();
+    for (QV4::Function *f : std::as_const(runtimeFunctions)) {
+        if (f)
+            f->destroy();
+    }
     runtimeFunctions.clear();
+    m_aotFunctionsBegin = m_aotFunctionsEnd = nullptr;
 
     free(runtimeStrings);
     runtimeStrings = nullptr;
@@ -49,7 +49,7 @@ struct CompilationUnitRuntimeData
     const StaticValue **imports = nullptr;
 
     QV4::Lookup *runtimeLookups = nullptr;
-    QVector<QV4::Function *> runtimeFunctions;
+    mutable QVector<QV4::Function *> runtimeFunctions;
     QVector<QV4::Heap::InternalClass *> runtimeBlocks;
     mutable QVector<QV4::Heap::Object *> templateObjects;
 };
@@ -216,10 +216,14 @@ public:
 
         const auto *data = unitData();
         return data->indexOfRootFunction != -1
-                ? runtimeFunctions[data->indexOfRootFunction]
+                ? runtimeFunction(data->indexOfRootFunction)
                 : nullptr;
     }
 
+    // The entries of runtimeFunctions are created on first use.
+    inline QV4::Function *runtimeFunction(int index) const;
+    qsizetype createdRuntimeFunctionCount() const;
+
     void populate();
     void clear();
 
@@ -233,6 +237,10 @@ private:
     QQmlRefPointer<CompiledData::CompilationUnit> m_compilationUnit;
     Heap::Module *m_module = nullptr;
 
+    // AOT compiled functions to be used for the runtime functions, sorted by function index.
+    const QQmlPrivate::AOTCompiledFunction *m_aotFunctionsBegin = nullptr;
+    const QQmlPrivate::AOTCompiledFunction *m_aotFunctionsEnd = nullptr;
+
     struct ResolveSetEntry
     {
         ResolveSetEntry() {}
@@ -256,6 +264,7 @@ private:
     QUrl urlAt(int index) const { return QUrl(stringAt(index)); }
 
     Q_NEVER_INLINE IdentifierHash createNamedObjectsPerComponent(int componentObjectIndex);
+    Q_NEVER_INLINE QV4::Function *createRuntimeFunction(int index) const;
     const CompiledData::ExportEntry *lookupNameInExportTable(
             const CompiledData::ExportEntry *firstExportEntry, int tableSize,
             QV4::String *name) const;
@@ -274,6 +283,14 @@ IdentifierHash ExecutableCompilationUnit::namedObjectsPerComponent(int component
     return *it;
 }
 
+QV4::Function *ExecutableCompilationUnit::runtimeFunction(int index) const
+{
+    Q_ASSERT(index >= 0 && index < runtimeFunctions.size());
+    if (QV4::Function *function = runtimeFunctions.at(index); Q_LIKELY(function))
+        return function;
+    return createRuntimeFunction(index);
+}
+
 } // namespace QV4
 
 QT_END_NAMESPACE
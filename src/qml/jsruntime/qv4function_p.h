@@ -121,7 +121,7 @@ public:
     {
         if (compiledFunction->nestedFunctionIndex == std::numeric_limits<uint32_t>::max())
             return nullptr;
-        return executableCompilationUnit()->runtimeFunctions[compiledFunction->nestedFunctionIndex];
+        return executableCompilationUnit()->runtimeFunction(compiledFunction->nestedFunctionIndex);
     }
 };
 
@@ -129,6 +129,7 @@ struct Q_QML_EXPORT Lookup {
             quintptr unused1;
             quintptr unused2;
             int objectId;
+            int componentObjectIndex; // Only for ids in parent contexts
         } qmlContextIdObjectLookup;
         struct {
             // Same as protoLookup, as used for global lookups
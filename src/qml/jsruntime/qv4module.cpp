@@ -26,7 +26,7 @@ void Heap::Module::init(ExecutionEngine *engine, ExecutableCompilationUnit *modu
     unit = moduleUnit;
     self.set(engine, this);
 
-    Function *moduleFunction = unit->runtimeFunctions[unit->unitData()->indexOfRootFunction];
+    Function *moduleFunction = unit->runtimeFunction(unit->unitData()->indexOfRootFunction);
 
     const uint locals = moduleFunction->compiledFunction->nLocals;
     const size_t requiredMemory = sizeof(QV4::CallContext::Data) - sizeof(Value) + sizeof(Value) * locals;
@@ -76,7 +76,7 @@ void Module::evaluate()
     unit->evaluateModuleRequests();
 
     ExecutionEngine *v4 = engine();
-    Function *moduleFunction = unit->runtimeFunctions[unit->unitData()->indexOfRootFunction];
+    Function *moduleFunction = unit->runtimeFunction(unit->unitData()->indexOfRootFunction);
     JSTypesStackFrame frame;
     frame.init(moduleFunction, nullptr, 0);
     frame.setupJSFrame(v4->jsStackTop, Value::undefinedValue(), d()->scope,
@@ -280,7 +280,7 @@ void RuntimeHelpers::numberToString(QString *result, double num, int radix)
 ReturnedValue Runtime::Closure::call(ExecutionEngine *engine, int functionId)
 {
     QV4::Function *clos = engine->currentStackFrame->v4Function->executableCompilationUnit()
-                                  ->runtimeFunctions[functionId];
+                                  ->runtimeFunction(functionId);
     Q_ASSERT(clos);
     ExecutionContext *current = engine->currentContext();
     if (clos->isGenerator())
@@ -1821,7 +1821,7 @@ ReturnedValue Runtime::ObjectLiteral::call(ExecutionEngine *engine, int classId,
             Q_ASSERT(args[2].isInteger());
             int functionId = args[2].integerValue();
             QV4::Function *clos = engine->currentStackFrame->v4Function->executableCompilationUnit()
-                                          ->runtimeFunctions[functionId];
+                                          ->runtimeFunction(functionId);
             Q_ASSERT(clos);
 
             PropertyKey::FunctionNamePrefix prefix = PropertyKey::None;
@@ -1894,7 +1894,7 @@ ReturnedValue Runtime::CreateClass::call(ExecutionEngine *engine, int classIndex
     ExecutionContext *current = engine->currentContext();
 
     ScopedFunctionObject constructor(scope);
-    QV4::Function *f = cls->constructorFunction != UINT_MAX ? unit->runtimeFunctions[cls->constructorFunction] : nullptr;
+    QV4::Function *f = cls->constructorFunction != UINT_MAX ? unit->runtimeFunction(cls->constructorFunction) : nullptr;
     constructor = FunctionObject::createConstructorFunction(current, f, proto, !superClass.isEmpty())->asReturnedValue();
     constructor->setPrototypeUnchecked(constructorParent);
     Value argCount = Value::fromInt32(f ? f->nFormals : 0);
@@ -1927,7 +1927,7 @@ ReturnedValue Runtime::CreateClass::call(ExecutionEngine *engine, int classIndex
             name = unit->runtimeStrings[methods[i].name];
             propertyName = name->toPropertyKey();
         }
-        QV4::Function *f = unit->runtimeFunctions[methods[i].function];
+        QV4::Function *f = unit->runtimeFunction(methods[i].function);
         Q_ASSERT(f);
         PropertyKey::FunctionNamePrefix prefix = PropertyKey::None;
         if (methods[i].type == CompiledData::Method::Getter)
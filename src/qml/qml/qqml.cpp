@@ -20,8 +20,10 @@
 #include <private/qv4dateobject_p.h>
 #include <private/qv4errorobject_p.h>
 #include <private/qv4identifiertable_p.h>
+#include <private/qv4jscall_p.h>
 #include <private/qv4lookup_p.h>
 #include <private/qv4qobjectwrapper_p.h>
+#include <private/qv4runtime_p.h>
 
 #include <QtCore/qmutex.h>
 
@@ -1660,6 +1662,55 @@ QJSValue AOTCompiledContext::javaScriptGlobalProperty(uint nameIndex) const
     return QJSValuePrivate::fromReturnedValue(global->get(name->toPropertyKey()));
 }
 
+QJSValue AOTCompiledContext::createClosure(uint functionIndex) const
+{
+    // The AOT-compiled function runs in its own stack frame, with the QML context as current
+    // context. That is what the closure captures.
+    return QJSValuePrivate::fromReturnedValue(
+            QV4::Runtime::Closure::call(engine->handle(), int(functionIndex)));
+}
+
+void AOTCompiledContext::callJSValue(
+        const QJSValue &function, void **args, const QMetaType *types, int argc) const
+{
+    QV4::Scope scope(engine->handle());
+    QV4::ScopedValue value(scope, QJSValuePrivate::convertToReturnedValue(scope.engine, function));
+    QV4::ScopedFunctionObject functionObject(scope, value);
+    if (!functionObject) {
+        scope.engine->throwTypeError(
+                    QStringLiteral("%1 is not a function").arg(value->toQStringNoThrow()));
+        return;
+    }
+
+    functionObject->call(nullptr, args, types, argc);
+}
+
+QJSValue AOTCompiledContext::objectLiteral(
+        uint internalClassId, void **args, const QMetaType *types, int argc) const
+{
+    QV4::Scope scope(engine->handle());
+    QV4::Value *values = scope.alloc(argc);
+    for (int i = 0; i < argc; ++i)
+        values[i] = scope.engine->metaTypeToJS(types[i], args[i]);
+    return QJSValuePrivate::fromReturnedValue(
+            QV4::Runtime::ObjectLiteral::call(scope.engine, int(internalClassId), values, argc));
+}
+
+void AOTCompiledContext::setJSValueProperty(
+        uint lookupIndex, const QJSValue &object, const QJSValue &value) const
+{
+    QV4::Lookup *l = compilationUnit->runtimeLookups + lookupIndex;
+    QV4::Scope scope(engine->handle());
+    QV4::ScopedValue base(scope, QJSValuePrivate::convertToReturnedValue(scope.engine, object));
+    QV4::ScopedValue v(scope, QJSValuePrivate::convertToReturnedValue(scope.engine, value));
+
+    // Same as the SetLookup instruction in the interpreter.
+    if (!l->setter(l, scope.engine, *base, v)
+            && scope.engine->currentStackFrame->v4Function->isStrict()) {
+        scope.engine->throwTypeError();
+    }
+}
+
 const QLoggingCategory *AOTCompiledContext::resolveLoggingCategory(QObject *wrapper, bool *ok) const
 {
     if (wrapper) {
@@ -1776,12 +1827,26 @@ bool AOTCompiledContext::loadContextIdLookup(uint index, void *target) const
         context = qmlContext;
     } else if (l->qmlContextPropertyGetter
                == QV4::QQmlContextWrapper::lookupIdObjectInParentContext) {
-        QV4::Scope scope(engine->handle());
-        QV4::ScopedString name(scope, compilationUnit->runtimeStrings[l->nameIndex]);
-        for (context = qmlContext; context; context = context->parent().data()) {
-            objectId = context->propertyIndex(name);
-            if (objectId != -1 && objectId < context->numIdValues())
+        // The object lives in the context of an enclosing component of the same document.
+        // Find that context by its component rather than by name. The number of contexts in
+        // between depends on how the inner component was instantiated.
+        const int componentObjectIndex = l->qmlContextIdObjectLookup.componentObjectIndex;
+        for (context = qmlContext->parent().data(); context; context = context->parent().data()) {
+            if (context->isComponentContext(compilationUnit, componentObjectIndex)) {
+                objectId = l->qmlContextIdObjectLookup.objectId;
                 break;
+            }
+        }
+
+        if (!context) {
+            // Unusual context hierarchy. Fall back to resolving the name.
+            QV4::Scope scope(engine->handle());
+            QV4::ScopedString name(scope, compilationUnit->runtimeStrings[l->nameIndex]);
+            for (context = qmlContext; context; context = context->parent().data()) {
+                objectId = context->propertyIndex(name);
+                if (objectId != -1 && objectId < context->numIdValues())
+                    break;
+            }
         }
     } else {
         return false;
@@ -1812,6 +1877,8 @@ void AOTCompiledContext::initLoadContextIdLookup(uint index) const
             l->qmlContextIdObjectLookup.objectId = propertyIdx;
             l->qmlContextPropertyGetter = QV4::QQmlContextWrapper::lookupIdObject;
         } else {
+            l->qmlContextIdObjectLookup.objectId = propertyIdx;
+            l->qmlContextIdObjectLookup.componentObjectIndex = context->componentObjectIndex();
             l->qmlContextPropertyGetter = QV4::QQmlContextWrapper::lookupIdObjectInParentContext;
         }
 
@@ -1860,7 +1927,7 @@ bool AOTCompiledContext::callGlobalLookup(
     }
 
     function->call(nullptr, args, types, argc);
-    return true;
+    return !scope.hasException();
 }
 
 void AOTCompiledContext::initCallGlobalLookup(uint index) const
@@ -1870,6 +1937,40 @@ void AOTCompiledContext::initCallGlobalLookup(uint index) const
     amendException(engine->handle());
 }
 
+bool AOTCompiledContext::callJSValueLookup(
+        uint index, const QJSValue &thisObject,
+        void **args, const QMetaType *types, int argc) const
+{
+    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Scope scope(engine->handle());
+    QV4::ScopedValue jsThisObject(
+                scope, QJSValuePrivate::convertToReturnedValue(scope.engine, thisObject));
+    QV4::ScopedFunctionObject function(scope, l->getter(l, scope.engine, jsThisObject));
+    if (!function) {
+        if (!scope.hasException()) {
+            scope.engine->throwTypeError(
+                        QStringLiteral("Property '%1' of %2 is not a function")
+                        .arg(compilationUnit->runtimeStrings[l->nameIndex]->toQString(),
+                             jsThisObject->toQStringNoThrow()));
+        }
+        return false;
+    }
+
+    // Unlike the QObject variants, the JavaScript "this" object has to be passed on as-is.
+    QV4::convertAndCall(scope.engine, nullptr, args, types, argc,
+                        [&](const QV4::Value *, const QV4::Value *argv, int jsArgc) {
+        return function->call(jsThisObject, argv, jsArgc);
+    });
+    return !scope.hasException();
+}
+
+void AOTCompiledContext::initCallJSValueLookup(uint index) const
+{
+    Q_UNUSED(index);
+    Q_ASSERT(engine->hasError());
+    amendException(engine->handle());
+}
+
 bool AOTCompiledContext::loadGlobalLookup(uint index, void *target, QMetaType type) const
 {
     QV4::Lookup *l = compilationUnit->runtimeLookups + index;
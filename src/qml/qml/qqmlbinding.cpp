@@ -25,8 +25,11 @@
 
 #include <QVariant>
 #include <QtCore/qdebug.h>
+#include <QtCore/qvarlengtharray.h>
 #include <QVector>
 
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 Q_TRACE_POINT(qtqml, QQmlBinding_entry, const QQmlEngine *engine, const QString &function, const QString &fileName, int line, int column)
@@ -51,7 +54,7 @@ QQmlBinding *QQmlBinding::create(const QQmlPropertyData *property, const QQmlScr
     if (engine && ctxtdata && !ctxtdata->urlString().isEmpty() && ctxtdata->typeCompilationUnit()) {
         url = ctxtdata->urlString();
         if (scriptPrivate->bindingId != QQmlBinding::Invalid)
-            runtimeFunction = ctxtdata->typeCompilationUnit()->runtimeFunctions.at(scriptPrivate->bindingId);
+            runtimeFunction = ctxtdata->typeCompilationUnit()->runtimeFunction(scriptPrivate->bindingId);
     }
 
     b->setNotifyOnValueChanged(true);
@@ -140,12 +143,7 @@ void QQmlBinding::update(QQmlPropertyData::WriteFlags flags)
 
     // Check for a binding update loop
     if (Q_UNLIKELY(updatingFlag())) {
-        const QQmlPropertyData *d = nullptr;
-        QQmlPropertyData vtd;
-        getPropertyData(&d, &vtd);
-        Q_ASSERT(d);
-        QQmlProperty p = QQmlPropertyPrivate::restore(targetObject(), *d, &vtd, nullptr);
-        QQmlAbstractBinding::printBindingLoopError(p);
+        printBindingLoopError();
         return;
     }
     setUpdatingFlag(true);
@@ -167,6 +165,16 @@ void QQmlBinding::update(QQmlPropertyData::WriteFlags flags)
         setUpdatingFlag(false);
 }
 
+void QQmlBinding::printBindingLoopError() const
+{
+    const QQmlPropertyData *d = nullptr;
+    QQmlPropertyData vtd;
+    getPropertyData(&d, &vtd);
+    Q_ASSERT(d);
+    QQmlProperty p = QQmlPropertyPrivate::restore(targetObject(), *d, &vtd, nullptr);
+    QQmlAbstractBinding::printBindingLoopError(p);
+}
+
 QV4::ReturnedValue QQmlBinding::evaluate(bool *isUndefined)
 {
     QV4::ExecutionEngine *v4 = engine()->handle();
@@ -602,9 +610,140 @@ QVariant QQmlBinding::evaluate()
 
 void QQmlBinding::expressionChanged()
 {
+    // In batched mode we only record that the binding is dirty. Bindings created as part
+    // of a component are still updated immediately, so that the objects are consistent
+    // once creation returns.
+    if (QQmlEngine *qmlEngine = engine()) {
+        QQmlEnginePrivate *ep = QQmlEnginePrivate::get(qmlEngine);
+        if (ep->batchedBindingUpdates && ep->inProgressCreations == 0) {
+            if (!hasPendingUpdate()) {
+                m_error.setTag(PendingBatchedUpdate);
+                ep->scheduleBindingUpdate(this);
+            }
+            return;
+        }
+    }
+
     update();
 }
 
+/*!
+    \internal
+
+    Updates all \a bindings, each at most once. A binding is updated only after all the
+    bindings in \a bindings that write a property it has captured as a dependency. This
+    way, a change that fans out to many bindings does not cause intermediate evaluations
+    with partially updated inputs. Dependency cycles are broken arbitrarily.
+
+    Each entry in \a bindings carries a reference, which is dropped here.
+*/
+void QQmlBinding::updateInDependencyOrder(QList<QQmlBinding *> bindings)
+{
+    using Key = std::pair<QObject *, int>;
+
+    // Map the properties written by the queued bindings back to the bindings, keyed by
+    // notify signal for guards and by property index for QProperty based triggers.
+    QMultiHash<Key, qsizetype> writersBySignal;
+    QMultiHash<Key, qsizetype> writersByProperty;
+    for (qsizetype i = 0, end = bindings.size(); i < end; ++i) {
+        QQmlBinding *binding = bindings.at(i);
+        QObject *target = binding->targetObject();
+        if (!target || !binding->isAddedToObject())
+            continue;
+
+        const QQmlPropertyData *pd = nullptr;
+        QQmlPropertyData vpd;
+        binding->getPropertyData(&pd, &vpd);
+        if (!pd)
+            continue;
+
+        if (pd->notifyIndex() != -1)
+            writersBySignal.insert({ target, pd->notifyIndex() }, i);
+        writersByProperty.insert({ target, pd->coreIndex() }, i);
+    }
+
+    const auto dependenciesOf = [&](qsizetype i) {
+        QVarLengthArray<qsizetype, 8> result;
+        const auto collect = [&](const QMultiHash<Key, qsizetype> &writers, const Key &key) {
+            for (auto it = writers.constFind(key), end = writers.cend();
+                 it != end && it.key() == key; ++it) {
+                if (*it != i)
+                    result.append(*it);
+            }
+        };
+
+        const QQmlBinding *binding = bindings.at(i);
+        for (QQmlJavaScriptExpressionGuard *guard = binding->activeGuards.first(); guard;
+             guard = binding->activeGuards.next(guard)) {
+            if (guard->signalIndex() == -1) // guard's sender is a QQmlNotifier, not a QObject*.
+                continue;
+            if (QObject *sender = guard->senderAsObject())
+                collect(writersBySignal, { sender, guard->signalIndex() });
+        }
+
+        for (auto trigger = binding->qpropertyChangeTriggers; trigger; trigger = trigger->next) {
+            if (QObject *target = trigger->target.data())
+                collect(writersByProperty, { target, trigger->propertyIndex });
+        }
+
+        return result;
+    };
+
+    // Iterative depth-first search, so that long dependency chains don't exhaust the stack.
+    enum VisitState : quint8 { Unvisited, Visiting, Visited };
+    QVarLengthArray<VisitState, 64> states(bindings.size());
+    std::fill(states.begin(), states.end(), Unvisited);
+
+    struct Frame
+    {
+        qsizetype index;
+        QVarLengthArray<qsizetype, 8> dependencies;
+        qsizetype next = 0;
+    };
+    std::vector<Frame> stack;
+
+    QVarLengthArray<qsizetype, 64> order;
+    order.reserve(bindings.size());
+
+    for (qsizetype root = 0, end = bindings.size(); root < end; ++root) {
+        if (states[root] != Unvisited)
+            continue;
+
+        states[root] = Visiting;
+        stack.push_back({ root, dependenciesOf(root) });
+        while (!stack.empty()) {
+            Frame &frame = stack.back();
+            if (frame.next < frame.dependencies.size()) {
+                const qsizetype dependency = frame.dependencies[frame.next++];
+                if (states[dependency] == Unvisited) {
+                    states[dependency] = Visiting;
+                    stack.push_back({ dependency, dependenciesOf(dependency) });
+                }
+                continue;
+            }
+
+            states[frame.index] = Visited;
+            order.append(frame.index);
+            stack.pop_back();
+        }
+    }
+
+    for (qsizetype i : std::as_const(order)) {
+        QQmlBinding *binding = bindings.at(i);
+
+        // Clear the flag only now, so that the binding is not queued again if one of the
+        // bindings before it in the order invalidates it once more.
+        binding->clearPendingUpdate();
+        if (binding->isAddedToObject())
+            binding->update();
+    }
+
+    for (QQmlBinding *binding : std::as_const(bindings)) {
+        if (!binding->ref.deref())
+            delete binding;
+    }
+}
+
 void QQmlBinding::refresh()
 {
     update();
@@ -86,6 +86,12 @@ public:
 
     void expressionChanged() override;
 
+    // Used by QQmlEnginePrivate in batched binding update mode
+    static void updateInDependencyOrder(QList<QQmlBinding *> bindings);
+    bool hasPendingUpdate() const { return m_error.tag() == PendingBatchedUpdate; }
+    void clearPendingUpdate() { m_error.setTag(NoTag); }
+    void printBindingLoopError() const;
+
     QQmlSourceLocation sourceLocation() const override;
     void setSourceLocation(const QQmlSourceLocation &location);
     void setBoundFunction(QV4::BoundFunction *boundFunction) {
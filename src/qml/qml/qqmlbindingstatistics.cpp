@@ -0,0 +1,72 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qqmlbindingstatistics_p.h"
+
+#include <private/qv4function_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    \class QQmlBindingStatistics
+
+    Collects how often the bindings at a given source location are evaluated, how long that
+    takes, and how many dependencies they capture. Evaluations are keyed by their QV4::Function,
+    so all instances of a binding in different component instances are accumulated in one entry.
+
+    The dependency churn counts how many notifier connections had to be added or removed after
+    an evaluation. A binding that keeps changing its dependencies, for example because it
+    branches on some condition, shows up with a high churn relative to its evaluations.
+*/
+
+/*!
+    \internal
+    Records an evaluation of \a function that took \a time nanoseconds and left the
+    expression with \a dependencies captured dependencies. \a churn is the number of
+    dependencies that were added or dropped compared to the previous evaluation of the
+    same expression. The initial capture of an expression does not count as churn.
+*/
+void QQmlBindingStatistics::record(QV4::Function *function, qint64 time, int dependencies, int churn)
+{
+    if (!function)
+        return;
+
+    Record &record = m_records[function];
+    if (!record.unit) {
+        record.unit.reset(function->executableCompilationUnit());
+        record.entry.location = function->sourceLocation();
+    }
+
+    Entry &entry = record.entry;
+    ++entry.evaluations;
+    entry.totalTime += time;
+    entry.capturedDependencies += dependencies;
+    if (churn > 0) {
+        entry.dependencyChurn += churn;
+        ++entry.recaptures;
+    }
+}
+
+QList<QQmlBindingStatistics::Entry> QQmlBindingStatistics::entries() const
+{
+    QList<Entry> result;
+    result.reserve(m_records.size());
+    for (const Record &record : m_records)
+        result.append(record.entry);
+    return result;
+}
+
+/*!
+    \internal
+    Returns the statistics recorded since the last call to takeEntries() or clear()
+    and clears them.
+*/
+QList<QQmlBindingStatistics::Entry> QQmlBindingStatistics::takeEntries()
+{
+    QList<Entry> result = entries();
+    clear();
+    return result;
+}
+
+QT_END_NAMESPACE
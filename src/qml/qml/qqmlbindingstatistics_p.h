@@ -0,0 +1,77 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QQMLBINDINGSTATISTICS_P_H
+#define QQMLBINDINGSTATISTICS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qqmlglobal_p.h>
+#include <private/qqmlrefcount_p.h>
+#include <private/qv4executablecompilationunit_p.h>
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QV4 {
+struct Function;
+}
+
+// Aggregates evaluation statistics of bindings and other JavaScript expressions per source
+// location. An instance only exists while statistics are enabled on the engine, see
+// QQmlEnginePrivate::setBindingStatisticsEnabled(). Otherwise nothing is recorded.
+class Q_QML_EXPORT QQmlBindingStatistics
+{
+    Q_DISABLE_COPY_MOVE(QQmlBindingStatistics)
+public:
+    struct Entry
+    {
+        QQmlSourceLocation location;
+        quint64 evaluations = 0;
+        qint64 totalTime = 0;             // in nanoseconds
+        quint64 capturedDependencies = 0; // summed over all evaluations
+        quint64 dependencyChurn = 0;      // dependencies added or dropped, summed likewise
+        quint64 recaptures = 0;           // evaluations that changed the set of dependencies
+    };
+
+    QQmlBindingStatistics() { m_timer.start(); }
+
+    qint64 timestamp() const { return m_timer.nsecsElapsed(); }
+
+    void record(QV4::Function *function, qint64 time, int dependencies, int churn);
+
+    QList<Entry> entries() const;
+    QList<Entry> takeEntries();
+    void clear() { m_records.clear(); }
+
+private:
+    struct Record
+    {
+        // Keeps the function, and therefore the key, alive.
+        QQmlRefPointer<QV4::ExecutableCompilationUnit> unit;
+        Entry entry;
+    };
+
+    QElapsedTimer m_timer;
+    QHash<const QV4::Function *, Record> m_records;
+};
+
+Q_DECLARE_TYPEINFO(QQmlBindingStatistics::Entry, Q_RELOCATABLE_TYPE);
+
+QT_END_NAMESPACE
+
+Q_DECLARE_METATYPE(QList<QQmlBindingStatistics::Entry>)
+
+#endif // QQMLBINDINGSTATISTICS_P_H
@@ -307,7 +307,10 @@ void QQmlContextData::initFromTypeCompilationUnit(const QQmlRefPointer<QV4::Exec
     Q_ASSERT(!m_idValues);
     m_idValueCount = m_typeCompilationUnit->objectAt(m_componentObjectIndex)
             ->nNamedObjectsInComponent;
-    m_idValues = new ContextGuard[m_idValueCount];
+
+    // Many components, especially delegates, don't declare any ids. Don't allocate for them.
+    if (m_idValueCount > 0)
+        m_idValues = new ContextGuard[m_idValueCount];
 }
 
 void QQmlContextData::addComponentAttached(QQmlComponentAttached *attached)
@@ -60,6 +60,15 @@ public:
     void initFromTypeCompilationUnit(const QQmlRefPointer<QV4::ExecutableCompilationUnit> &unit,
                                      int subComponentIndex);
 
+    // Whether this is the context of an instance of the given (sub)component.
+    bool isComponentContext(const QV4::ExecutableCompilationUnit *unit,
+                            int componentObjectIndex) const
+    {
+        return m_componentObjectIndex == componentObjectIndex
+                && m_typeCompilationUnit.data() == unit;
+    }
+    int componentObjectIndex() const { return m_componentObjectIndex; }
+
     static QQmlRefPointer<QQmlContextData> get(QQmlContext *context) {
         return QQmlContextPrivate::get(context)->m_data;
     }
@@ -14,6 +14,8 @@
 #include "qqmlabstracturlinterceptor.h"
 
 #include <private/qqmldirparser_p.h>
+#include <private/qqmlbinding_p.h>
+#include <private/qqmlbindingstatistics_p.h>
 #include <private/qqmlboundsignal_p.h>
 #include <private/qqmljsdiagnosticmessage_p.h>
 #include <private/qqmltype_p_p.h>
@@ -211,6 +213,7 @@ QQmlEnginePrivate::~QQmlEnginePrivate()
     delete profiler;
 #endif
     qDeleteAll(cachedValueTypeInstances);
+    delete bindingStatistics;
 }
 
 void QQmlPrivate::qdeclarativeelement_destructor(QObject *o)
@@ -491,9 +494,116 @@ void QQmlEnginePrivate::init()
 
     q->handle()->setQmlEngine(q);
 
+    static const bool batchedBindings = qEnvironmentVariableIsSet("QML_BATCHED_BINDING_UPDATES");
+    batchedBindingUpdates = batchedBindings;
+
     rootContext = new QQmlContext(q,true);
 }
 
+namespace {
+// Engines living in the current thread that have queued binding updates.
+Q_CONSTINIT thread_local QList<QQmlEnginePrivate *> enginesWithDirtyBindings;
+}
+
+/*!
+  \internal
+
+  Queues \a binding for re-evaluation in batched binding update mode. The binding
+  is evaluated the next time flushDirtyBindings() runs. This happens either from a
+  queued invocation on the engine's thread, or before polishing a QQuickWindow,
+  whichever comes first.
+ */
+void QQmlEnginePrivate::scheduleBindingUpdate(QQmlBinding *binding)
+{
+    binding->ref.ref();
+    dirtyBindings.append(binding);
+
+    if (bindingFlushScheduled)
+        return;
+
+    bindingFlushScheduled = true;
+    enginesWithDirtyBindings.append(this);
+    QMetaObject::invokeMethod(q_func(), [this]() { flushDirtyBindings(); }, Qt::QueuedConnection);
+}
+
+/*!
+  \internal
+
+  Evaluates all bindings queued by scheduleBindingUpdate(). Each binding is evaluated
+  at most once per round, after any other queued binding it depends on. Bindings that
+  become dirty again while flushing are evaluated in a subsequent round.
+ */
+void QQmlEnginePrivate::flushDirtyBindings()
+{
+    if (!bindingFlushScheduled)
+        return;
+
+    bindingFlushScheduled = false;
+    enginesWithDirtyBindings.removeOne(this);
+
+    // Bindings that keep invalidating each other never settle. Treat them as a binding
+    // loop once they have been re-queued an unreasonable number of times.
+    constexpr int MaxRounds = 64;
+    for (int round = 0; !dirtyBindings.isEmpty(); ++round) {
+        if (round == MaxRounds) {
+            for (const QQmlBinding *binding : std::as_const(dirtyBindings)) {
+                if (binding->targetObject())
+                    binding->printBindingLoopError();
+            }
+            clearDirtyBindings();
+            return;
+        }
+        QQmlBinding::updateInDependencyOrder(std::exchange(dirtyBindings, {}));
+    }
+}
+
+void QQmlEnginePrivate::clearDirtyBindings()
+{
+    if (bindingFlushScheduled) {
+        bindingFlushScheduled = false;
+        enginesWithDirtyBindings.removeOne(this);
+    }
+
+    for (QQmlBinding *binding : std::exchange(dirtyBindings, {})) {
+        binding->clearPendingUpdate();
+        if (!binding->ref.deref())
+            delete binding;
+    }
+}
+
+/*!
+  \internal
+
+  Starts or stops collecting per-location evaluation statistics for bindings and other
+  JavaScript expressions evaluated by this engine. Disabling the statistics discards
+  everything collected so far.
+ */
+void QQmlEnginePrivate::setBindingStatisticsEnabled(bool enabled)
+{
+    if (enabled == (bindingStatistics != nullptr))
+        return;
+
+    if (enabled) {
+        bindingStatistics = new QQmlBindingStatistics;
+    } else {
+        delete bindingStatistics;
+        bindingStatistics = nullptr;
+    }
+}
+
+/*!
+  \internal
+
+  Flushes the queued binding updates of all engines in the current thread. This is
+  called right before items are polished, so that the scene reflects a consistent
+  state of all bindings.
+ */
+void QQmlEnginePrivate::flushAllDirtyBindings()
+{
+    while (!enginesWithDirtyBindings.isEmpty())
+        enginesWithDirtyBindings.first()->flushDirtyBindings();
+}
+
 /*!
   \class QQmlEngine
   \since 5.0
@@ -553,6 +663,10 @@ QQmlEngine::~QQmlEngine()
     // may be required to handle the destruction signal.
     QQmlContextPrivate::get(rootContext())->emitDestruction();
 
+    // Drop any binding updates that haven't been flushed, yet. They would evaluate
+    // against contexts that are about to be destroyed.
+    d->clearDirtyBindings();
+
     // clean up all singleton type instances which we own.
     // we do this here and not in the private dtor since otherwise a crash can
     // occur (if we are the QObject parent of the QObject singleton instance)
@@ -1920,7 +2034,7 @@ void QQmlEnginePrivate::executeRuntimeFunction(const QV4::ExecutableCompilationU
     QQmlData *ddata = QQmlData::get(thisObject);
     Q_ASSERT(ddata && ddata->outerContext);
 
-    QV4::Function *function = unit->runtimeFunctions[functionIndex];
+    QV4::Function *function = unit->runtimeFunction(functionIndex);
     Q_ASSERT(function);
     Q_ASSERT(function->compiledFunction);
 
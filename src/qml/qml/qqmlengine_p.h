@@ -50,6 +50,8 @@
 QT_BEGIN_NAMESPACE
 
 class QNetworkAccessManager;
+class QQmlBinding;
+class QQmlBindingStatistics;
 class QQmlDelayedError;
 class QQmlIncubator;
 class QQmlMetaObject;
@@ -129,6 +131,21 @@ public:
     QQmlDelayedError *erroredBindings = nullptr;
     int inProgressCreations = 0;
 
+    // Batched binding updates: If enabled, bindings whose dependencies change are not
+    // re-evaluated right away. They are queued in dirtyBindings (each entry holding a
+    // reference) and evaluated once, in dependency order, by flushDirtyBindings().
+    bool batchedBindingUpdates = false;
+    bool bindingFlushScheduled = false;
+    QList<QQmlBinding *> dirtyBindings;
+    void scheduleBindingUpdate(QQmlBinding *binding);
+    void flushDirtyBindings();
+    void clearDirtyBindings();
+    static void flushAllDirtyBindings();
+
+    // Only set while binding statistics are enabled, see QQmlBindingStatistics.
+    QQmlBindingStatistics *bindingStatistics = nullptr;
+    void setBindingStatisticsEnabled(bool enabled);
+
     QV4::ExecutionEngine *v4engine() const { return q_func()->handle(); }
 
 #if QT_CONFIG(qml_worker_script)
@@ -133,7 +133,7 @@ QQmlExpression::QQmlExpression(const QQmlScriptString &script, QQmlContext *ctxt
             d->column = scriptPrivate->columnNumber;
 
             if (scriptPrivate->bindingId != QQmlBinding::Invalid)
-                runtimeFunction = ctxtdata->typeCompilationUnit()->runtimeFunctions.at(scriptPrivate->bindingId);
+                runtimeFunction = ctxtdata->typeCompilationUnit()->runtimeFunction(scriptPrivate->bindingId);
         }
     }
 
@@ -106,6 +106,7 @@ void QQmlIncubatorPrivate::clear()
     // reset the tagged pointer
     if (requiredPropertiesFromComponent)
         requiredPropertiesFromComponent = decltype(requiredPropertiesFromComponent){};
+    ownedRequiredProperties.reset();
     compilationUnit.reset();
     if (next.isInList()) {
         next.remove();
@@ -62,6 +62,9 @@ public:
        would need to store a copy of the required properties instead
     */
     QTaggedPointer<RequiredProperties, HadTopLevelRequired> requiredPropertiesFromComponent;
+    // Storage for requiredPropertiesFromComponent when there is no component state to point
+    // to, as for types compiled with qmltc. Kept until the incubator is cleared.
+    QScopedPointer<RequiredProperties> ownedRequiredProperties;
     QQmlGuardedContextData rootContext;
     QQmlEnginePrivate *enginePriv;
     QQmlRefPointer<QV4::ExecutableCompilationUnit> compilationUnit;
@@ -81,6 +84,7 @@ public:
     void forceCompletion(QQmlInstantiationInterrupt &i);
     void incubate(QQmlInstantiationInterrupt &i);
     void incubateCppBasedComponent(QQmlComponent *component, QQmlContext *context);
+    void setInitialState(QObject *object) { if (q) q->setInitialState(object); }
     RequiredProperties *requiredProperties();
     bool hadTopLevelRequiredProperties() const;
 };
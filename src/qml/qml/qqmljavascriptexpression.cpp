@@ -17,6 +17,7 @@
 #include <private/qqmlbuiltinfunctions_p.h>
 #include <private/qqmlsourcecoordinate_p.h>
 #include <private/qqmlabstractbinding_p.h>
+#include <private/qqmlbindingstatistics_p.h>
 #include <private/qqmlpropertybinding_p.h>
 #include <private/qproperty_p.h>
 
@@ -171,6 +172,13 @@ public:
 
         if (expression->notifyOnValueChanged())
             capture.guards.copyAndClearPrepend(expression->activeGuards);
+
+        if (Q_UNLIKELY(ep->bindingStatistics)) {
+            statistics = ep->bindingStatistics;
+            previousGuards = countGuards(capture.guards);
+            previousTriggers = countTriggers(expression->qpropertyChangeTriggers);
+            startTime = statistics->timestamp();
+        }
     }
 
     ~QQmlJavaScriptExpressionCapture()
@@ -182,6 +190,10 @@ public:
             capture.errorString = nullptr;
         }
 
+        // Statistics may have been disabled by the expression itself.
+        if (Q_UNLIKELY(statistics) && statistics == ep->bindingStatistics && !watcher.wasDeleted())
+            recordStatistics();
+
         while (QQmlJavaScriptExpressionGuard *g = capture.guards.takeFirst())
             g->Delete();
 
@@ -204,10 +216,51 @@ public:
     }
 
 private:
+    template<typename List>
+    static int countGuards(const List &guards)
+    {
+        int count = 0;
+        for (QQmlJavaScriptExpressionGuard *g = guards.first(); g; g = guards.next(g))
+            ++count;
+        return count;
+    }
+
+    static int countTriggers(const TriggerList *triggers)
+    {
+        int count = 0;
+        for (; triggers; triggers = triggers->next)
+            ++count;
+        return count;
+    }
+
+    void recordStatistics()
+    {
+        QQmlJavaScriptExpression *expression = capture.expression;
+
+        // Guards left over in the capture were not hit again and are about to be dropped.
+        // Triggers are never dropped while the expression is alive.
+        const int droppedGuards = countGuards(capture.guards);
+        const int currentGuards = countGuards(expression->activeGuards);
+        const int addedGuards = currentGuards - (previousGuards - droppedGuards);
+        const int currentTriggers = countTriggers(expression->qpropertyChangeTriggers);
+        const int addedTriggers = qMax(0, currentTriggers - previousTriggers);
+
+        // The initial capture of an expression is not churn.
+        const bool hadDependencies = previousGuards > 0 || previousTriggers > 0;
+        statistics->record(expression->function(), statistics->timestamp() - startTime,
+                           currentGuards + currentTriggers,
+                           hadDependencies ? addedGuards + droppedGuards + addedTriggers : 0);
+    }
+
     QQmlJavaScriptExpression::DeleteWatcher watcher;
     QQmlPropertyCapture capture;
     QQmlEnginePrivate *ep;
     QQmlPropertyCapture *lastPropertyCapture;
+
+    QQmlBindingStatistics *statistics = nullptr;
+    qint64 startTime = 0;
+    int previousGuards = 0;
+    int previousTriggers = 0;
 };
 
 QV4::ReturnedValue QQmlJavaScriptExpression::evaluate(QV4::CallData *callData, bool *isUndefined)
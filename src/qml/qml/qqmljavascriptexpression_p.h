@@ -157,7 +157,8 @@ protected:
 
     enum Tag {
         NoTag,
-        InEvaluationLoop
+        InEvaluationLoop,
+        PendingBatchedUpdate
     };
 
     QTaggedPointer<QQmlDelayedError, Tag> m_error;
@@ -928,7 +928,7 @@ bool QQmlObjectCreator::setPropertyBinding(const QQmlPropertyData *bindingProper
     if (bindingType == QV4::CompiledData::Binding::Type_Script || binding->isTranslationBinding()) {
         if (bindingFlags & QV4::CompiledData::Binding::IsSignalHandlerExpression
             || bindingFlags & QV4::CompiledData::Binding::IsPropertyObserver) {
-            QV4::Function *runtimeFunction = compilationUnit->runtimeFunctions[binding->value.compiledScriptIndex];
+            QV4::Function *runtimeFunction = compilationUnit->runtimeFunction(binding->value.compiledScriptIndex);
             int signalIndex = _propertyCache->methodIndexToSignalIndex(bindingProperty->coreIndex());
             QQmlBoundSignalExpression *expr = new QQmlBoundSignalExpression(
                         _bindingTarget, signalIndex, context,
@@ -963,7 +963,7 @@ bool QQmlObjectCreator::setPropertyBinding(const QQmlPropertyData *bindingProper
             if (binding->isTranslationBinding()) {
                 qmlBinding = QQmlTranslationPropertyBinding::create(bindingProperty, compilationUnit, binding);
             } else {
-                QV4::Function *runtimeFunction = compilationUnit->runtimeFunctions[binding->value.compiledScriptIndex];
+                QV4::Function *runtimeFunction = compilationUnit->runtimeFunction(binding->value.compiledScriptIndex);
                 QQmlPropertyIndex index(bindingProperty->coreIndex(), -1);
                 qmlBinding = QQmlPropertyBinding::create(bindingProperty, runtimeFunction, _scopeObject, context, currentQmlContext(), _bindingTarget, index);
             }
@@ -988,7 +988,7 @@ bool QQmlObjectCreator::setPropertyBinding(const QQmlPropertyData *bindingProper
                 qmlBinding = QQmlBinding::createTranslationBinding(
                             compilationUnit, binding, _scopeObject, context);
             } else {
-                QV4::Function *runtimeFunction = compilationUnit->runtimeFunctions[binding->value.compiledScriptIndex];
+                QV4::Function *runtimeFunction = compilationUnit->runtimeFunction(binding->value.compiledScriptIndex);
                 qmlBinding = QQmlBinding::create(targetProperty, runtimeFunction, _scopeObject,
                                                  context, currentQmlContext());
             }
@@ -1192,7 +1192,7 @@ void QQmlObjectCreator::setupFunctions()
 
     const quint32_le *functionIdx = _compiledObject->functionOffsetTable();
     for (quint32 i = 0; i < _compiledObject->nFunctions; ++i, ++functionIdx) {
-        QV4::Function *runtimeFunction = compilationUnit->runtimeFunctions[*functionIdx];
+        QV4::Function *runtimeFunction = compilationUnit->runtimeFunction(*functionIdx);
         const QString name = runtimeFunction->name()->toQString();
 
         const QQmlPropertyData *property = _propertyCache->property(name, _qobject, context);
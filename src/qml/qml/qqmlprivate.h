@@ -639,6 +639,13 @@ namespace QQmlPrivate
         QMetaType lookupResultMetaType(uint index) const;
         void storeNameSloppy(uint nameIndex, void *value, QMetaType type) const;
         QJSValue javaScriptGlobalProperty(uint nameIndex) const;
+        QJSValue createClosure(uint functionIndex) const;
+        void callJSValue(const QJSValue &function,
+                         void **args, const QMetaType *types, int argc) const;
+        QJSValue objectLiteral(uint internalClassId,
+                               void **args, const QMetaType *types, int argc) const;
+        void setJSValueProperty(uint lookupIndex, const QJSValue &object,
+                                const QJSValue &value) const;
 
         const QLoggingCategory *resolveLoggingCategory(QObject *wrapper, bool *ok) const;
 
@@ -697,6 +704,10 @@ namespace QQmlPrivate
         bool callGlobalLookup(uint index, void **args, const QMetaType *types, int argc) const;
         void initCallGlobalLookup(uint index) const;
 
+        bool callJSValueLookup(uint index, const QJSValue &thisObject,
+                               void **args, const QMetaType *types, int argc) const;
+        void initCallJSValueLookup(uint index) const;
+
         bool loadGlobalLookup(uint index, void *target, QMetaType type) const;
         void initLoadGlobalLookup(uint index) const;
 
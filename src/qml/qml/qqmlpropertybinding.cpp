@@ -81,7 +81,7 @@ QUntypedPropertyBinding QQmlPropertyBinding::createFromScriptString(const QQmlPr
     if (engine && ctxtdata && !ctxtdata->urlString().isEmpty() && ctxtdata->typeCompilationUnit()) {
         url = ctxtdata->urlString();
         if (scriptPrivate->bindingId != QQmlBinding::Invalid)
-            runtimeFunction = ctxtdata->typeCompilationUnit()->runtimeFunctions.at(scriptPrivate->bindingId);
+            runtimeFunction = ctxtdata->typeCompilationUnit()->runtimeFunction(scriptPrivate->bindingId);
     }
     // Do we actually have a function in the script string? If not, this becomes createCodeFromString
     if (!runtimeFunction)
@@ -16,24 +16,37 @@
 
 QT_BEGIN_NAMESPACE
 
-template<typename CreateBinding>
-inline decltype(auto) createBindingInScope(QObject *thisObject, CreateBinding create)
+static QV4::ExecutionEngine *v4Engine(QObject *thisObject)
 {
     QQmlEngine *qmlengine = qmlEngine(thisObject);
     Q_ASSERT(qmlengine);
     QV4::ExecutionEngine *v4 = qmlengine->handle();
     Q_ASSERT(v4);
+    return v4;
+}
 
+static QQmlContextData *outerContext(QObject *thisObject)
+{
     QQmlData *ddata = QQmlData::get(thisObject);
     Q_ASSERT(ddata && ddata->outerContext);
-    QQmlRefPointer<QQmlContextData> ctxtdata = QQmlRefPointer<QQmlContextData>(ddata->outerContext);
+    return ddata->outerContext;
+}
 
-    QV4::Scope scope(v4);
-    QV4::ExecutionContext *executionCtx = v4->scriptContext();
-    QV4::Scoped<QV4::QmlContext> qmlContext(
-            scope, QV4::QmlContext::create(executionCtx, ctxtdata, thisObject));
+QQmlCppBindingScope::QQmlCppBindingScope(const QV4::ExecutableCompilationUnit *unit,
+                                         QObject *thisObject)
+    : unit(unit),
+      thisObject(thisObject),
+      context(outerContext(thisObject)),
+      scope(v4Engine(thisObject)),
+      qmlContext(scope, QV4::QmlContext::create(scope.engine->scriptContext(), context, thisObject))
+{
+}
 
-    return create(ctxtdata, qmlContext);
+QV4::Function *QQmlCppBindingScope::function(qsizetype functionIndex) const
+{
+    return (functionIndex >= 0 && functionIndex < unit->runtimeFunctions.size())
+            ? unit->runtimeFunction(functionIndex)
+            : nullptr;
 }
 
 QUntypedPropertyBinding
@@ -41,10 +54,20 @@ QQmlCppBinding::createBindingForBindable(const QV4::ExecutableCompilationUnit *u
                                          QObject *thisObject, qsizetype functionIndex,
                                          QObject *bindingTarget, int metaPropertyIndex,
                                          int valueTypePropertyIndex, const QString &propertyName)
+{
+    QQmlCppBindingScope scope(unit, thisObject);
+    return createBindingForBindable(scope, functionIndex, bindingTarget, metaPropertyIndex,
+                                    valueTypePropertyIndex, propertyName);
+}
+
+QUntypedPropertyBinding
+QQmlCppBinding::createBindingForBindable(QQmlCppBindingScope &scope, qsizetype functionIndex,
+                                         QObject *bindingTarget, int metaPropertyIndex,
+                                         int valueTypePropertyIndex, const QString &propertyName)
 {
     Q_UNUSED(propertyName);
 
-    QV4::Function *v4Function = unit->runtimeFunctions.value(functionIndex, nullptr);
+    QV4::Function *v4Function = scope.function(functionIndex);
     if (!v4Function) {
         // TODO: align with existing logging of such
         qCritical() << "invalid JavaScript function index (internal error)";
@@ -61,13 +84,9 @@ QQmlCppBinding::createBindingForBindable(const QV4::ExecutableCompilationUnit *u
     QMetaProperty property = mo->property(metaPropertyIndex);
     Q_ASSERT(valueTypePropertyIndex == -1 || QString::fromUtf8(property.name()) == propertyName);
 
-    return createBindingInScope(
-            thisObject,
-            [&](const QQmlRefPointer<QQmlContextData> &ctxt, QV4::ExecutionContext *scope) {
-                auto index = QQmlPropertyIndex(property.propertyIndex(), valueTypePropertyIndex);
-                return QQmlPropertyBinding::create(property.metaType(), v4Function, thisObject,
-                                                   ctxt, scope, bindingTarget, index);
-            });
+    auto index = QQmlPropertyIndex(property.propertyIndex(), valueTypePropertyIndex);
+    return QQmlPropertyBinding::create(property.metaType(), v4Function, scope.thisObject,
+                                       scope.context, scope.qmlContext, bindingTarget, index);
 }
 
 void QQmlCppBinding::createBindingForNonBindable(const QV4::ExecutableCompilationUnit *unit,
@@ -75,10 +94,20 @@ void QQmlCppBinding::createBindingForNonBindable(const QV4::ExecutableCompilatio
                                                  QObject *bindingTarget, int metaPropertyIndex,
                                                  int valueTypePropertyIndex,
                                                  const QString &propertyName)
+{
+    QQmlCppBindingScope scope(unit, thisObject);
+    createBindingForNonBindable(scope, functionIndex, bindingTarget, metaPropertyIndex,
+                                valueTypePropertyIndex, propertyName);
+}
+
+void QQmlCppBinding::createBindingForNonBindable(QQmlCppBindingScope &scope,
+                                                 qsizetype functionIndex, QObject *bindingTarget,
+                                                 int metaPropertyIndex, int valueTypePropertyIndex,
+                                                 const QString &propertyName)
 {
     Q_UNUSED(propertyName);
 
-    QV4::Function *v4Function = unit->runtimeFunctions.value(functionIndex, nullptr);
+    QV4::Function *v4Function = scope.function(functionIndex);
     if (!v4Function) {
         // TODO: align with existing logging of such
         qCritical() << "invalid JavaScript function index (internal error)";
@@ -95,17 +124,12 @@ void QQmlCppBinding::createBindingForNonBindable(const QV4::ExecutableCompilatio
     QMetaProperty property = mo->property(metaPropertyIndex);
     Q_ASSERT(valueTypePropertyIndex != -1 || QString::fromUtf8(property.name()) == propertyName);
 
-    createBindingInScope(
-            thisObject,
-            [&](const QQmlRefPointer<QQmlContextData> &ctxt, QV4::ExecutionContext *scope) -> void {
-                QQmlBinding *binding = QQmlBinding::create(property.metaType(), v4Function,
-                                                           thisObject, ctxt, scope);
-                // almost as in qv4objectwrapper.cpp:535
-                Q_ASSERT(!property.isAlias()); // we convert aliases to (almost) real properties
-                binding->setTarget(bindingTarget, property.propertyIndex(), false,
-                                   valueTypePropertyIndex);
-                QQmlPropertyPrivate::setBinding(binding);
-            });
+    QQmlBinding *binding = QQmlBinding::create(property.metaType(), v4Function, scope.thisObject,
+                                               scope.context, scope.qmlContext);
+    // almost as in qv4objectwrapper.cpp:535
+    Q_ASSERT(!property.isAlias()); // we convert aliases to (almost) real properties
+    binding->setTarget(bindingTarget, property.propertyIndex(), false, valueTypePropertyIndex);
+    QQmlPropertyPrivate::setBinding(binding);
 }
 
 QUntypedPropertyBinding QQmlCppBinding::createTranslationBindingForBindable(
@@ -147,17 +171,13 @@ void QQmlCppBinding::createTranslationBindingForNonBindable(
     QMetaProperty property = mo->property(metaPropertyIndex);
     Q_ASSERT(QString::fromUtf8(property.name()) == propertyName);
 
-    createBindingInScope(
-            thisObject,
-            [&](const QQmlRefPointer<QQmlContextData> &ctxt, QV4::ExecutionContext *) -> void {
-                QQmlBinding *binding = QQmlBinding::createTranslationBinding(
-                        unit, ctxt, propertyName, translationData, location, thisObject);
-                // almost as in qv4objectwrapper.cpp:535
-                Q_ASSERT(!property.isAlias()); // we convert aliases to (almost) real properties
-                binding->setTarget(bindingTarget, property.propertyIndex(), false,
-                                   valueTypePropertyIndex);
-                QQmlPropertyPrivate::setBinding(binding);
-            });
+    QQmlBinding *binding = QQmlBinding::createTranslationBinding(
+            unit, QQmlRefPointer<QQmlContextData>(outerContext(thisObject)), propertyName,
+            translationData, location, thisObject);
+    // almost as in qv4objectwrapper.cpp:535
+    Q_ASSERT(!property.isAlias()); // we convert aliases to (almost) real properties
+    binding->setTarget(bindingTarget, property.propertyIndex(), false, valueTypePropertyIndex);
+    QQmlPropertyPrivate::setBinding(binding);
 }
 
 QT_END_NAMESPACE
@@ -32,6 +32,28 @@
 
 QT_BEGIN_NAMESPACE
 
+/*! \internal
+
+    The JavaScript scope shared by all script bindings of one object. Creating
+    the QML context for a binding function is the most expensive part of
+    creating a binding, so qmltc creates one QQmlCppBindingScope per object
+    (like QQmlObjectCreator does) and passes it to every binding it creates.
+    Must be created on the stack as it holds a QV4::Scope.
+*/
+struct Q_QML_EXPORT QQmlCppBindingScope
+{
+    QQmlCppBindingScope(const QV4::ExecutableCompilationUnit *unit, QObject *thisObject);
+    Q_DISABLE_COPY_MOVE(QQmlCppBindingScope)
+
+    QV4::Function *function(qsizetype functionIndex) const;
+
+    const QV4::ExecutableCompilationUnit *unit;
+    QObject *thisObject;
+    QQmlRefPointer<QQmlContextData> context;
+    QV4::Scope scope;
+    QV4::Scoped<QV4::QmlContext> qmlContext;
+};
+
 struct Q_QML_EXPORT QQmlCppBinding
 {
     // TODO: this might instead be put into the QQmlEngine or QQmlAnyBinding?
@@ -39,12 +61,20 @@ struct Q_QML_EXPORT QQmlCppBinding
     createBindingForBindable(const QV4::ExecutableCompilationUnit *unit, QObject *thisObject,
                              qsizetype functionIndex, QObject *bindingTarget, int metaPropertyIndex,
                              int valueTypePropertyIndex, const QString &propertyName);
+    static QUntypedPropertyBinding
+    createBindingForBindable(QQmlCppBindingScope &scope, qsizetype functionIndex,
+                             QObject *bindingTarget, int metaPropertyIndex,
+                             int valueTypePropertyIndex, const QString &propertyName);
 
     static void createBindingForNonBindable(const QV4::ExecutableCompilationUnit *unit,
                                             QObject *thisObject, qsizetype functionIndex,
                                             QObject *bindingTarget, int metaPropertyIndex,
                                             int valueTypePropertyIndex,
                                             const QString &propertyName);
+    static void createBindingForNonBindable(QQmlCppBindingScope &scope,
+                                            qsizetype functionIndex, QObject *bindingTarget,
+                                            int metaPropertyIndex, int valueTypePropertyIndex,
+                                            const QString &propertyName);
 
     static QUntypedPropertyBinding
     createTranslationBindingForBindable(const QQmlRefPointer<QV4::ExecutableCompilationUnit> &unit,
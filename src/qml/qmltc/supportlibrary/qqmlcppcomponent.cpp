@@ -0,0 +1,151 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qqmlcppcomponent_p.h"
+
+#include <private/qqmldata_p.h>
+#include <private/qqmlincubator_p.h>
+#include <private/qqmlpropertycache_p.h>
+#include <private/qv4executablecompilationunit_p.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+QQmlCppComponent::QQmlCppComponent(QQmlEngine *engine,
+                                   QV4::ExecutableCompilationUnit *compilationUnit, int index,
+                                   QObject *parent, CreateFunction createFunction)
+    : QQmlComponent(*(new QQmlCppComponentPrivate), parent)
+{
+    Q_D(QQmlCppComponent);
+    // same as QQmlComponent(engine, compilationUnit, index, parent)
+    d->engine = engine;
+    QObject::connect(engine, &QObject::destroyed, this, [d]() {
+        d->state.clear();
+        d->engine = nullptr;
+    });
+    d->compilationUnit.reset(compilationUnit);
+    d->start = index;
+    d->url = compilationUnit->finalUrl();
+    d->progress = 1.0;
+    d->createFunction = createFunction;
+}
+
+/*! \internal
+    Same as QQmlObjectCreator::createComponent(), but the returned component
+    creates incubated objects with \a createFunction.
+*/
+QQmlComponent *QQmlCppComponent::create(QQmlEngine *engine,
+                                        QV4::ExecutableCompilationUnit *compilationUnit,
+                                        int index, QObject *parent,
+                                        const QQmlRefPointer<QQmlContextData> &context,
+                                        CreateFunction createFunction)
+{
+    Q_ASSERT(createFunction);
+    QQmlComponent *component =
+            new QQmlCppComponent(engine, compilationUnit, index, parent, createFunction);
+    QQmlComponentPrivate::get(component)->creationContext = context;
+    QQmlData::get(component, /*create*/ true);
+    return component;
+}
+
+namespace {
+class IncubatorInitialState final : public QQmlCppComponent::InitialState
+{
+public:
+    IncubatorInitialState(QQmlIncubatorPrivate *incubator, QQmlComponent *component,
+                          QQmlEngine *engine)
+        : incubator(incubator), component(component), engine(engine)
+    {
+    }
+
+    void set(QObject *object) override
+    {
+        QQmlData *ddata = QQmlData::get(object);
+        Q_ASSERT(ddata);
+        // see QQmlComponent::beginCreate for explanation of indestructible
+        ddata->indestructible = true;
+        ddata->explicitIndestructibleSet = true;
+        ddata->rootObjectInCreation = false;
+
+        // The models look the required properties up through the incubator until the
+        // incubation is cleared, even if there are none. So the incubator owns them.
+        incubator->ownedRequiredProperties.reset(new RequiredProperties);
+        RequiredProperties *requiredProperties = incubator->ownedRequiredProperties.data();
+
+        // like for C++ types, all required properties of the object itself
+        // are pending
+        const QQmlPropertyCache::ConstPtr propertyCache = QQmlData::ensurePropertyCache(object);
+        for (int i = 0, count = propertyCache->propertyCount(); i < count; ++i) {
+            const QQmlPropertyData *propertyData = propertyCache->property(i);
+            if (!propertyData->isRequired())
+                continue;
+            RequiredPropertyInfo info;
+            info.propertyName = propertyData->name(object);
+            requiredProperties->insert({ object, propertyData }, info);
+        }
+
+        incubator->requiredPropertiesFromComponent = requiredProperties;
+        incubator->requiredPropertiesFromComponent.setTag(
+                requiredProperties->isEmpty() ? QQmlIncubatorPrivate::HadTopLevelRequired::No
+                                              : QQmlIncubatorPrivate::HadTopLevelRequired::Yes);
+
+        if (!incubator->initialProperties.isEmpty()) {
+            component->setInitialProperties(object, incubator->initialProperties);
+            for (auto it = incubator->initialProperties.cbegin(),
+                      end = incubator->initialProperties.cend();
+                 it != end; ++it) {
+                if (!requiredProperties->isEmpty() && !it.key().contains(u'.')) {
+                    QQmlComponentPrivate::removePropertyFromRequired(
+                            object, it.key(), requiredProperties, engine);
+                }
+            }
+        }
+
+        incubator->setInitialState(object);
+    }
+
+private:
+    QQmlIncubatorPrivate *incubator;
+    QQmlComponent *component;
+    QQmlEngine *engine;
+};
+} // namespace
+
+/*! \internal
+    There is no incremental creation for compiled types, so, just like
+    QQmlIncubatorPrivate::incubateCppBasedComponent(), create the object right
+    away and report the result. The incubation is therefore always synchronous,
+    whatever the incubation mode.
+*/
+void QQmlCppComponentPrivate::incubateObject(QQmlIncubator *incubationTask,
+                                             QQmlComponent *component, QQmlEngine *engine,
+                                             const QQmlRefPointer<QQmlContextData> &context,
+                                             const QQmlRefPointer<QQmlContextData> &forContext)
+{
+    Q_UNUSED(forContext);
+    Q_ASSERT(createFunction);
+
+    QQmlIncubatorPrivate *incubatorPriv = QQmlIncubatorPrivate::get(incubationTask);
+    incubatorPriv->compilationUnit = compilationUnit;
+    incubatorPriv->enginePriv = QQmlEnginePrivate::get(engine);
+
+    IncubatorInitialState initialState(incubatorPriv, component, engine);
+    std::unique_ptr<QObject> object(createFunction(engine, context, &initialState));
+
+    const RequiredProperties *requiredProperties = incubatorPriv->requiredProperties();
+    if (requiredProperties && !requiredProperties->isEmpty()) {
+        for (const RequiredPropertyInfo &unsetRequiredProperty :
+             std::as_const(*requiredProperties)) {
+            incubatorPriv->errors
+                    << QQmlComponentPrivate::unsetRequiredPropertyToQQmlError(
+                               unsetRequiredProperty);
+        }
+    } else if (object) {
+        incubatorPriv->result = object.release();
+        incubatorPriv->progress = QQmlIncubatorPrivate::Completed;
+    }
+    incubatorPriv->changeStatus(incubatorPriv->calculateStatus());
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,81 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QQMLCPPCOMPONENT_P_H
+#define QQMLCPPCOMPONENT_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQml/qqmlcomponent.h>
+
+#include <private/qqmlcomponent_p.h>
+#include <private/qqmlcontextdata_p.h>
+#include <private/qqmlrefcount_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QQmlCppComponentPrivate;
+
+/*! \internal
+
+    Component that qmltc generates for an implicit component whose object is
+    nothing but an instance of another qmltc-compiled type, e.g.
+    \c{delegate: MyDelegate {}} or a delegate that is an inline component.
+
+    It is the same component QQmlObjectCreator::createComponent() would
+    create, except that objects incubated through
+    QQmlComponentPrivate::incubateObject(), which is what Repeater, ListView
+    and TableView do via the delegate models, are created by calling the
+    compiled type directly instead of interpreting the compilation unit.
+*/
+class Q_QML_EXPORT QQmlCppComponent : public QQmlComponent
+{
+    Q_DECLARE_PRIVATE(QQmlCppComponent)
+
+public:
+    // Called after all the bindings are set up and before the object is
+    // completed. This is where the incubator sets required properties.
+    struct InitialState
+    {
+        virtual void set(QObject *object) = 0;
+
+    protected:
+        ~InitialState() = default;
+    };
+
+    using CreateFunction = QObject *(*)(QQmlEngine *engine,
+                                        const QQmlRefPointer<QQmlContextData> &parentContext,
+                                        InitialState *initialState);
+
+    static QQmlComponent *create(QQmlEngine *engine,
+                                 QV4::ExecutableCompilationUnit *compilationUnit, int index,
+                                 QObject *parent, const QQmlRefPointer<QQmlContextData> &context,
+                                 CreateFunction createFunction);
+
+private:
+    QQmlCppComponent(QQmlEngine *engine, QV4::ExecutableCompilationUnit *compilationUnit,
+                     int index, QObject *parent, CreateFunction createFunction);
+};
+
+class QQmlCppComponentPrivate : public QQmlComponentPrivate
+{
+public:
+    void incubateObject(QQmlIncubator *incubationTask, QQmlComponent *component,
+                        QQmlEngine *engine, const QQmlRefPointer<QQmlContextData> &context,
+                        const QQmlRefPointer<QQmlContextData> &forContext) override;
+
+    QQmlCppComponent::CreateFunction createFunction = nullptr;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLCPPCOMPONENT_P_H
@@ -3,6 +3,9 @@
 
 #include "qqmlcpponassignment_p.h"
 
+#include <private/qqmlproperty_p.h>
+#include <private/qqmlpropertydata_p.h>
+
 QT_BEGIN_NAMESPACE
 
 void QQmlCppOnAssignmentHelper::set(QQmlPropertyValueInterceptor *interceptor,
@@ -17,4 +20,28 @@ void QQmlCppOnAssignmentHelper::set(QQmlPropertyValueSource *valueSource,
     valueSource->setTarget(property);
 }
 
+void QQmlCppOnAssignmentHelper::set(QQmlPropertyValueInterceptor *interceptor, QObject *object,
+                                    int metaPropertyIndex)
+{
+    interceptor->setTarget(property(object, metaPropertyIndex));
+}
+
+void QQmlCppOnAssignmentHelper::set(QQmlPropertyValueSource *valueSource, QObject *object,
+                                    int metaPropertyIndex)
+{
+    valueSource->setTarget(property(object, metaPropertyIndex));
+}
+
+QQmlProperty QQmlCppOnAssignmentHelper::property(QObject *object, int metaPropertyIndex)
+{
+    Q_ASSERT(object);
+    Q_ASSERT(metaPropertyIndex >= 0
+             && metaPropertyIndex < object->metaObject()->propertyCount());
+
+    QQmlPropertyData data;
+    data.load(object->metaObject()->property(metaPropertyIndex));
+    // Like QQmlProperty(object, name), the property doesn't carry a context
+    return QQmlPropertyPrivate::restore(object, data, nullptr, {});
+}
+
 QT_END_NAMESPACE
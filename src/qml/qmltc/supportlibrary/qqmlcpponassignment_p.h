@@ -32,13 +32,17 @@ QT_BEGIN_NAMESPACE
 */
 struct Q_QML_EXPORT QQmlCppOnAssignmentHelper
 {
-    // TODO: in theory, this API might just accept QObject * and int that would
-    // give the QMetaProperty. using the meta property, one could create
-    // QQmlProperty with a call to QQmlProperty::restore() (if there's an
-    // overload that takes QMetaProperty instead of QQmlPropertyData - which is
-    // also possible to add by using QQmlPropertyData::load())
     static void set(QQmlPropertyValueInterceptor *interceptor, const QQmlProperty &property);
     static void set(QQmlPropertyValueSource *valueSource, const QQmlProperty &property);
+
+    // Same as above, but without looking up the property by name. The index
+    // is the absolute index of the property in object's meta-object.
+    static void set(QQmlPropertyValueInterceptor *interceptor, QObject *object,
+                    int metaPropertyIndex);
+    static void set(QQmlPropertyValueSource *valueSource, QObject *object, int metaPropertyIndex);
+
+private:
+    static QQmlProperty property(QObject *object, int metaPropertyIndex);
 };
 
 QT_END_NAMESPACE
@@ -729,7 +729,7 @@ static QQmlAnyBinding createBinding(
                 scope, QV4::QmlContext::create(
                                scope.engine->rootContext(), contextData, scopeObject));
         return QQmlAnyBinding::createFromFunction(
-                prop, compilationUnit->runtimeFunctions.at(id), scopeObject, contextData,
+                prop, compilationUnit->runtimeFunction(id), scopeObject, contextData,
                 qmlCtxt);
     }
     default:
@@ -32,6 +32,7 @@ void QQmlJSBasicBlocks::dumpBasicBlocks()
             debug << type->augmentedInternalName() << ", ";
         }
         debug << "\n  jumpTarget: " << block.jumpTarget;
+        debug << "\n  exceptionTarget: " << block.exceptionTarget;
         debug << "\n  jumpIsUnConditional: " << block.jumpIsUnconditional;
         debug << "\n  isReturnBlock: " << block.isReturnBlock;
         debug << "\n  isThrowBlock: " << block.isThrowBlock;
@@ -80,13 +81,13 @@ void QQmlJSBasicBlocks::dumpDOTGraph()
     s << "}\n"_L1;
 
     // Have unique names to prevent overwriting of functions with the same name (eg. anonymous functions).
-    static int functionCount = 0;
+    static QAtomicInt functionCount = 0;
     static const auto dumpFolderPath = qEnvironmentVariable("QV4_DUMP_BASIC_BLOCKS");
 
     QString expressionName = m_context->name == ""_L1
             ? "anonymous"_L1
             : QString(m_context->name).replace(" "_L1, "_"_L1);
-    QString fileName = "function"_L1 + QString::number(functionCount++) + "_"_L1 + expressionName + ".gv"_L1;
+    QString fileName = "function"_L1 + QString::number(functionCount.fetchAndAddRelaxed(1)) + "_"_L1 + expressionName + ".gv"_L1;
     QFile dumpFile(dumpFolderPath + (dumpFolderPath.endsWith("/"_L1) ? ""_L1 : "/"_L1) + fileName);
 
     if (dumpFolderPath == "-"_L1 || dumpFolderPath == "1"_L1 || dumpFolderPath == "true"_L1) {
@@ -140,6 +141,7 @@ QQmlJSBasicBlocks::run(const Function *function, const InstructionAnnotations &a
     m_basicBlocks.insert(0, zeroBlock);
 
     const QByteArray byteCode = function->code;
+    m_unwindHandler = -1;
     decode(byteCode.constData(), static_cast<uint>(byteCode.size()));
     if (m_hadBackJumps) {
         // We may have missed some connections between basic blocks if there were back jumps.
@@ -149,10 +151,12 @@ QQmlJSBasicBlocks::run(const Function *function, const InstructionAnnotations &a
         // may have shifted.
         for (auto it = m_basicBlocks.begin(), end = m_basicBlocks.end(); it != end; ++it) {
             it->second.jumpTarget = -1;
+            it->second.exceptionTarget = -1;
             it->second.jumpIsUnconditional = false;
         }
 
         m_skipUntilNextLabel = false;
+        m_unwindHandler = -1;
 
         reset();
         decode(byteCode.constData(), static_cast<uint>(byteCode.size()));
@@ -191,10 +195,12 @@ QV4::Moth::ByteCodeHandler::Verdict QQmlJSBasicBlocks::startInstruction(QV4::Mot
     return ProcessInstruction;
 }
 
-void QQmlJSBasicBlocks::endInstruction(QV4::Moth::Instr::Type)
+void QQmlJSBasicBlocks::endInstruction(QV4::Moth::Instr::Type type)
 {
     if (m_skipUntilNextLabel)
         return;
+    if (m_unwindHandler != -1 && instructionMayThrow(type))
+        processExceptionEdge();
     auto it = m_basicBlocks.find(nextInstructionOffset());
     if (it != m_basicBlocks.end())
         it->second.jumpOrigins.append(currentInstructionOffset());
@@ -246,11 +252,28 @@ void QQmlJSBasicBlocks::generate_Ret()
 
 void QQmlJSBasicBlocks::generate_ThrowException()
 {
+    if (m_unwindHandler != -1) {
+        // Inside a try block, throwing is a jump to the catch handler.
+        processJump(m_unwindHandler - nextInstructionOffset(), Unconditional);
+        return;
+    }
+
     auto currentBlock = basicBlockForInstruction(m_basicBlocks, currentInstructionOffset());
     currentBlock.value().isThrowBlock = true;
     m_skipUntilNextLabel = true;
 }
 
+void QQmlJSBasicBlocks::generate_SetUnwindHandler(int offset)
+{
+    setUnwindHandler(offset);
+}
+
+void QQmlJSBasicBlocks::generate_UnwindToLabel(int level, int offset)
+{
+    Q_UNUSED(level);
+    processJump(offset, Unconditional);
+}
+
 void QQmlJSBasicBlocks::generate_DefineArray(int argc, int argv)
 {
     if (argc == 0)
@@ -301,6 +324,16 @@ void QQmlJSBasicBlocks::processJump(int offset, JumpMode mode)
         m_basicBlocks.insert(nextInstructionOffset(), BasicBlock());
 }
 
+void QQmlJSBasicBlocks::processExceptionEdge()
+{
+    // An instruction that may throw inside a try block ends its basic block. Its block may
+    // already have a regular jump target, so the edge to the handler is recorded separately.
+    auto currentBlock = basicBlockForInstruction(m_basicBlocks, currentInstructionOffset());
+    currentBlock->second.exceptionTarget = m_unwindHandler;
+    m_basicBlocks[m_unwindHandler].jumpOrigins.append(currentInstructionOffset());
+    m_basicBlocks.insert(nextInstructionOffset(), BasicBlock());
+}
+
 template<typename ContainerA, typename ContainerB>
 static bool containsAny(const ContainerA &container, const ContainerB &elements)
 {
@@ -492,6 +525,10 @@ void QQmlJSBasicBlocks::populateReaderLocations()
             if (jumpTarget != -1)
                 scheduleBlock(jumpTarget);
 
+            const int exceptionTarget = currentBlock->second.exceptionTarget;
+            if (exceptionTarget != -1)
+                scheduleBlock(exceptionTarget);
+
             if (isFirstBlock)
                 isFirstBlock = false;
         }
@@ -864,6 +901,9 @@ QQmlJSBasicBlocks::BasicBlocksValidationResult QQmlJSBasicBlocks::basicBlocksVal
         auto target = block.jumpTarget;
         if (target != -1 && blocks.find(target) == blocks.end())
             return { false, "Invalid jump; target is not the start of a block"_L1 };
+        target = block.exceptionTarget;
+        if (target != -1 && blocks.find(target) == blocks.end())
+            return { false, "Invalid exception handler; target is not the start of a block"_L1 };
     }
 
     return {};
@@ -31,6 +31,7 @@ public:
         QList<int> readRegisters;
         QList<QQmlJSScope::ConstPtr> readTypes;
         int jumpTarget = -1;
+        int exceptionTarget = -1;
         bool jumpIsUnconditional = false;
         bool isReturnBlock = false;
         bool isThrowBlock = false;
@@ -87,6 +88,8 @@ private:
 
     void generate_Ret() override;
     void generate_ThrowException() override;
+    void generate_SetUnwindHandler(int offset) override;
+    void generate_UnwindToLabel(int level, int offset) override;
 
     void generate_DefineArray(int argc, int argv) override;
     void generate_DefineObjectLiteral(int internalClassId, int argc, int args) override;
@@ -94,6 +97,7 @@ private:
 
     enum JumpMode { Unconditional, Conditional };
     void processJump(int offset, JumpMode mode);
+    void processExceptionEdge();
     void populateBasicBlocks();
     void populateReaderLocations();
     void adjustTypes();
@@ -0,0 +1,439 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "qqmljsbinarytypedescription_p.h"
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// Bump FormatVersion whenever the layout below or the set of serialized members changes.
+enum : quint32 {
+    Magic = 0x514d5442, // "QMTB"
+    FormatVersion = 1,
+};
+
+constexpr QDataStream::Version StreamVersion = QDataStream::Qt_6_0;
+
+class Writer
+{
+public:
+    Writer() : m_body(&m_bodyData, QIODevice::WriteOnly) { m_body.setVersion(StreamVersion); }
+
+    void writeObject(const QQmlJSExportedScope &object);
+    void writeStringList(const QStringList &strings);
+    void writeString(const QString &string) { m_body << stringIndex(string); }
+    void writeCount(qsizetype count) { m_body << quint32(count); }
+
+    QByteArray finish(const QByteArray &sourceHash);
+
+private:
+    quint32 stringIndex(const QString &string);
+    void writeProperty(const QQmlJSScope::ConstPtr &scope, const QQmlJSMetaProperty &property);
+    void writeMethod(const QQmlJSMetaMethod &method);
+    void writeEnum(const QQmlJSMetaEnum &metaEnum);
+
+    QHash<QString, quint32> m_stringIndices;
+    QStringList m_strings;
+    QByteArray m_bodyData;
+    QDataStream m_body;
+};
+
+quint32 Writer::stringIndex(const QString &string)
+{
+    const auto it = m_stringIndices.constFind(string);
+    if (it != m_stringIndices.constEnd())
+        return *it;
+
+    const quint32 index = quint32(m_strings.size());
+    m_strings.append(string);
+    m_stringIndices.insert(string, index);
+    return index;
+}
+
+void Writer::writeStringList(const QStringList &strings)
+{
+    m_body << quint32(strings.size());
+    for (const QString &string : strings)
+        writeString(string);
+}
+
+void Writer::writeObject(const QQmlJSExportedScope &object)
+{
+    const QQmlJSScope::ConstPtr scope = object.scope;
+
+    writeString(scope->internalName());
+    writeString(scope->filePath());
+    writeString(scope->baseTypeName());
+    writeString(scope->ownDefaultPropertyName());
+    writeString(scope->ownParentPropertyName());
+    writeString(scope->ownAttachedTypeName());
+    writeString(scope->valueTypeName());
+    writeString(scope->extensionTypeName());
+    m_body << quint32(scope->flags().toInt()) << quint8(scope->accessSemantics());
+    writeStringList(scope->interfaceNames());
+    writeStringList(scope->ownDeferredNames());
+    writeStringList(scope->ownImmediateNames());
+
+    m_body << quint32(object.exports.size());
+    for (const QQmlJSScope::Export &exported : object.exports) {
+        writeString(exported.package());
+        writeString(exported.type());
+        m_body << exported.version().toEncodedVersion<quint16>()
+               << exported.revision().toEncodedVersion<quint16>();
+    }
+
+    const auto properties = scope->ownProperties();
+    m_body << quint32(properties.size());
+    for (const QQmlJSMetaProperty &property : properties)
+        writeProperty(scope, property);
+
+    // QMultiHash returns the values for one key in reverse insertion order. Write them in
+    // insertion order so that reading them back produces the same overload order.
+    const auto methods = scope->ownMethods();
+    m_body << quint32(methods.size());
+    for (const QString &name : methods.uniqueKeys()) {
+        const QList<QQmlJSMetaMethod> overloads = methods.values(name);
+        for (auto it = overloads.crbegin(), end = overloads.crend(); it != end; ++it)
+            writeMethod(*it);
+    }
+
+    const auto enums = scope->ownEnumerations();
+    m_body << quint32(enums.size());
+    for (const QQmlJSMetaEnum &metaEnum : enums)
+        writeEnum(metaEnum);
+}
+
+void Writer::writeProperty(
+        const QQmlJSScope::ConstPtr &scope, const QQmlJSMetaProperty &property)
+{
+    writeString(property.propertyName());
+    writeString(property.typeName());
+    writeString(property.read());
+    writeString(property.write());
+    writeString(property.reset());
+    writeString(property.bindable());
+    writeString(property.notify());
+    writeString(property.privateClass());
+    m_body << qint32(property.revision()) << qint32(property.index());
+    m_body << quint8((property.isPointer() ? 0x1 : 0)
+                     | (property.isWritable() ? 0x2 : 0)
+                     | (property.isList() ? 0x4 : 0)
+                     | (property.isFinal() ? 0x8 : 0)
+                     | (property.isConstant() ? 0x10 : 0)
+                     | (scope->isPropertyLocallyRequired(property.propertyName()) ? 0x20 : 0));
+}
+
+void Writer::writeMethod(const QQmlJSMetaMethod &method)
+{
+    writeString(method.methodName());
+    writeString(method.returnTypeName());
+    m_body << quint8(method.methodType()) << qint32(method.revision());
+    m_body << quint8((method.isCloned() ? 0x1 : 0)
+                     | (method.isConstructor() ? 0x2 : 0)
+                     | (method.isJavaScriptFunction() ? 0x4 : 0));
+    if (method.isConstructor())
+        m_body << qint32(method.constructorIndex());
+
+    const QList<QQmlJSMetaParameter> parameters = method.parameters();
+    m_body << quint32(parameters.size());
+    for (const QQmlJSMetaParameter &parameter : parameters) {
+        writeString(parameter.name());
+        writeString(parameter.typeName());
+        m_body << quint8((parameter.typeQualifier() == QQmlJSMetaParameter::Const ? 0x1 : 0)
+                         | (parameter.isPointer() ? 0x2 : 0)
+                         | (parameter.isList() ? 0x4 : 0));
+    }
+}
+
+void Writer::writeEnum(const QQmlJSMetaEnum &metaEnum)
+{
+    writeString(metaEnum.name());
+    writeString(metaEnum.alias());
+    writeString(metaEnum.typeName());
+    m_body << quint8((metaEnum.isFlag() ? 0x1 : 0) | (metaEnum.isScoped() ? 0x2 : 0));
+    writeStringList(metaEnum.keys());
+
+    const QList<int> values = metaEnum.values();
+    m_body << quint32(values.size());
+    for (int value : values)
+        m_body << qint32(value);
+}
+
+QByteArray Writer::finish(const QByteArray &sourceHash)
+{
+    QByteArray result;
+    QDataStream stream(&result, QIODevice::WriteOnly);
+    stream.setVersion(StreamVersion);
+    stream << quint32(Magic) << quint32(FormatVersion) << QByteArray(QT_VERSION_STR)
+           << sourceHash << quint32(m_strings.size());
+    for (const QString &string : std::as_const(m_strings))
+        stream << string;
+    stream.writeRawData(m_bodyData.constData(), m_bodyData.size());
+    return result;
+}
+
+class Reader
+{
+public:
+    Reader(const QByteArray &data) : m_stream(data) { m_stream.setVersion(StreamVersion); }
+
+    bool readHeader(const QByteArray &sourceHash);
+    bool readObject(QList<QQmlJSExportedScope> *objects);
+    QStringList readStringList();
+    QString readString();
+    quint32 readCount() { return read<quint32>(); }
+    bool isOk() const { return m_stream.status() == QDataStream::Ok; }
+
+private:
+    template<typename T>
+    T read()
+    {
+        T value = {};
+        m_stream >> value;
+        return value;
+    }
+
+    void readProperty(const QQmlJSScope::Ptr &scope);
+    void readMethod(const QQmlJSScope::Ptr &scope);
+    void readEnum(const QQmlJSScope::Ptr &scope);
+
+    QDataStream m_stream;
+    QStringList m_strings;
+};
+
+bool Reader::readHeader(const QByteArray &sourceHash)
+{
+    if (read<quint32>() != Magic || read<quint32>() != FormatVersion
+            || read<QByteArray>() != QT_VERSION_STR
+            || read<QByteArray>() != sourceHash) {
+        return false;
+    }
+
+    const quint32 count = read<quint32>();
+    for (quint32 i = 0; i < count && isOk(); ++i)
+        m_strings.append(read<QString>());
+    return isOk();
+}
+
+QString Reader::readString()
+{
+    const quint32 index = read<quint32>();
+    if (index < quint32(m_strings.size()))
+        return m_strings[index];
+
+    m_stream.setStatus(QDataStream::ReadCorruptData);
+    return QString();
+}
+
+QStringList Reader::readStringList()
+{
+    QStringList result;
+    const quint32 count = read<quint32>();
+    for (quint32 i = 0; i < count && isOk(); ++i)
+        result.append(readString());
+    return result;
+}
+
+bool Reader::readObject(QList<QQmlJSExportedScope> *objects)
+{
+    QQmlJSScope::Ptr scope = QQmlJSScope::create();
+    scope->setInternalName(readString());
+    scope->setFilePath(readString());
+    scope->setBaseTypeName(readString());
+    scope->setOwnDefaultPropertyName(readString());
+    scope->setOwnParentPropertyName(readString());
+    scope->setOwnAttachedTypeName(readString());
+    scope->setValueTypeName(readString());
+    scope->setExtensionTypeName(readString());
+    scope->setFlags(QQmlJSScope::Flags::fromInt(read<quint32>()));
+    scope->setAccessSemantics(QQmlJSScope::AccessSemantics(read<quint8>()));
+    scope->setInterfaceNames(readStringList());
+    scope->setOwnDeferredNames(readStringList());
+    scope->setOwnImmediateNames(readStringList());
+
+    QList<QQmlJSScope::Export> exports;
+    const quint32 exportCount = read<quint32>();
+    for (quint32 i = 0; i < exportCount && isOk(); ++i) {
+        const QString package = readString();
+        const QString type = readString();
+        const auto version = QTypeRevision::fromEncodedVersion(read<quint16>());
+        const auto revision = QTypeRevision::fromEncodedVersion(read<quint16>());
+        exports.append(QQmlJSScope::Export(package, type, version, revision));
+    }
+
+    const quint32 propertyCount = read<quint32>();
+    for (quint32 i = 0; i < propertyCount && isOk(); ++i)
+        readProperty(scope);
+
+    const quint32 methodCount = read<quint32>();
+    for (quint32 i = 0; i < methodCount && isOk(); ++i)
+        readMethod(scope);
+
+    const quint32 enumCount = read<quint32>();
+    for (quint32 i = 0; i < enumCount && isOk(); ++i)
+        readEnum(scope);
+
+    if (!isOk() || scope->internalName().isEmpty())
+        return false;
+
+    objects->append({scope, exports});
+    return true;
+}
+
+void Reader::readProperty(const QQmlJSScope::Ptr &scope)
+{
+    QQmlJSMetaProperty property;
+    property.setPropertyName(readString());
+    property.setTypeName(readString());
+    property.setRead(readString());
+    property.setWrite(readString());
+    property.setReset(readString());
+    property.setBindable(readString());
+    property.setNotify(readString());
+    property.setPrivateClass(readString());
+    property.setRevision(read<qint32>());
+    property.setIndex(read<qint32>());
+
+    const quint8 flags = read<quint8>();
+    property.setIsPointer(flags & 0x1);
+    property.setIsWritable(flags & 0x2);
+    property.setIsList(flags & 0x4);
+    property.setIsFinal(flags & 0x8);
+    property.setIsConstant(flags & 0x10);
+
+    scope->addOwnProperty(property);
+    if (flags & 0x20)
+        scope->setPropertyLocallyRequired(property.propertyName(), true);
+}
+
+void Reader::readMethod(const QQmlJSScope::Ptr &scope)
+{
+    QQmlJSMetaMethod method;
+    method.setMethodName(readString());
+    method.setReturnTypeName(readString());
+    method.setMethodType(QQmlJSMetaMethodType(read<quint8>()));
+    method.setRevision(read<qint32>());
+
+    const quint8 flags = read<quint8>();
+    method.setIsCloned(flags & 0x1);
+    method.setIsJavaScriptFunction(flags & 0x4);
+    if (flags & 0x2) {
+        method.setIsConstructor(true);
+        method.setConstructorIndex(
+                QQmlJSMetaMethod::RelativeFunctionIndex(read<qint32>()));
+    }
+
+    const quint32 parameterCount = read<quint32>();
+    for (quint32 i = 0; i < parameterCount && isOk(); ++i) {
+        const QString name = readString();
+        const QString typeName = readString();
+        const quint8 parameterFlags = read<quint8>();
+        QQmlJSMetaParameter parameter(
+                name, typeName,
+                (parameterFlags & 0x1) ? QQmlJSMetaParameter::Const
+                                       : QQmlJSMetaParameter::NonConst);
+        parameter.setIsPointer(parameterFlags & 0x2);
+        parameter.setIsList(parameterFlags & 0x4);
+        method.addParameter(parameter);
+    }
+
+    scope->addOwnMethod(method);
+}
+
+void Reader::readEnum(const QQmlJSScope::Ptr &scope)
+{
+    QQmlJSMetaEnum metaEnum;
+    metaEnum.setName(readString());
+    metaEnum.setAlias(readString());
+    metaEnum.setTypeName(readString());
+
+    const quint8 flags = read<quint8>();
+    metaEnum.setIsFlag(flags & 0x1);
+    metaEnum.setScoped(flags & 0x2);
+
+    for (const QString &key : readStringList())
+        metaEnum.addKey(key);
+
+    const quint32 valueCount = read<quint32>();
+    for (quint32 i = 0; i < valueCount && isOk(); ++i)
+        metaEnum.addValue(read<qint32>());
+
+    scope->addOwnEnumeration(metaEnum);
+}
+
+} // namespace
+
+QByteArray QQmlJSBinaryTypeDescription::sourceHash(const QByteArray &qmltypesSource)
+{
+    return QCryptographicHash::hash(qmltypesSource, QCryptographicHash::Sha1);
+}
+
+bool QQmlJSBinaryTypeDescription::write(
+        const QString &fileName, const QByteArray &sourceHash,
+        const QList<QQmlJSExportedScope> &objects, const QStringList &dependencies,
+        const QString &warningMessage, QString *errorString)
+{
+    Writer writer;
+    writer.writeStringList(dependencies);
+    writer.writeString(warningMessage);
+    writer.writeCount(objects.size());
+    for (const QQmlJSExportedScope &object : objects)
+        writer.writeObject(object);
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+            || file.write(writer.finish(sourceHash)) < 0 || !file.commit()) {
+        *errorString = file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+bool QQmlJSBinaryTypeDescription::read(
+        const QString &fileName, const QByteArray &sourceHash,
+        QList<QQmlJSExportedScope> *objects, QStringList *dependencies,
+        QString *warningMessage)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    // Map the file rather than reading it. The strings are copied out of the mapping while
+    // decoding, so it can go away once we're done.
+    const qint64 size = file.size();
+    const uchar *mapped = file.map(0, size);
+    const QByteArray data = mapped
+            ? QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), size)
+            : file.readAll();
+
+    Reader reader(data);
+    if (!reader.readHeader(sourceHash))
+        return false;
+
+    const QStringList readDependencies = reader.readStringList();
+    const QString readWarningMessage = reader.readString();
+
+    QList<QQmlJSExportedScope> result;
+    const quint32 count = reader.readCount();
+    for (quint32 i = 0; i < count; ++i) {
+        if (!reader.readObject(&result))
+            return false;
+    }
+
+    if (!reader.isOk())
+        return false;
+
+    *objects += std::move(result);
+    *dependencies += readDependencies;
+    *warningMessage = readWarningMessage;
+    return true;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,54 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef QQMLJSBINARYTYPEDESCRIPTION_P_H
+#define QQMLJSBINARYTYPEDESCRIPTION_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#include <qtqmlcompilerexports.h>
+
+#include <private/qqmljsscope_p.h>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+
+    Pre-parsed form of a .qmltypes file. It holds exactly what
+    QQmlJSTypeDescriptionReader produces from the text, with all strings stored
+    once in a shared table. The file is tied to the text it was generated from
+    by a hash of the text, so that a stale binary file is never used.
+ */
+class Q_QMLCOMPILER_EXPORT QQmlJSBinaryTypeDescription
+{
+public:
+    static QString fileNameFor(const QString &qmltypesFile) { return qmltypesFile + u'c'; }
+    static QByteArray sourceHash(const QByteArray &qmltypesSource);
+
+    static bool write(const QString &fileName, const QByteArray &sourceHash,
+                      const QList<QQmlJSExportedScope> &objects,
+                      const QStringList &dependencies, const QString &warningMessage,
+                      QString *errorString);
+
+    // Returns false if the file doesn't exist, belongs to a different source or is corrupt.
+    static bool read(const QString &fileName, const QByteArray &sourceHash,
+                     QList<QQmlJSExportedScope> *objects, QStringList *dependencies,
+                     QString *warningMessage);
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLJSBINARYTYPEDESCRIPTION_P_H
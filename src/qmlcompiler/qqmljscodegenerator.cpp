@@ -255,6 +255,18 @@ QString QQmlJSCodeGenerator::errorReturnValue()
     return QString();
 }
 
+QString QQmlJSCodeGenerator::errorExit()
+{
+    if (m_unwindHandler == -1)
+        return u"return "_s + errorReturnValue() + u";\n"_s;
+
+    // Inside a try block we continue at the catch handler. The exception stays pending in the
+    // engine until the handler picks it up. The current instruction hasn't written its output
+    // register, yet. Therefore, convert from the registers as they were before it.
+    return u"{\n"_s + typeConversionCodeForJump(m_unwindHandler, false)
+            + u"    goto "_s + labelForOffset(m_unwindHandler) + u";\n}\n"_s;
+}
+
 void QQmlJSCodeGenerator::generate_Ret()
 {
     INJECT_TRACE_INFO(generate_Ret);
@@ -514,8 +526,19 @@ void QQmlJSCodeGenerator::generate_LoadImport(int index)
 
 void QQmlJSCodeGenerator::generate_LoadLocal(int index)
 {
-    Q_UNUSED(index);
-    reject(u"LoadLocal"_s);
+    INJECT_TRACE_INFO(generate_LoadLocal);
+
+    // The only local we can access is the exception caught by the innermost catch block.
+    if (index != 0 || m_contextVariables.isEmpty() || m_contextVariables.last().isEmpty()) {
+        reject(u"LoadLocal"_s);
+        return;
+    }
+
+    m_body += m_state.accumulatorVariableOut + u" = "_s;
+    m_body += conversion(
+            m_typeResolver->globalType(m_typeResolver->jsValueType()), m_state.accumulatorOut(),
+            m_contextVariables.last());
+    m_body += u";\n"_s;
 }
 
 void QQmlJSCodeGenerator::generate_StoreLocal(int index)
@@ -558,8 +581,20 @@ void QQmlJSCodeGenerator::generate_MoveRegExp(int regExpId, int destReg)
 
 void QQmlJSCodeGenerator::generate_LoadClosure(int value)
 {
-    Q_UNUSED(value)
-    reject(u"LoadClosure"_s);
+    INJECT_TRACE_INFO(generate_LoadClosure);
+
+    // The closure captures the current JavaScript context. We don't create the function's own
+    // call context, nor any block or catch contexts, at run time. A closure that refers to
+    // locals of this function would miss them.
+    if (m_context->requiresExecutionContext)
+        reject(u"LoadClosure capturing local variables"_s);
+    if (!m_contextVariables.isEmpty())
+        reject(u"LoadClosure inside a block or catch context"_s);
+
+    m_body += m_state.accumulatorVariableOut + u" = "_s
+            + conversion(m_typeResolver->jsValueType(), m_state.accumulatorOut(),
+                         u"aotContext->createClosure("_s + QString::number(value) + u')')
+            + u";\n"_s;
 }
 
 void QQmlJSCodeGenerator::generate_LoadName(int nameIndex)
@@ -1209,7 +1244,7 @@ bool QQmlJSCodeGenerator::generateContentPointerCheck(
     generateSetInstructionPointer();
     m_body += u"    aotContext->engine->throwError(QJSValue::TypeError, "_s;
     m_body += u"QLatin1String(\"%1\"));\n"_s.arg(processedErrorMessage);
-    m_body += u"    return "_s + errorReturnValue() + u";\n"_s;
+    m_body += u"    "_s + errorExit();
     m_body += u"}\n"_s;
     return needsVarContentConversion;
 }
@@ -1443,6 +1478,22 @@ void QQmlJSCodeGenerator::generate_SetLookup(int index, int baseReg)
     const QString indexString = QString::number(index);
     const QQmlJSScope::ConstPtr valueType = m_state.accumulatorIn().storedType();
     const QQmlJSRegisterContent callBase = m_typeResolver->original(registerType(baseReg));
+
+    if (m_typeResolver->registerContains(callBase, m_typeResolver->jsValueType())
+            || m_typeResolver->registerContains(callBase, m_typeResolver->varType())) {
+        // Untyped base. The engine has to figure out what the property is.
+        const QQmlJSScope::ConstPtr jsValueType = m_typeResolver->jsValueType();
+        generateSetInstructionPointer();
+        m_body += u"aotContext->setJSValueProperty("_s + indexString + u", "_s
+                + convertStored(registerType(baseReg).storedType(), jsValueType,
+                                registerVariable(baseReg))
+                + u", "_s
+                + convertStored(valueType, jsValueType, consumedAccumulatorVariableIn())
+                + u");\n"_s;
+        generateExceptionCheck();
+        return;
+    }
+
     const QQmlJSRegisterContent specific = m_state.readAccumulator();
     Q_ASSERT(specific.isConversion());
     const QQmlJSScope::ConstPtr conversionResultScope = specific.conversionResultScope();
@@ -1634,10 +1685,23 @@ void QQmlJSCodeGenerator::generateMoveOutVar(const QString &outVar)
 
 void QQmlJSCodeGenerator::generate_CallValue(int name, int argc, int argv)
 {
-    Q_UNUSED(name)
-    Q_UNUSED(argc)
-    Q_UNUSED(argv)
-    BYTECODE_UNIMPLEMENTED();
+    INJECT_TRACE_INFO(generate_CallValue);
+
+    AccumulatorConverter registers(this);
+
+    const QString function = convertStored(
+            registerType(name).storedType(), m_typeResolver->jsValueType(),
+            registerVariable(name));
+
+    m_body += u"{\n"_s;
+    QString outVar;
+    m_body += argumentsList(argc, argv, &outVar);
+    generateSetInstructionPointer();
+    m_body += u"aotContext->callJSValue("_s + function
+            + u", args, types, "_s + QString::number(argc) + u");\n"_s;
+    generateExceptionCheck();
+    generateMoveOutVar(outVar);
+    m_body += u"}\n"_s;
 }
 
 void QQmlJSCodeGenerator::generate_CallWithReceiver(int name, int thisObject, int argc, int argv)
@@ -2085,9 +2149,6 @@ void QQmlJSCodeGenerator::generate_CallPropertyLookup(int index, int base, int a
 {
     INJECT_TRACE_INFO(generate_CallPropertyLookup);
 
-    if (m_state.accumulatorOut().variant() == QQmlJSRegisterContent::JavaScriptReturnValue)
-        reject(u"call to untyped JavaScript function"_s);
-
     const QQmlJSScope::ConstPtr scope = m_state.accumulatorOut().scopeType();
 
     AccumulatorConverter registers(this);
@@ -2109,6 +2170,27 @@ void QQmlJSCodeGenerator::generate_CallPropertyLookup(int index, int base, int a
             return;
     }
 
+    const QString indexString = QString::number(index);
+
+    if (m_typeResolver->equals(scope, m_typeResolver->jsValueType())) {
+        // Untyped call on a JavaScript value, for example a function from a .js import.
+        const QString thisObject = convertStored(
+                baseType.storedType(), m_typeResolver->jsValueType(), registerVariable(base));
+
+        m_body += u"{\n"_s;
+        QString outVar;
+        m_body += argumentsList(argc, argv, &outVar);
+        const QString lookup = u"aotContext->callJSValueLookup("_s + indexString
+                + u", "_s + thisObject
+                + u", args, types, "_s + QString::number(argc) + u')';
+        const QString initialization = u"aotContext->initCallJSValueLookup("_s
+                + indexString + u')';
+        generateLookup(lookup, initialization);
+        generateMoveOutVar(outVar);
+        m_body += u"}\n"_s;
+        return;
+    }
+
     if (!scope->isReferenceType()) {
         // This is possible, once we establish the right kind of lookup for it
         reject(u"call to property '%1' of %2"_s.arg(name, baseType.descriptiveName()));
@@ -2118,8 +2200,6 @@ void QQmlJSCodeGenerator::generate_CallPropertyLookup(int index, int base, int a
             scope, baseType, registerVariable(base),
             u"Cannot call method '%1' of %2"_s.arg(name));
 
-    const QString indexString = QString::number(index);
-
     m_body += u"{\n"_s;
 
     QString outVar;
@@ -2137,6 +2217,8 @@ void QQmlJSCodeGenerator::generate_CallPropertyLookup(int index, int base, int a
 
 void QQmlJSCodeGenerator::generate_CallName(int name, int argc, int argv)
 {
+    // CallName is only generated where names cannot be resolved statically, that is in the
+    // presence of eval() or with statements. Those need the interpreter's scope chain.
     Q_UNUSED(name);
     Q_UNUSED(argc);
     Q_UNUSED(argv);
@@ -2152,19 +2234,29 @@ void QQmlJSCodeGenerator::generate_CallPossiblyDirectEval(int argc, int argv)
 
 void QQmlJSCodeGenerator::generate_CallGlobalLookup(int index, int argc, int argv)
 {
-    Q_UNUSED(index);
-    Q_UNUSED(argc);
-    Q_UNUSED(argv);
-    reject(u"CallGlobalLookup"_s);
+    INJECT_TRACE_INFO(generate_CallGlobalLookup);
+
+    AccumulatorConverter registers(this);
+
+    const QString indexString = QString::number(index);
+
+    m_body += u"{\n"_s;
+    QString outVar;
+    m_body += argumentsList(argc, argv, &outVar);
+    const QString lookup = u"aotContext->callGlobalLookup("_s + indexString
+            + u", args, types, "_s + QString::number(argc) + u')';
+    const QString initialization = u"aotContext->initCallGlobalLookup("_s
+            + indexString + u')';
+    generateLookup(lookup, initialization);
+    generateMoveOutVar(outVar);
+
+    m_body += u"}\n"_s;
 }
 
 void QQmlJSCodeGenerator::generate_CallQmlContextPropertyLookup(int index, int argc, int argv)
 {
     INJECT_TRACE_INFO(generate_CallQmlContextPropertyLookup);
 
-    if (m_state.accumulatorOut().variant() == QQmlJSRegisterContent::JavaScriptReturnValue)
-        reject(u"call to untyped JavaScript function"_s);
-
     if (m_typeResolver->equals(m_state.accumulatorOut().scopeType(),
                                m_typeResolver->jsGlobalObject())) {
         const QString name = m_jsUnitGenerator->stringForIndex(
@@ -2258,7 +2350,7 @@ void QQmlJSCodeGenerator::generate_Construct(int func, int argc, int argv)
 
             const QString error = u"    aotContext->engine->throwError(QJSValue::RangeError, "_s
                     + u"QLatin1String(\"Invalid array length\"));\n"_s
-                    + u"    return "_s + errorReturnValue() + u";\n"_s;
+                    + u"    "_s + errorExit();
 
             const QString indexName = registerVariable(argv);
             const auto indexType = registerType(argv);
@@ -2300,20 +2392,34 @@ void QQmlJSCodeGenerator::generate_ConstructWithSpread(int func, int argc, int a
 
 void QQmlJSCodeGenerator::generate_SetUnwindHandler(int offset)
 {
-    Q_UNUSED(offset)
-    reject(u"SetUnwindHandlerh"_s);
+    INJECT_TRACE_INFO(generate_SetUnwindHandler);
+
+    // The handler only determines where errorExit() jumps. There is no runtime state.
+    setUnwindHandler(offset);
 }
 
 void QQmlJSCodeGenerator::generate_UnwindDispatch()
 {
-    reject(u"UnwindDispatch"_s);
+    INJECT_TRACE_INFO(generate_UnwindDispatch);
+
+    // We only get here after a catch block or if the try block didn't throw. The only thing
+    // left to dispatch is an exception thrown from within the catch block. The unwind handler
+    // has already been reset to the enclosing one.
+    generateExceptionCheck();
 }
 
 void QQmlJSCodeGenerator::generate_UnwindToLabel(int level, int offset)
 {
     Q_UNUSED(level)
-    Q_UNUSED(offset)
-    BYTECODE_UNIMPLEMENTED();
+    INJECT_TRACE_INFO(generate_UnwindToLabel);
+
+    // The type propagator only lets catch handlers pass. Those don't do anything when unwinding
+    // without an exception. We can jump to the target right away. Any C++ scopes opened for
+    // catch contexts on the way are closed by the goto.
+    generateJumpCodeWithTypeConversions(offset);
+    m_body += u";\n"_s;
+    m_skipUntilNextLabel = true;
+    resetState();
 }
 
 void QQmlJSCodeGenerator::generate_DeadTemporalZoneCheck(int name)
@@ -2333,7 +2439,7 @@ void QQmlJSCodeGenerator::generate_ThrowException()
         + conversion(m_state.accumulatorIn(), m_typeResolver->globalType(
                          m_typeResolver->jsValueType()),
                      m_state.accumulatorVariableIn) + u");\n"_s;
-    m_body += u"return "_s + errorReturnValue() + u";\n"_s;
+    m_body += errorExit();
     m_skipUntilNextLabel = true;
     resetState();
 }
@@ -2352,6 +2458,7 @@ void QQmlJSCodeGenerator::generate_CreateCallContext()
 {
     INJECT_TRACE_INFO(generate_CreateCallContext);
 
+    m_contextVariables.append(QString());
     m_body += u"{\n"_s;
 }
 
@@ -2359,7 +2466,14 @@ void QQmlJSCodeGenerator::generate_PushCatchContext(int index, int nameIndex)
 {
     Q_UNUSED(index)
     Q_UNUSED(nameIndex)
-    reject(u"PushCatchContext"_s);
+    INJECT_TRACE_INFO(generate_PushCatchContext);
+
+    // The catch context only holds the caught exception. We keep it in a local variable
+    // scoped to the catch block. Taking it out of the engine clears the pending exception.
+    const QString caught = u"caught_%1"_s.arg(currentInstructionOffset());
+    m_contextVariables.append(caught);
+    m_body += u"{\n"_s;
+    m_body += u"QJSValue "_s + caught + u" = aotContext->engine->catchError();\n"_s;
 }
 
 void QQmlJSCodeGenerator::generate_PushWithContext()
@@ -2393,6 +2507,9 @@ void QQmlJSCodeGenerator::generate_PopContext()
 {
     INJECT_TRACE_INFO(generate_PopContext);
 
+    if (!m_contextVariables.isEmpty())
+        m_contextVariables.removeLast();
+
     // Add a semicolon before the closing brace, in case there was a bare label before it.
     m_body += u";}\n"_s;
 }
@@ -2536,6 +2653,11 @@ void QQmlJSCodeGenerator::generate_DefineObjectLiteral(int internalClassId, int
     INJECT_TRACE_INFO(generate_DefineObjectLiteral);
 
     const QQmlJSScope::ConstPtr stored = m_state.accumulatorOut().storedType();
+    if (m_typeResolver->equals(stored, m_typeResolver->jsValueType())) {
+        generateObjectLiteralViaEngine(internalClassId, argc, args);
+        return;
+    }
+
     if (stored->accessSemantics() != QQmlJSScope::AccessSemantics::Value) {
         reject(u"storing an object literal in a non-value type"_s);
         return;
@@ -2546,6 +2668,13 @@ void QQmlJSCodeGenerator::generate_DefineObjectLiteral(int internalClassId, int
     const int classSize = m_jsUnitGenerator->jsClassSize(internalClassId);
     Q_ASSERT(argc >= classSize);
 
+    // Computed keys, getters, setters and methods need the engine's coercion rules.
+    // We cannot statically determine the resulting properties.
+    if (argc > classSize) {
+        generateObjectLiteralViaEngine(internalClassId, argc, args);
+        return;
+    }
+
     if (m_typeResolver->equals(contained, m_typeResolver->varType())
         || m_typeResolver->equals(contained, m_typeResolver->variantMapType())) {
 
@@ -2561,27 +2690,20 @@ void QQmlJSCodeGenerator::generate_DefineObjectLiteral(int internalClassId, int
             m_body += convertStored(argType, propType, consumedArg) + u" },\n";
         }
 
-        for (int i = classSize; i < argc; i += 3) {
-            const int nameArg = argc + i + 1;
-            m_body += u"{ "_s
-                    + conversion(
-                              registerType(nameArg),
-                              m_typeResolver->globalType(m_typeResolver->stringType()),
-                              consumedRegisterVariable(nameArg))
-                    + u", "_s;
-
-            const int valueArg = argc + i + 2;
-            m_body += convertStored(
-                              registerType(valueArg).storedType(),
-                              propType,
-                              consumedRegisterVariable(valueArg))
-                    + u" },\n";
-        }
-
         m_body += u"};\n";
         return;
     }
 
+    bool isExtension = false;
+    if (argc > 0
+            && !m_typeResolver->canPopulate(contained, m_typeResolver->variantMapType(),
+                                            &isExtension)) {
+        // The type has to be constructed from the JavaScript object, following the
+        // usual coercion rules.
+        generateObjectLiteralViaEngine(internalClassId, argc, args);
+        return;
+    }
+
     m_body += m_state.accumulatorVariableOut + u" = "_s + stored->augmentedInternalName();
     const bool isVariantOrPrimitive = m_typeResolver->equals(stored, m_typeResolver->varType())
             || m_typeResolver->equals(stored, m_typeResolver->jsPrimitiveType());
@@ -2599,11 +2721,6 @@ void QQmlJSCodeGenerator::generate_DefineObjectLiteral(int internalClassId, int
     if (argc == 0)
         return;
 
-    bool isExtension = false;
-    if (!m_typeResolver->canPopulate(contained, m_typeResolver->variantMapType(), &isExtension)) {
-        reject(u"storing an object literal in a non-structured value type"_s);
-    }
-
     const QQmlJSScope::ConstPtr accessor = isExtension
             ? contained->extensionType().scope
             : contained;
@@ -2646,18 +2763,53 @@ void QQmlJSCodeGenerator::generate_DefineObjectLiteral(int internalClassId, int
         m_body += u"    }\n";
     }
 
-    // This is not implemented because we cannot statically determine the type of the value and we
-    // don't want to rely on QVariant::convert() since that may give different results than
-    // the JavaScript coercion. We might still make it work by querying the QMetaProperty
-    // for its type at run time and runtime coercing to that, but we don't know whether that
-    // still pays off.
-    if (argc > classSize)
-        reject(u"non-literal keys of object literals"_s);
-
     m_body += u"}\n";
 
 }
 
+void QQmlJSCodeGenerator::generateObjectLiteralViaEngine(int internalClassId, int argc, int args)
+{
+    // Methods, getters and setters are closures over the current context. We don't create
+    // the function's own call context, nor any block or catch contexts, at run time.
+    if (argc > m_jsUnitGenerator->jsClassSize(internalClassId)
+            && (m_context->requiresExecutionContext || !m_contextVariables.isEmpty())) {
+        reject(u"object literal with non-literal keys in a function that needs a context"_s);
+        return;
+    }
+
+    m_body += u"{\n"_s;
+    if (argc > 0) {
+        QString argsList;
+        QString typesList;
+        for (int i = 0; i < argc; ++i) {
+            if (i > 0) {
+                argsList += u", "_s;
+                typesList += u", "_s;
+            }
+            const QQmlJSRegisterContent content = registerType(args + i);
+            const QString var = registerVariable(args + i);
+            argsList += contentPointer(content, var);
+            typesList += contentType(content, var);
+        }
+        m_body += u"void *args[] = { "_s + argsList + u" };\n"_s;
+        m_body += u"const QMetaType types[] = { "_s + typesList + u" };\n"_s;
+    } else {
+        m_body += u"void **args = nullptr;\n"_s;
+        m_body += u"const QMetaType *types = nullptr;\n"_s;
+    }
+
+    generateSetInstructionPointer();
+    m_body += u"QJSValue literal = aotContext->objectLiteral("_s
+            + QString::number(internalClassId) + u", args, types, "_s
+            + QString::number(argc) + u");\n"_s;
+    generateExceptionCheck();
+    m_body += m_state.accumulatorVariableOut + u" = "_s
+            + conversion(m_typeResolver->jsValueType(), m_state.accumulatorOut(),
+                         u"std::move(literal)"_s)
+            + u";\n"_s;
+    m_body += u"}\n"_s;
+}
+
 void QQmlJSCodeGenerator::generate_CreateClass(int classIndex, int heritage, int computedNames)
 {
     Q_UNUSED(classIndex)
@@ -2740,7 +2892,7 @@ void QQmlJSCodeGenerator::generate_JumpNoException(int offset)
 {
     INJECT_TRACE_INFO(generate_JumpNoException);
 
-    m_body += u"if (!context->engine->hasException()) "_s;
+    m_body += u"if (!aotContext->engine->hasError()) "_s;
     generateJumpCodeWithTypeConversions(offset);
     m_body += u";\n"_s;
 }
@@ -3230,7 +3382,7 @@ void QQmlJSCodeGenerator::generateSetInstructionPointer()
 void QQmlJSCodeGenerator::generateExceptionCheck()
 {
     m_body += u"if (aotContext->engine->hasError())\n"_s;
-    m_body += u"    return "_s + errorReturnValue() + u";\n"_s;
+    m_body += u"    "_s + errorExit();
 }
 
 void QQmlJSCodeGenerator::generateEqualityOperation(
@@ -3591,68 +3743,80 @@ void QQmlJSCodeGenerator::generateLookup(const QString &lookup, const QString &i
 
 void QQmlJSCodeGenerator::generateJumpCodeWithTypeConversions(int relativeOffset)
 {
-    QString conversionCode;
     const int absoluteOffset = nextInstructionOffset() + relativeOffset;
-    const auto annotation = m_annotations->find(absoluteOffset);
-    if (annotation != m_annotations->constEnd()) {
-        const auto &conversions = annotation->second.typeConversions;
+    QString conversionCode = typeConversionCodeForJump(absoluteOffset, true);
 
-        for (auto regIt = conversions.constBegin(), regEnd = conversions.constEnd();
-             regIt != regEnd; ++regIt) {
-            const QQmlJSRegisterContent targetType = regIt.value().content;
-            if (!targetType.isValid() || !isTypeStorable(m_typeResolver, targetType.storedType()))
-                continue;
+    if (relativeOffset)
+        conversionCode += u"    goto "_s + labelForOffset(absoluteOffset) + u";\n"_s;
 
-            const int registerIndex = regIt.key();
-            const auto variable = m_registerVariables.constFind(RegisterVariablesKey {
-                    targetType.storedType()->internalName(),
-                    registerIndex,
-                    targetType.resultLookupIndex()
-            });
+    if (!conversionCode.isEmpty())
+        m_body += u"{\n"_s + conversionCode + u"}\n"_s;
+}
 
-            if (variable == m_registerVariables.constEnd())
-                continue;
+QString QQmlJSCodeGenerator::typeConversionCodeForJump(
+        int absoluteOffset, bool includeChangedRegister)
+{
+    QString conversionCode;
+    const auto annotation = m_annotations->find(absoluteOffset);
+    if (annotation == m_annotations->constEnd())
+        return conversionCode;
+
+    const auto &conversions = annotation->second.typeConversions;
+    for (auto regIt = conversions.constBegin(), regEnd = conversions.constEnd();
+         regIt != regEnd; ++regIt) {
+        const QQmlJSRegisterContent targetType = regIt.value().content;
+        if (!targetType.isValid() || !isTypeStorable(m_typeResolver, targetType.storedType()))
+            continue;
 
-            QQmlJSRegisterContent currentType;
-            QString currentVariable;
-            if (registerIndex == m_state.changedRegisterIndex()) {
-                currentVariable = changedRegisterVariable();
-                if (variable->variableName == currentVariable)
-                    continue;
+        const int registerIndex = regIt.key();
+        const auto variable = m_registerVariables.constFind(RegisterVariablesKey {
+                targetType.storedType()->internalName(),
+                registerIndex,
+                targetType.resultLookupIndex()
+        });
 
-                currentType = m_state.changedRegister();
-                currentVariable = u"std::move("_s + currentVariable + u')';
-            } else {
-                const auto it = m_state.registers.find(registerIndex);
-                if (it == m_state.registers.end()
-                        || variable->variableName == registerVariable(registerIndex)) {
-                    continue;
-                }
+        if (variable == m_registerVariables.constEnd())
+            continue;
 
-                currentType = it.value().content;
-                currentVariable = consumedRegisterVariable(registerIndex);
-            }
+        QQmlJSRegisterContent currentType;
+        QString currentVariable;
+        if (includeChangedRegister && registerIndex == m_state.changedRegisterIndex()) {
+            currentVariable = changedRegisterVariable();
+            if (variable->variableName == currentVariable)
+                continue;
 
-            // Actually == here. We want the jump code also for equal types
-            if (currentType == targetType)
+            currentType = m_state.changedRegister();
+            currentVariable = u"std::move("_s + currentVariable + u')';
+        } else {
+            const auto it = m_state.registers.find(registerIndex);
+            if (it == m_state.registers.end()
+                    || variable->variableName == registerVariable(registerIndex)) {
                 continue;
+            }
 
-            conversionCode += variable->variableName;
-            conversionCode += u" = "_s;
-            conversionCode += conversion(currentType, targetType, currentVariable);
-            conversionCode += u";\n"_s;
+            currentType = it.value().content;
+            currentVariable = consumedRegisterVariable(registerIndex);
         }
-    }
 
-    if (relativeOffset) {
-        auto labelIt = m_labels.find(absoluteOffset);
-        if (labelIt == m_labels.end())
-            labelIt = m_labels.insert(absoluteOffset, u"label_%1"_s.arg(m_labels.size()));
-        conversionCode += u"    goto "_s + *labelIt + u";\n"_s;
+        // Actually == here. We want the jump code also for equal types
+        if (currentType == targetType)
+            continue;
+
+        conversionCode += variable->variableName;
+        conversionCode += u" = "_s;
+        conversionCode += conversion(currentType, targetType, currentVariable);
+        conversionCode += u";\n"_s;
     }
 
-    if (!conversionCode.isEmpty())
-        m_body += u"{\n"_s + conversionCode + u"}\n"_s;
+    return conversionCode;
+}
+
+QString QQmlJSCodeGenerator::labelForOffset(int absoluteOffset)
+{
+    auto labelIt = m_labels.find(absoluteOffset);
+    if (labelIt == m_labels.end())
+        labelIt = m_labels.insert(absoluteOffset, u"label_%1"_s.arg(m_labels.size()));
+    return *labelIt;
 }
 
 QString QQmlJSCodeGenerator::registerVariable(int index) const
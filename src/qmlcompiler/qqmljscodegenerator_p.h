@@ -243,6 +243,7 @@ protected:
                              const QString &variable);
 
     QString errorReturnValue();
+    QString errorExit();
     void reject(const QString &thing);
 
     QString metaTypeFromType(const QQmlJSScope::ConstPtr &type) const;
@@ -295,6 +296,9 @@ private:
             const QString &lhs, const QString &rhs, const QString &cppOperator);
     void generateArithmeticConstOperation(int lhsConst, const QString &cppOperator);
     void generateJumpCodeWithTypeConversions(int relativeOffset);
+    void generateObjectLiteralViaEngine(int internalClassId, int argc, int args);
+    QString typeConversionCodeForJump(int absoluteOffset, bool includeChangedRegister);
+    QString labelForOffset(int absoluteOffset);
     void generateUnaryOperation(const QString &cppOperator);
     void generateInPlaceOperation(const QString &cppOperator);
     void generateMoveOutVar(const QString &outVar);
@@ -347,6 +351,10 @@ private:
     // map from instruction offset to sequential label number
     QHash<int, QString> m_labels;
 
+    // Stack of the contexts pushed so far. Catch contexts hold the name of the variable
+    // holding the caught exception, other contexts an empty string.
+    QStringList m_contextVariables;
+
     const QV4::Compiler::Context *m_context = nullptr;
     const InstructionAnnotations *m_annotations = nullptr;
 
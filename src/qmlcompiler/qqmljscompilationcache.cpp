@@ -0,0 +1,372 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "qqmljscompilationcache_p.h"
+
+#include <private/qqmljsimportvisitor_p.h>
+#include <private/qqmljslogger_p.h>
+
+#include <QtQml/private/qqmljsast_p.h>
+#include <QtQml/private/qqmljsastvisitor_p.h>
+#include <QtQml/private/qqmljsengine_p.h>
+#include <QtQml/private/qqmljslexer_p.h>
+#include <QtQml/private/qqmljsparser_p.h>
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qlibraryinfo.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qset.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+/*!
+ * \internal
+ * \class QQmlJSCompilationCache
+ *
+ * Stores the output of qmlcachegen in a directory, indexed by a key that is derived from
+ * the source code of a document, the options it is compiled with, and the interfaces of
+ * the types the document can reach. The implementations of those types are irrelevant to
+ * the generated code. Therefore, a change to a widely imported module only invalidates the
+ * documents that actually see a different property, method, enumeration, or base type.
+ */
+
+// Bump this when the format of the key or of the stored files changes.
+static const char *s_cacheFormatVersion = "qmlcachegen-cache-1";
+
+namespace {
+class IdentifierCollector : public QQmlJS::AST::Visitor
+{
+public:
+    QSet<QString> names;
+    bool failed = false;
+
+    bool visit(QQmlJS::AST::IdentifierExpression *expression) override
+    {
+        names.insert(expression->name.toString());
+        return true;
+    }
+
+    bool visit(QQmlJS::AST::FieldMemberExpression *expression) override
+    {
+        names.insert(expression->name.toString());
+        return true;
+    }
+
+    bool visit(QQmlJS::AST::UiQualifiedId *id) override
+    {
+        for (QQmlJS::AST::UiQualifiedId *segment = id; segment; segment = segment->next)
+            names.insert(segment->name.toString());
+        return true;
+    }
+
+    void throwRecursionDepthError() override { failed = true; }
+};
+}
+
+static QString boolString(bool value)
+{
+    return value ? u"1"_s : u"0"_s;
+}
+
+static QStringList sorted(QStringList list)
+{
+    std::sort(list.begin(), list.end());
+    return list;
+}
+
+QByteArray QQmlJSCompilationCache::interfaceHash(const QQmlJSScope::ConstPtr &type)
+{
+    QStringList lines;
+    lines.append(QStringList {
+            type->internalName(), type->moduleName(), type->filePath(),
+            QString::number(int(type->accessSemantics())), type->baseTypeName(),
+            QString::number(type->baseTypeRevision().toEncodedVersion<quint16>()),
+            type->ownAttachedTypeName(), type->extensionTypeName(), type->valueTypeName(),
+            type->ownDefaultPropertyName(), type->ownParentPropertyName()
+    }.join(u' '));
+
+    lines.append(QStringList {
+            boolString(type->isComposite()), boolString(type->isScript()),
+            boolString(type->isSingleton()), boolString(type->hasCreatableFlag()),
+            boolString(type->hasStructuredFlag()), boolString(type->hasCustomParser()),
+            boolString(type->isArrayScope()), boolString(type->isInlineComponent()),
+            boolString(type->extensionIsJavaScript()), boolString(type->extensionIsNamespace()),
+            boolString(type->isListProperty())
+    }.join(u' '));
+
+    lines.append(u"interfaces "_s + sorted(type->interfaceNames()).join(u' '));
+    lines.append(u"deferred "_s + sorted(type->ownDeferredNames()).join(u' '));
+    lines.append(u"immediate "_s + sorted(type->ownImmediateNames()).join(u' '));
+
+    QStringList members;
+
+    const auto properties = type->ownProperties();
+    for (const QQmlJSMetaProperty &property : properties) {
+        members.append(QStringList {
+                u"property"_s, property.propertyName(), property.typeName(),
+                property.read(), property.write(), property.reset(), property.bindable(),
+                property.notify(), property.privateClass(), property.aliasExpression(),
+                boolString(property.isList()), boolString(property.isWritable()),
+                boolString(property.isPointer()), boolString(property.isFinal()),
+                boolString(property.isConstant()), QString::number(property.revision()),
+                QString::number(property.index())
+        }.join(u' '));
+    }
+
+    const auto methods = type->ownMethods();
+    for (const QQmlJSMetaMethod &method : methods) {
+        QStringList line {
+            u"method"_s, method.methodName(), method.returnTypeName(),
+            QString::number(int(method.methodType())), QString::number(int(method.access())),
+            QString::number(method.revision()), boolString(method.isCloned()),
+            boolString(method.isConstructor()), boolString(method.isJavaScriptFunction()),
+            boolString(method.isImplicitQmlPropertyChangeSignal())
+        };
+        const auto parameters = method.parameters();
+        for (const QQmlJSMetaParameter &parameter : parameters) {
+            line.append(QStringList {
+                    parameter.name(), parameter.typeName(),
+                    QString::number(int(parameter.typeQualifier())),
+                    boolString(parameter.isPointer()), boolString(parameter.isList())
+            }.join(u':'));
+        }
+        members.append(line.join(u' '));
+    }
+
+    const auto enumerations = type->ownEnumerations();
+    for (const QQmlJSMetaEnum &enumeration : enumerations) {
+        QStringList line {
+            u"enum"_s, enumeration.name(), enumeration.alias(), enumeration.typeName(),
+            boolString(enumeration.isFlag()), boolString(enumeration.isScoped())
+        };
+        const QStringList keys = enumeration.keys();
+        const QList<int> values = enumeration.values();
+        for (qsizetype i = 0, end = keys.size(); i < end; ++i) {
+            line.append(keys[i] + u'='
+                        + (i < values.size() ? QString::number(values[i]) : QString()));
+        }
+        members.append(line.join(u' '));
+    }
+
+    const auto identifiers = type->ownJSIdentifiers();
+    for (auto it = identifiers.constBegin(), end = identifiers.constEnd(); it != end; ++it) {
+        members.append(QStringList {
+                u"identifier"_s, it.key(), QString::number(int(it->kind)),
+                it->typeName.value_or(QString()), boolString(it->isConst)
+        }.join(u' '));
+    }
+
+    lines.append(sorted(members));
+    return QCryptographicHash::hash(lines.join(u'\n').toUtf8(), QCryptographicHash::Sha256);
+}
+
+template<typename Callback>
+static void forEachInterfaceDependency(const QQmlJSScope::ConstPtr &type, Callback &&callback)
+{
+    callback(type->baseType());
+    callback(type->ownAttachedType());
+    callback(type->extensionType().scope);
+    callback(type->valueType());
+    callback(type->listType());
+
+    const auto properties = type->ownProperties();
+    for (const QQmlJSMetaProperty &property : properties)
+        callback(property.type());
+
+    const auto methods = type->ownMethods();
+    for (const QQmlJSMetaMethod &method : methods) {
+        callback(method.returnType());
+        const auto parameters = method.parameters();
+        for (const QQmlJSMetaParameter &parameter : parameters)
+            callback(parameter.type());
+    }
+
+    const auto enumerations = type->ownEnumerations();
+    for (const QQmlJSMetaEnum &enumeration : enumerations)
+        callback(enumeration.type());
+}
+
+QByteArray QQmlJSCompilationCache::key(
+        QQmlJSImporter *importer, const QString &resourcePath, const QStringList &qmldirFiles,
+        const QString &sourceCode, const QStringList &options) const
+{
+    QQmlJS::Engine engine;
+    QQmlJS::Lexer lexer(&engine);
+    lexer.setCode(sourceCode, /*lineno = */ 1, /*qmlMode=*/true);
+    QQmlJS::Parser parser(&engine);
+    if (!parser.parse())
+        return QByteArray();
+
+    // Resolve the document's imports exactly like QQmlJSAotCompiler::setDocument() does.
+    QQmlJSLogger logger;
+    logger.setSilent(true);
+    const QFileInfo resourcePathInfo(resourcePath);
+    logger.setFileName(resourcePathInfo.fileName());
+    logger.setCode(sourceCode);
+
+    QQmlJSScope::Ptr target = QQmlJSScope::create();
+    QQmlJSImportVisitor visitor(target, importer, &logger,
+                                resourcePathInfo.canonicalPath() + u'/', qmldirFiles);
+    parser.rootNode()->accept(&visitor);
+
+    // Drop what resolving the imports reported here and let the compiler, which shares the
+    // importer, get the same warnings again.
+    importer->takeWarnings();
+    importer->takeGlobalWarnings();
+    importer->beginDocument();
+
+    IdentifierCollector identifiers;
+    parser.rootNode()->accept(&identifiers);
+    if (identifiers.failed)
+        return QByteArray();
+
+    QSet<QQmlJSScope::ConstPtr> documentScopes;
+    QSet<QQmlJSScope::ConstPtr> seen;
+    QList<QQmlJSScope::ConstPtr> pending;
+    const auto enqueue = [&](const QQmlJSScope::ConstPtr &type) {
+        if (!type.isNull() && !documentScopes.contains(type) && !seen.contains(type)) {
+            seen.insert(type);
+            pending.append(type);
+        }
+    };
+
+    // The document's own scopes are covered by the source code. What they refer to is not.
+    QQmlJSScope::ConstPtr root = target;
+    while (root->parentScope())
+        root = root->parentScope();
+    QList<QQmlJSScope::ConstPtr> documentPending { root };
+    while (!documentPending.isEmpty()) {
+        const QQmlJSScope::ConstPtr scope = documentPending.takeLast();
+        documentScopes.insert(scope);
+        const auto children = scope->childScopes();
+        for (const QQmlJSScope::ConstPtr &child : children)
+            documentPending.append(child);
+    }
+
+    for (const QQmlJSScope::ConstPtr &scope : std::as_const(documentScopes)) {
+        forEachInterfaceDependency(scope, enqueue);
+        const auto bindings = scope->ownPropertyBindings();
+        for (const QQmlJSMetaPropertyBinding &binding : bindings) {
+            enqueue(binding.objectType());
+            enqueue(binding.interceptorType());
+            enqueue(binding.valueSourceType());
+            enqueue(binding.attachingType());
+            enqueue(binding.groupType());
+        }
+    }
+
+    // Script code can refer to any imported type by name. Record which names resolve to
+    // what, so that newly added or removed types also change the key.
+    QStringList namedTypes;
+    const auto recordNamedType = [&](const QString &name,
+                                     const QQmlJS::ImportedScope<QQmlJSScope::ConstPtr> &type) {
+        QString entry = name + u' '
+                + QString::number(type.revision.toEncodedVersion<quint16>()) + u' ';
+        if (!type.scope.isNull()) {
+            enqueue(type.scope);
+            entry += QString::fromLatin1(interfaceHash(type.scope).toHex());
+        }
+        namedTypes.append(entry);
+    };
+
+    const auto &imported = visitor.imports().types();
+    for (auto it = imported.constBegin(), end = imported.constEnd(); it != end; ++it) {
+        const QString &name = it.key();
+        const qsizetype dot = name.lastIndexOf(u'.');
+        if (identifiers.names.contains(dot == -1 ? name : name.mid(dot + 1)))
+            recordNamedType(name, it.value());
+    }
+
+    // The compiler itself refers to builtins by name.
+    const auto &builtins = importer->builtinInternalNames().types();
+    for (auto it = builtins.constBegin(), end = builtins.constEnd(); it != end; ++it)
+        enqueue(it->scope);
+
+    QStringList reachableTypes;
+    while (!pending.isEmpty()) {
+        const QQmlJSScope::ConstPtr type = pending.takeLast();
+        reachableTypes.append(QString::fromLatin1(interfaceHash(type).toHex()));
+        forEachInterfaceDependency(type, enqueue);
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(s_cacheFormatVersion);
+    hash.addData(QT_VERSION_STR);
+    hash.addData(QLibraryInfo::build());
+    hash.addData(options.join(u'\n').toUtf8());
+    hash.addData(resourcePath.toUtf8());
+    hash.addData(sourceCode.toUtf8());
+    hash.addData(sorted(namedTypes).join(u'\n').toUtf8());
+    hash.addData(sorted(reachableTypes).join(u'\n').toUtf8());
+    return hash.result().toHex();
+}
+
+QString QQmlJSCompilationCache::entryFileName(const QByteArray &key, const QString &suffix) const
+{
+    // Spread the entries over subdirectories, so that no single directory grows too large.
+    const QString name = QString::fromLatin1(key);
+    return m_directory + u'/' + name.left(2) + u'/' + name.mid(2) + suffix;
+}
+
+bool QQmlJSCompilationCache::restore(
+        const QByteArray &key, const QString &suffix, const QString &outputFileName) const
+{
+    QFile entry(entryFileName(key, suffix));
+    if (!entry.open(QIODevice::ReadOnly))
+        return false;
+
+    const QByteArray contents = entry.readAll();
+    if (entry.error() != QFileDevice::NoError)
+        return false;
+
+    QSaveFile output(outputFileName);
+    if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    if (output.write(contents) != contents.size())
+        return false;
+    return output.commit();
+}
+
+bool QQmlJSCompilationCache::store(
+        const QByteArray &key, const QString &suffix, const QString &outputFileName,
+        QString *errorString) const
+{
+    QFile output(outputFileName);
+    if (!output.open(QIODevice::ReadOnly)) {
+        *errorString = output.errorString();
+        return false;
+    }
+    const QByteArray contents = output.readAll();
+
+    const QString fileName = entryFileName(key, suffix);
+    if (!QDir().mkpath(QFileInfo(fileName).absolutePath())) {
+        *errorString = u"Cannot create cache directory for %1"_s.arg(fileName);
+        return false;
+    }
+
+    // QSaveFile writes to a temporary file and renames it. Concurrent qmlcachegen processes
+    // storing the same entry therefore can't produce a half-written file.
+    QSaveFile entry(fileName);
+    if (!entry.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        *errorString = entry.errorString();
+        return false;
+    }
+    if (entry.write(contents) != contents.size()) {
+        *errorString = entry.errorString();
+        return false;
+    }
+    if (!entry.commit()) {
+        *errorString = entry.errorString();
+        return false;
+    }
+    return true;
+}
+
+QT_END_NAMESPACE
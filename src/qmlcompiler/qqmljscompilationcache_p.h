@@ -0,0 +1,54 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef QQMLJSCOMPILATIONCACHE_P_H
+#define QQMLJSCOMPILATIONCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#include <qtqmlcompilerexports.h>
+
+#include <private/qqmljsimporter_p.h>
+#include <private/qqmljsscope_p.h>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_QMLCOMPILER_EXPORT QQmlJSCompilationCache
+{
+public:
+    QQmlJSCompilationCache(const QString &directory) : m_directory(directory) {}
+
+    // Returns an empty key if the document cannot be analyzed. Don't use the cache then.
+    // Starts a new document on the importer, so that compiling afterwards warns as usual.
+    QByteArray key(QQmlJSImporter *importer, const QString &resourcePath,
+                   const QStringList &qmldirFiles, const QString &sourceCode,
+                   const QStringList &options) const;
+
+    bool restore(const QByteArray &key, const QString &suffix,
+                 const QString &outputFileName) const;
+    bool store(const QByteArray &key, const QString &suffix, const QString &outputFileName,
+               QString *errorString) const;
+
+    static QByteArray interfaceHash(const QQmlJSScope::ConstPtr &type);
+
+private:
+    QString entryFileName(const QByteArray &key, const QString &suffix) const;
+
+    QString m_directory;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLJSCOMPILATIONCACHE_P_H
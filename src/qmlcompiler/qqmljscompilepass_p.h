@@ -247,6 +247,16 @@ protected:
     const Function *m_function = nullptr;
     QQmlJS::DiagnosticMessage *m_error = nullptr;
 
+    // Absolute offset of the exception handler for the current instruction,
+    // or -1 if exceptions leave the function.
+    int m_unwindHandler = -1;
+
+    void setUnwindHandler(int relativeOffset)
+    {
+        // An offset of 0 resets the handler, as in the interpreter.
+        m_unwindHandler = relativeOffset ? absoluteOffset(relativeOffset) : -1;
+    }
+
     int firstRegisterIndex() const
     {
         return FirstArgument + m_function->argumentTypes.size();
@@ -366,6 +376,9 @@ protected:
         case Type::CloneBlockContext_Wide:
         case Type::PushScriptContext:
         case Type::PushScriptContext_Wide:
+        // The unwind handler is part of the context we have to track through dead code.
+        case Type::SetUnwindHandler:
+        case Type::SetUnwindHandler_Wide:
             return true;
         default:
             break;
@@ -373,6 +386,77 @@ protected:
         return false;
     }
 
+    // Whether the code generated for the instruction may leave via an exception. This is
+    // conservative. Instructions that throw explicitly (ThrowException) are not included.
+    static bool instructionMayThrow(QV4::Moth::Instr::Type type)
+    {
+        using Type = QV4::Moth::Instr::Type;
+        switch (type) {
+        case Type::Nop:
+        case Type::Nop_Wide:
+        case Type::Ret:
+        case Type::Ret_Wide:
+        case Type::Debug:
+        case Type::Debug_Wide:
+        case Type::LoadConst:
+        case Type::LoadConst_Wide:
+        case Type::LoadZero:
+        case Type::LoadZero_Wide:
+        case Type::LoadTrue:
+        case Type::LoadTrue_Wide:
+        case Type::LoadFalse:
+        case Type::LoadFalse_Wide:
+        case Type::LoadNull:
+        case Type::LoadNull_Wide:
+        case Type::LoadUndefined:
+        case Type::LoadUndefined_Wide:
+        case Type::LoadInt:
+        case Type::LoadInt_Wide:
+        case Type::LoadRuntimeString:
+        case Type::LoadRuntimeString_Wide:
+        case Type::LoadLocal:
+        case Type::LoadLocal_Wide:
+        case Type::MoveConst:
+        case Type::MoveConst_Wide:
+        case Type::LoadReg:
+        case Type::LoadReg_Wide:
+        case Type::StoreReg:
+        case Type::StoreReg_Wide:
+        case Type::MoveReg:
+        case Type::MoveReg_Wide:
+        case Type::Jump:
+        case Type::Jump_Wide:
+        case Type::JumpTrue:
+        case Type::JumpTrue_Wide:
+        case Type::JumpFalse:
+        case Type::JumpFalse_Wide:
+        case Type::JumpNoException:
+        case Type::JumpNoException_Wide:
+        case Type::JumpNotUndefined:
+        case Type::JumpNotUndefined_Wide:
+        case Type::SetUnwindHandler:
+        case Type::SetUnwindHandler_Wide:
+        case Type::UnwindToLabel:
+        case Type::UnwindToLabel_Wide:
+        case Type::ThrowException:
+        case Type::ThrowException_Wide:
+        case Type::CreateCallContext:
+        case Type::CreateCallContext_Wide:
+        case Type::PushCatchContext:
+        case Type::PushCatchContext_Wide:
+        case Type::PopContext:
+        case Type::PopContext_Wide:
+        case Type::InitializeBlockDeadTemporalZone:
+        case Type::InitializeBlockDeadTemporalZone_Wide:
+        case Type::DeadTemporalZoneCheck:
+        case Type::DeadTemporalZoneCheck_Wide:
+            return false;
+        default:
+            break;
+        }
+        return true;
+    }
+
     // Stub out all the methods so that passes can choose to only implement part of them.
     void generate_Add(int) override {}
     void generate_As(int) override {}
@@ -17,6 +17,9 @@
 
 #include <QtCore/qfile.h>
 #include <QtCore/qfileinfo.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
 #include <QtCore/qloggingcategory.h>
 
 #include <QtQml/private/qqmlsignalnames_p.h>
@@ -484,6 +487,57 @@ Q_UNUSED(aotContext)
 Q_UNUSED(argumentsPtr)
 )";
 
+bool qSaveQmlJSAotReport(const QString &inputFileName, const QString &outputFileName,
+                         const QList<QQmlJSAotReportEntry> &report, QString *errorString)
+{
+    QJsonArray functions;
+    for (const QQmlJSAotReportEntry &entry : report) {
+        QJsonObject function;
+        function[u"name"_s] = entry.name;
+        function[u"kind"_s] = entry.isBinding ? u"binding"_s : u"function"_s;
+        function[u"line"_s] = int(entry.location.startLine);
+        function[u"column"_s] = int(entry.location.startColumn);
+        function[u"compiled"_s] = entry.rejectionReason.isEmpty();
+        if (!entry.rejectionReason.isEmpty()) {
+            QJsonObject rejection;
+            rejection[u"message"_s] = entry.rejectionReason;
+            rejection[u"line"_s] = int(entry.rejectionLocation.startLine);
+            rejection[u"column"_s] = int(entry.rejectionLocation.startColumn);
+            function[u"rejection"_s] = rejection;
+        }
+        functions.append(function);
+    }
+
+    QJsonObject root;
+    root[u"file"_s] = inputFileName;
+    root[u"functions"_s] = functions;
+
+#if QT_CONFIG(temporaryfile)
+    QSaveFile f(outputFileName);
+#else
+    QFile f(outputFileName);
+#endif
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        *errorString = f.errorString();
+        return false;
+    }
+
+    const QByteArray data = QJsonDocument(root).toJson();
+    if (f.write(data) != data.size()) {
+        *errorString = f.errorString();
+        return false;
+    }
+
+#if QT_CONFIG(temporaryfile)
+    if (!f.commit()) {
+        *errorString = f.errorString();
+        return false;
+    }
+#endif
+
+    return true;
+}
+
 bool qSaveQmlJSUnitAsCpp(const QString &inputFileName, const QString &outputFileName, const QV4::CompiledData::SaveableUnitPointer &unit, const QQmlJSAotFunctionMap &aotFunctions, QString *errorString)
 {
 #if QT_CONFIG(temporaryfile)
@@ -706,15 +760,13 @@ std::variant<QQmlJSAotFunction, QQmlJS::DiagnosticMessage> QQmlJSAotCompiler::co
     QQmlJSCompilePass::Function function = initializer.run(
                 context, name, astNode, irBinding, &error);
     const QQmlJSAotFunction aotFunction = doCompile(context, &function, &error);
+    addReportEntry(context, name, true, error);
 
     if (error.isValid()) {
         // If it's a signal and the function just returns a closure, it's harmless.
         // Otherwise promote the message to warning level.
-        return diagnose(error.message,
-                        (function.isSignalHandler && error.type == QtDebugMsg)
-                            ? QtDebugMsg
-                            : QtWarningMsg,
-                        error.loc);
+        const bool harmless = function.isSignalHandler && error.type == QtDebugMsg;
+        return diagnose(error.message, harmless ? QtDebugMsg : QtWarningMsg, error.loc);
     }
 
     qCDebug(lcAotCompiler()) << "includes:" << aotFunction.includes;
@@ -730,6 +782,7 @@ std::variant<QQmlJSAotFunction, QQmlJS::DiagnosticMessage> QQmlJSAotCompiler::co
     QQmlJS::DiagnosticMessage error;
     QQmlJSCompilePass::Function function = initializer.run(context, name, astNode, &error);
     const QQmlJSAotFunction aotFunction = doCompile(context, &function, &error);
+    addReportEntry(context, name, false, error);
 
     if (error.isValid())
         return diagnose(error.message, QtWarningMsg, error.loc);
@@ -764,6 +817,22 @@ QQmlJSAotFunction QQmlJSAotCompiler::globalCode() const
     return global;
 }
 
+void QQmlJSAotCompiler::addReportEntry(
+        const QV4::Compiler::Context *context, const QString &name, bool isBinding,
+        const QQmlJS::DiagnosticMessage &error)
+{
+    QQmlJSAotReportEntry entry;
+    entry.name = name;
+    entry.location.startLine = context->line;
+    entry.location.startColumn = context->column;
+    entry.isBinding = isBinding;
+    if (error.isValid()) {
+        entry.rejectionReason = error.message;
+        entry.rejectionLocation = error.loc;
+    }
+    m_report.append(std::move(entry));
+}
+
 QQmlJSAotFunction QQmlJSAotCompiler::doCompile(
         const QV4::Compiler::Context *context, QQmlJSCompilePass::Function *function,
         QQmlJS::DiagnosticMessage *error)
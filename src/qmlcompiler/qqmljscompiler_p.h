@@ -53,6 +53,18 @@ struct Q_QMLCOMPILER_EXPORT QQmlJSAotFunction
     QString returnType;
 };
 
+struct Q_QMLCOMPILER_EXPORT QQmlJSAotReportEntry
+{
+    QString name;
+    QQmlJS::SourceLocation location;
+
+    // Empty if the function was compiled to C++.
+    QString rejectionReason;
+    QQmlJS::SourceLocation rejectionLocation;
+
+    bool isBinding = false;
+};
+
 class Q_QMLCOMPILER_EXPORT QQmlJSAotCompiler
 {
 public:
@@ -77,6 +89,9 @@ public:
 
     virtual QQmlJSAotFunction globalCode() const;
 
+    // The compile status of every binding and function seen so far.
+    const QList<QQmlJSAotReportEntry> &report() const { return m_report; }
+
     Flags m_flags;
 
 protected:
@@ -96,10 +111,15 @@ protected:
     QQmlJSImporter *m_importer = nullptr;
     QQmlJSLogger *m_logger = nullptr;
 
+    QList<QQmlJSAotReportEntry> m_report;
+
 private:
     QQmlJSAotFunction doCompile(
             const QV4::Compiler::Context *context, QQmlJSCompilePass::Function *function,
             QQmlJS::DiagnosticMessage *error);
+    void addReportEntry(
+            const QV4::Compiler::Context *context, const QString &name, bool isBinding,
+            const QQmlJS::DiagnosticMessage &error);
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(QQmlJSAotCompiler::Flags);
@@ -127,6 +147,11 @@ bool Q_QMLCOMPILER_EXPORT qCompileJSFile(const QString &inputFileName, const QSt
                                          QQmlJSSaveFunction saveFunction,
                                          QQmlJSCompileError *error);
 
+bool Q_QMLCOMPILER_EXPORT qSaveQmlJSAotReport(const QString &inputFileName,
+                                              const QString &outputFileName,
+                                              const QList<QQmlJSAotReportEntry> &report,
+                                              QString *errorString);
+
 bool Q_QMLCOMPILER_EXPORT qSaveQmlJSUnitAsCpp(const QString &inputFileName,
                                               const QString &outputFileName,
                                               const QV4::CompiledData::SaveableUnitPointer &unit,
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include "qqmljsimporter_p.h"
+#include "qqmljsbinarytypedescription_p.h"
 #include "qqmljstypedescriptionreader_p.h"
 #include "qqmljstypereader_p.h"
 #include "qqmljsimportvisitor_p.h"
@@ -11,6 +12,7 @@
 
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qdiriterator.h>
+#include <QtCore/qscopeguard.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -83,13 +85,23 @@ void QQmlJSImporter::readQmltypes(
         return;
     }
 
-    QQmlJSTypeDescriptionReader reader { filename, QString::fromUtf8(file.readAll()) };
+    const QByteArray source = file.readAll();
     QStringList dependencyStrings;
-    auto succ = reader(objects, &dependencyStrings);
-    if (!succ)
-        m_warnings.append({ reader.errorMessage(), QtCriticalMsg, QQmlJS::SourceLocation() });
+    QString warningMessage;
+
+    // Prefer the pre-parsed form generated by qmlcachegen, if it matches the source.
+    const QString binaryFileName = QQmlJSBinaryTypeDescription::fileNameFor(filename);
+    if (!QFileInfo::exists(binaryFileName)
+            || !QQmlJSBinaryTypeDescription::read(
+                    binaryFileName, QQmlJSBinaryTypeDescription::sourceHash(source),
+                    objects, &dependencyStrings, &warningMessage)) {
+        QQmlJSTypeDescriptionReader reader { filename, QString::fromUtf8(source) };
+        auto succ = reader(objects, &dependencyStrings);
+        if (!succ)
+            m_warnings.append({ reader.errorMessage(), QtCriticalMsg, QQmlJS::SourceLocation() });
+        warningMessage = reader.warningMessage();
+    }
 
-    const QString warningMessage = reader.warningMessage();
     if (!warningMessage.isEmpty())
         m_warnings.append({ warningMessage, QtWarningMsg, QQmlJS::SourceLocation() });
 
@@ -449,6 +461,16 @@ void QQmlJSImporter::processImport(const QQmlJS::Import &importDescription,
         insertExports(*it, prefixedName(anonPrefix, internalName(it->scope)));
     }
 
+    if (!m_pendingImportLogs.isEmpty()) {
+        QList<ImportLogEntry> &log = m_importLogs[m_pendingImportLogs.last().import];
+        for (const auto &val : import.scripts)
+            log.append(QQmlJSScope::ConstPtr(val.scope));
+        for (const auto &val : import.objects) {
+            if (isComposite(val.scope))
+                log.append(QQmlJSScope::ConstPtr(val.scope));
+        }
+    }
+
     // add objects
     for (const auto &val : import.objects) {
         const QString cppName = isComposite(val.scope)
@@ -711,8 +733,27 @@ bool QQmlJSImporter::importHelper(const QString &module, AvailableTypes *types,
     if (module == u"QML"_s)
         return true;
 
-    if (getTypesFromCache())
+    // Record the import in the log of the one that loads it, if any.
+    flushImportLog();
+    if (!m_pendingImportLogs.isEmpty())
+        m_importLogs[m_pendingImportLogs.last().import].append(cacheKey);
+    const auto skipNestedWarnings = qScopeGuard([this]() {
+        if (!m_pendingImportLogs.isEmpty())
+            m_pendingImportLogs.last().warningCount = m_warnings.size();
+    });
+
+    if (getTypesFromCache()) {
+        replayImportWarnings(cacheKey);
         return true;
+    }
+
+    m_warnedImports.insert(cacheKey);
+    m_importLogs.insert(cacheKey, {});
+    m_pendingImportLogs.append({ cacheKey, m_warnings.size() });
+    const auto finishImportLog = qScopeGuard([this]() {
+        flushImportLog();
+        m_pendingImportLogs.removeLast();
+    });
 
     auto cacheTypes = QSharedPointer<QQmlJSImporter::AvailableTypes>(
                 new QQmlJSImporter::AvailableTypes(
@@ -855,6 +896,65 @@ void QQmlJSImporter::clearCache()
     m_cachedImportTypes.clear();
     m_seenQmldirFiles.clear();
     m_importedFiles.clear();
+    m_importLogs.clear();
+    m_warnedImports.clear();
+    m_typeWarnings.clear();
+    m_warnedTypes.clear();
+}
+
+void QQmlJSImporter::beginDocument()
+{
+    Q_ASSERT(m_pendingImportLogs.isEmpty());
+    m_warnedImports.clear();
+    m_warnedTypes.clear();
+}
+
+void QQmlJSImporter::flushImportLog()
+{
+    if (m_pendingImportLogs.isEmpty())
+        return;
+
+    PendingImportLog &pending = m_pendingImportLogs.last();
+    QList<ImportLogEntry> &log = m_importLogs[pending.import];
+    for (qsizetype i = pending.warningCount, end = m_warnings.size(); i < end; ++i)
+        log.append(m_warnings[i]);
+    pending.warningCount = m_warnings.size();
+}
+
+void QQmlJSImporter::replayImportWarnings(const QQmlJS::Import &import)
+{
+    if (m_warnedImports.contains(import))
+        return;
+    m_warnedImports.insert(import);
+
+    const QList<ImportLogEntry> log = m_importLogs.value(import);
+    for (const ImportLogEntry &entry : log) {
+        if (const auto *warning = std::get_if<QQmlJS::DiagnosticMessage>(&entry))
+            m_warnings.append(*warning);
+        else if (const auto *nested = std::get_if<QQmlJS::Import>(&entry))
+            replayImportWarnings(*nested);
+        else
+            replayTypeWarnings(std::get<QQmlJSScope::ConstPtr>(entry));
+    }
+}
+
+void QQmlJSImporter::replayTypeWarnings(const QQmlJSScope::ConstPtr &type)
+{
+    const auto it = m_typeWarnings.constFind(type);
+    if (it == m_typeWarnings.constEnd() || m_warnedTypes.contains(type))
+        return;
+    m_warnedTypes.insert(type);
+    m_globalWarnings.append(*it);
+}
+
+void QQmlJSImporter::addTypeWarnings(
+        const QQmlJSScope::ConstPtr &type, const QList<QQmlJS::DiagnosticMessage> &warnings)
+{
+    m_warnedTypes.insert(type);
+    if (warnings.isEmpty())
+        return;
+    m_typeWarnings.insert(type, warnings);
+    m_globalWarnings.append(warnings);
 }
 
 QQmlJSScope::ConstPtr QQmlJSImporter::jsGlobalObject() const
@@ -22,6 +22,7 @@
 #include <QtQml/private/qqmldirparser_p.h>
 
 #include <memory>
+#include <variant>
 
 QT_BEGIN_NAMESPACE
 
@@ -111,6 +112,10 @@ public:
 
     void clearCache();
 
+    // Starts a new document. Imports and types loaded for earlier documents report their
+    // warnings again when the new document uses them, as they would with a fresh importer.
+    void beginDocument();
+
     QQmlJSScope::ConstPtr jsGlobalObject() const;
 
     std::unique_ptr<QQmlJSImportVisitor>
@@ -174,6 +179,22 @@ private:
     QQmlJSScope::Ptr localFile2ScopeTree(const QString &filePath);
     static void setQualifiedNamesOn(const Import &import);
 
+    // What loading an import reported: its own warnings, the imports it loaded in turn,
+    // and the composite types it declares, in order.
+    using ImportLogEntry
+            = std::variant<QQmlJS::DiagnosticMessage, QQmlJS::Import, QQmlJSScope::ConstPtr>;
+    struct PendingImportLog
+    {
+        QQmlJS::Import import;
+        qsizetype warningCount = 0;
+    };
+
+    void flushImportLog();
+    void replayImportWarnings(const QQmlJS::Import &import);
+    void replayTypeWarnings(const QQmlJSScope::ConstPtr &type);
+    void addTypeWarnings(const QQmlJSScope::ConstPtr &type,
+                         const QList<QQmlJS::DiagnosticMessage> &warnings);
+
     QStringList m_importPaths;
 
     QHash<QPair<QString, QTypeRevision>, QString> m_seenImports;
@@ -185,6 +206,12 @@ private:
     QList<QQmlJS::DiagnosticMessage> m_warnings;
     std::optional<AvailableTypes> m_builtins;
 
+    QHash<QQmlJS::Import, QList<ImportLogEntry>> m_importLogs;
+    QList<PendingImportLog> m_pendingImportLogs;
+    QSet<QQmlJS::Import> m_warnedImports;
+    QHash<QQmlJSScope::ConstPtr, QList<QQmlJS::DiagnosticMessage>> m_typeWarnings;
+    QSet<QQmlJSScope::ConstPtr> m_warnedTypes;
+
     QQmlJSResourceFileMapper *m_mapper = nullptr;
     QQmlJSResourceFileMapper *m_metaDataMapper = nullptr;
     bool m_useOptionalImports;
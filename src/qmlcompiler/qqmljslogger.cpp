@@ -224,12 +224,12 @@ void QQmlJSLogger::registerCategory(const QQmlJS::LoggerCategory &category)
 
 static bool isMsgTypeLess(QtMsgType a, QtMsgType b)
 {
-    static QHash<QtMsgType, int> level = { { QtDebugMsg, 0 },
-                                           { QtInfoMsg, 1 },
-                                           { QtWarningMsg, 2 },
-                                           { QtCriticalMsg, 3 },
-                                           { QtFatalMsg, 4 } };
-    return level[a] < level[b];
+    static const QHash<QtMsgType, int> level = { { QtDebugMsg, 0 },
+                                                 { QtInfoMsg, 1 },
+                                                 { QtWarningMsg, 2 },
+                                                 { QtCriticalMsg, 3 },
+                                                 { QtFatalMsg, 4 } };
+    return level.value(a) < level.value(b);
 }
 
 void QQmlJSLogger::log(const QString &message, QQmlJS::LoggerWarningId id,
@@ -1129,26 +1129,28 @@ void QDeferredFactory<QQmlJSScope>::populate(const QSharedPointer<QQmlJSScope> &
     scope->setModuleName(m_moduleName);
     QQmlJSTypeReader typeReader(m_importer, m_filePath);
     typeReader(scope);
-    m_importer->m_globalWarnings.append(typeReader.errors());
+    QList<QQmlJS::DiagnosticMessage> warnings = typeReader.errors();
     scope->setInternalName(internalName());
     QQmlJSScope::resolveEnums(scope, m_importer->builtinInternalNames());
     QQmlJSScope::resolveList(scope, m_importer->builtinInternalNames().arrayType());
 
     if (m_isSingleton && !scope->isSingleton()) {
-        m_importer->m_globalWarnings.append(
+        warnings.append(
                 { QStringLiteral(
                           "Type %1 declared as singleton in qmldir but missing pragma Singleton")
                           .arg(scope->internalName()),
                   QtCriticalMsg, QQmlJS::SourceLocation() });
         scope->setIsSingleton(true);
     } else if (!m_isSingleton && scope->isSingleton()) {
-        m_importer->m_globalWarnings.append(
+        warnings.append(
                 { QStringLiteral("Type %1 not declared as singleton in qmldir "
                                  "but using pragma Singleton")
                           .arg(scope->internalName()),
                   QtCriticalMsg, QQmlJS::SourceLocation() });
         scope->setIsSingleton(false);
     }
+
+    m_importer->addTypeWarnings(QSharedPointer<const QQmlJSScope>(scope), warnings);
 }
 
 /*!
@@ -49,6 +49,7 @@ QQmlJSCompilePass::InstructionAnnotations QQmlJSTypePropagator::run(
         m_prevStateAnnotations = m_state.annotations;
         m_state = PassState();
         m_state.State::operator=(initialState(m_function));
+        m_unwindHandler = -1;
 
         reset();
         decode(m_function->code.constData(), static_cast<uint>(m_function->code.size()));
@@ -246,7 +247,8 @@ void QQmlJSTypePropagator::generate_LoadClosure(int value)
     Q_UNUSED(value)
     // TODO: Check the function at index and see whether it's a generator to return another type
     // instead.
-    setAccumulator(m_typeResolver->globalType(m_typeResolver->functionType()));
+    // Closures are plain JavaScript function objects. We can store and call them as QJSValue.
+    setAccumulator(m_typeResolver->globalType(m_typeResolver->jsValueType()));
 }
 
 void QQmlJSTypePropagator::generate_LoadName(int nameIndex)
@@ -946,6 +948,16 @@ void QQmlJSTypePropagator::generate_StoreProperty(int nameIndex, int base)
     auto callBase = m_state.registers[base].content;
     const QString propertyName = m_jsUnitGenerator->stringForIndex(nameIndex);
 
+    if (m_typeResolver->registerContains(callBase, m_typeResolver->jsValueType())
+            || m_typeResolver->registerContains(callBase, m_typeResolver->varType())) {
+        // We don't know anything about the base. Let the engine store the property.
+        const auto jsValueType = m_typeResolver->globalType(m_typeResolver->jsValueType());
+        addReadAccumulator(jsValueType);
+        addReadRegister(base, jsValueType);
+        m_state.setHasSideEffects(true);
+        return;
+    }
+
     QQmlJSRegisterContent property = m_typeResolver->memberType(callBase, propertyName);
     if (!property.isProperty()) {
         setError(u"Type %1 does not have a property %2 for writing"_s
@@ -1040,11 +1052,16 @@ void QQmlJSTypePropagator::generate_Resume(int)
 
 void QQmlJSTypePropagator::generate_CallValue(int name, int argc, int argv)
 {
+    // We don't know anything about the function being called. Pass everything as QJSValue and
+    // let the engine sort it out.
+    const auto jsValueType = m_typeResolver->globalType(m_typeResolver->jsValueType());
+    addReadRegister(name, jsValueType);
+    for (int i = 0; i < argc; ++i)
+        addReadRegister(argv + i, jsValueType);
     m_state.setHasSideEffects(true);
-    Q_UNUSED(name)
-    Q_UNUSED(argc)
-    Q_UNUSED(argv)
-    INSTR_PROLOGUE_NOT_IMPLEMENTED();
+    setAccumulator(m_typeResolver->returnType(
+            m_typeResolver->jsValueType(), QQmlJSRegisterContent::JavaScriptReturnValue,
+            m_typeResolver->jsValueType()));
 }
 
 void QQmlJSTypePropagator::generate_CallWithReceiver(int name, int thisObject, int argc, int argv)
@@ -1845,22 +1862,35 @@ void QQmlJSTypePropagator::generate_ConstructWithSpread(int func, int argc, int
 void QQmlJSTypePropagator::generate_SetUnwindHandler(int offset)
 {
     m_state.setHasSideEffects(true);
-    Q_UNUSED(offset)
-    INSTR_PROLOGUE_NOT_IMPLEMENTED_IGNORE();
+    setUnwindHandler(offset);
+    if (m_unwindHandler == -1)
+        return;
+
+    // Exceptions from a try block land on the JumpNoException in front of the catch block.
+    // Exceptions from the catch block land on the PopContext of the catch context. Any other
+    // handler runs cleanup code for loops, with statements or finally blocks. We cannot
+    // express that, and it would also mean that UnwindToLabel is more than a plain jump.
+    using Type = QV4::Moth::Instr::Type;
+    const Type handler = QV4::Moth::Instr::narrowInstructionType(QV4::Moth::Instr::unpack(
+            reinterpret_cast<const uchar *>(m_function->code.constData()) + m_unwindHandler));
+    if (handler != Type::JumpNoException && handler != Type::PopContext)
+        setError(u"Cannot handle exceptions outside of try/catch blocks"_s);
 }
 
 void QQmlJSTypePropagator::generate_UnwindDispatch()
 {
     m_state.setHasSideEffects(true);
-    INSTR_PROLOGUE_NOT_IMPLEMENTED_IGNORE();
 }
 
 void QQmlJSTypePropagator::generate_UnwindToLabel(int level, int offset)
 {
-    m_state.setHasSideEffects(true);
     Q_UNUSED(level)
-    Q_UNUSED(offset)
-    INSTR_PROLOGUE_NOT_IMPLEMENTED();
+
+    // All unwind handlers are catch blocks (see above). They don't do anything unless there is
+    // an exception. Therefore, this is a plain jump.
+    saveRegisterStateForJump(offset);
+    m_state.skipInstructionsUntilNextJumpTarget = true;
+    m_state.setHasSideEffects(true);
 }
 
 void QQmlJSTypePropagator::generate_DeadTemporalZoneCheck(int name)
@@ -1908,10 +1938,10 @@ void QQmlJSTypePropagator::generate_CreateCallContext()
 
 void QQmlJSTypePropagator::generate_PushCatchContext(int index, int name)
 {
+    // Clears the pending exception and makes it available via LoadLocal.
     m_state.setHasSideEffects(true);
     Q_UNUSED(index)
     Q_UNUSED(name)
-    INSTR_PROLOGUE_NOT_IMPLEMENTED_IGNORE();
 }
 
 void QQmlJSTypePropagator::generate_PushWithContext()
@@ -2042,6 +2072,26 @@ void QQmlJSTypePropagator::generate_DefineObjectLiteral(int internalClassId, int
     const int classSize = m_jsUnitGenerator->jsClassSize(internalClassId);
     Q_ASSERT(argc >= classSize);
 
+    if (argc > classSize) {
+        // Computed keys, getters, setters, and methods. Let the engine construct the object.
+        const auto jsValueType = m_typeResolver->globalType(m_typeResolver->jsValueType());
+        for (int i = 0; i < classSize; ++i)
+            addReadRegister(args + i, jsValueType);
+
+        for (int i = classSize; i < argc; i += 3) {
+            // layout for remaining members is:
+            // 0: ObjectLiteralArgument - Value|Method|Getter|Setter
+            // 1: name of argument
+            // 2: value of argument, or function index for methods, getters and setters
+            addReadRegister(args + i, m_typeResolver->globalType(m_typeResolver->int32Type()));
+            addReadRegister(args + i + 1, jsValueType);
+            addReadRegister(args + i + 2, jsValueType);
+        }
+
+        setAccumulator(jsValueType);
+        return;
+    }
+
     // Track each element as separate type
     for (int i = 0; i < classSize; ++i) {
         addReadRegister(
@@ -2049,23 +2099,6 @@ void QQmlJSTypePropagator::generate_DefineObjectLiteral(int internalClassId, int
                 m_typeResolver->tracked(m_typeResolver->globalType(m_typeResolver->varType())));
     }
 
-    for (int i = classSize; i < argc; i += 3) {
-        // layout for remaining members is:
-        // 0: ObjectLiteralArgument - Value|Method|Getter|Setter
-        // We cannot do anything useful with this. Any code that would call a getter/setter/method
-        // could not be compiled to C++. Ignore it.
-
-        // 1: name of argument
-        addReadRegister(
-                args + i + 1,
-                m_typeResolver->tracked(m_typeResolver->globalType(m_typeResolver->stringType())));
-
-        // 2: value of argument
-        addReadRegister(
-                args + i + 2,
-                m_typeResolver->tracked(m_typeResolver->globalType(m_typeResolver->varType())));
-    }
-
     setAccumulator(m_typeResolver->globalType(m_typeResolver->variantMapType()));
 }
 
@@ -2625,6 +2658,11 @@ QQmlJSTypePropagator::startInstruction(QV4::Moth::Instr::Type type)
         }
     }
 
+    if (m_unwindHandler != -1 && !m_state.skipInstructionsUntilNextJumpTarget
+            && (instructionMayThrow(type) || type == QV4::Moth::Instr::Type::ThrowException)) {
+        saveRegisterStateForException();
+    }
+
     return ProcessInstruction;
 }
 
@@ -2658,6 +2696,7 @@ void QQmlJSTypePropagator::endInstruction(QV4::Moth::Instr::Type instr)
     case QV4::Moth::Instr::Type::SetUnwindHandler:
     case QV4::Moth::Instr::Type::PushCatchContext:
     case QV4::Moth::Instr::Type::UnwindDispatch:
+    case QV4::Moth::Instr::Type::UnwindToLabel:
     case QV4::Moth::Instr::Type::InitializeBlockDeadTemporalZone:
     case QV4::Moth::Instr::Type::ConvertThisToObject:
     case QV4::Moth::Instr::Type::DeadTemporalZoneCheck:
@@ -2685,6 +2724,17 @@ void QQmlJSTypePropagator::endInstruction(QV4::Moth::Instr::Type instr)
         Q_ASSERT(m_state.hasSideEffects() || m_state.changedRegisterIndex() != -1);
     }
 
+    if (m_unwindHandler != -1 && instructionMayThrow(instr)
+            && m_state.changedRegisterIndex() != InvalidRegister
+            && m_state.changedRegisterIndex() != Accumulator) {
+        // The exception handler expects the register state from before the instruction, but
+        // the basic blocks can only see the state after it. The two only differ in the
+        // accumulator, which is never live at the beginning of a handler.
+        setError(u"Cannot handle exceptions from instructions that write %1"_s
+                         .arg(registerName(m_state.changedRegisterIndex())));
+        return;
+    }
+
     if (m_state.changedRegisterIndex() != InvalidRegister) {
         Q_ASSERT(m_error->isValid() || m_state.changedRegister().isValid());
         VirtualRegister &r = m_state.registers[m_state.changedRegisterIndex()];
@@ -2721,9 +2771,24 @@ QQmlJSRegisterContent QQmlJSTypePropagator::propagateBinaryOperation(QSOperator:
 
 void QQmlJSTypePropagator::saveRegisterStateForJump(int offset)
 {
-    auto jumpToOffset = offset + nextInstructionOffset();
+    saveRegisterState(offset + nextInstructionOffset(), m_state.registers);
+}
+
+void QQmlJSTypePropagator::saveRegisterStateForException()
+{
+    // The instruction hasn't written anything when it throws. We record the state before it.
+    // The accumulator is dead at the beginning of any handler. Leave it out so that the
+    // handler doesn't have to merge the accumulator types of all throwing instructions.
+    VirtualRegisters registers = m_state.registers;
+    registers.remove(Accumulator);
+    saveRegisterState(m_unwindHandler, registers);
+}
+
+void QQmlJSTypePropagator::saveRegisterState(int jumpToOffset, const VirtualRegisters &registers)
+{
+    const int offset = jumpToOffset - nextInstructionOffset();
     ExpectedRegisterState state;
-    state.registers = m_state.registers;
+    state.registers = registers;
     state.originatingOffset = currentInstructionOffset();
     m_state.jumpTargets.insert(jumpToOffset);
     if (offset < 0) {
@@ -219,6 +219,8 @@ private:
             const QString &name, int lookupIndex = QQmlJSRegisterContent::InvalidLookupIndex);
     void propagateScopeLookupCall(const QString &functionName, int argc, int argv);
     void saveRegisterStateForJump(int offset);
+    void saveRegisterStateForException();
+    void saveRegisterState(int jumpToOffset, const VirtualRegisters &registers);
     bool canConvertFromTo(const QQmlJSRegisterContent &from, const QQmlJSRegisterContent &to);
 
     QString registerName(int registerIndex) const;
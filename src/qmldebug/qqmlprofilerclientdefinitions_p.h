@@ -30,6 +30,8 @@ enum Message {
     SceneGraphFrame,
     MemoryAllocation,
     DebugMessage,
+    Quick3DFrame,
+    BindingStatistics,
 
     MaximumMessage
 };
@@ -78,6 +80,7 @@ enum SceneGraphFrameType {
     SceneGraphWindowsRenderShow,    // Unused
     SceneGraphWindowsAnimations,    // GUI Thread
     SceneGraphPolishFrame,          // GUI Thread
+    SceneGraphFrameLatency,         // GUI Thread
 
     MaximumSceneGraphFrameType,
     NumRenderThreadFrameTypes = SceneGraphPolishAndSync,
@@ -103,6 +106,8 @@ enum ProfileFeature {
     ProfileHandlingSignal,
     ProfileInputEvents,
     ProfileDebugMessages,
+    ProfileQuick3D,
+    ProfileBindingStatistics,
 
     MaximumProfileFeature
 };
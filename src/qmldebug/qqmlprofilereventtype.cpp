@@ -48,6 +48,10 @@ ProfileFeature QQmlProfilerEventType::feature() const
         return ProfileMemory;
     case DebugMessage:
         return ProfileDebugMessages;
+    case Quick3DFrame:
+        return ProfileQuick3D;
+    case BindingStatistics:
+        return ProfileBindingStatistics;
     default:
         break;
     }
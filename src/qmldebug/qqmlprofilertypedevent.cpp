@@ -128,6 +128,27 @@ QDataStream &operator>>(QDataStream &stream, QQmlProfilerTypedEvent &event)
         event.event.setNumbers<qint64>({delta});
         break;
     }
+    case BindingStatistics: {
+        QString filename;
+        qint32 line = 0;
+        qint32 column = 0;
+        stream >> filename >> line >> column;
+
+        // evaluations, total time, captured dependencies, dependency churn, recaptures
+        QVarLengthArray<qint64> numbers;
+        qint64 number;
+        while (!stream.atEnd()) {
+            stream >> number;
+            numbers.push_back(number);
+        }
+
+        event.type = QQmlProfilerEventType(
+                    static_cast<Message>(messageType),
+                    MaximumRangeType, subtype,
+                    QQmlProfilerEventLocation(filename, line, column));
+        event.event.setNumbers<QVarLengthArray<qint64>, qint64>(numbers);
+        break;
+    }
     case RangeStart: {
         if (!stream.atEnd()) {
             qint64 typeId;
@@ -2911,7 +2911,7 @@ bool QQmlListModelParser::applyProperty(
                 QV4::Scope scope(v4);
                 // for now we do not provide a context object; data from the ListElement must be passed to the function
                 QV4::ScopedContext context(scope, QV4::QmlContext::create(v4->rootContext(), QQmlContextData::get(qmlContext(model->m_modelCache)), nullptr));
-                QV4::ScopedFunctionObject function(scope, QV4::FunctionObject::createScriptFunction(context, compilationUnit->runtimeFunctions[id]));
+                QV4::ScopedFunctionObject function(scope, QV4::FunctionObject::createScriptFunction(context, compilationUnit->runtimeFunction(id)));
 
                 QJSValue v;
                 QV4::ScopedValue result(scope, function->call(v4->globalObject, nullptr, 0));
@@ -37,6 +37,7 @@
 #include <QtQml/qqmlincubator.h>
 #include <QtQml/qqmlinfo.h>
 #include <QtQml/private/qqmlmetatype_p.h>
+#include <QtQml/private/qqmlengine_p.h>
 
 #include <QtQuick/private/qquickpixmap_p.h>
 
@@ -359,6 +360,10 @@ void QQuickWindowPrivate::polishItems()
     // or indirectly, we use a PolishLoopDetector to determine if a warning should
     // be printed to the user.
 
+    // Settle bindings queued in batched binding update mode first, so that the items
+    // are polished against a consistent state.
+    QQmlEnginePrivate::flushAllDirtyBindings();
+
     PolishLoopDetector polishLoopDetector(itemsToPolish);
     while (!itemsToPolish.isEmpty()) {
         QQuickItem *item = itemsToPolish.takeLast();
@@ -806,6 +811,7 @@ void QQuickWindowPrivate::init(QQuickWindow *c, QQuickRenderControl *control)
     QObject::connect(context, &QSGRenderContext::initialized, q, &QQuickWindow::sceneGraphInitialized, Qt::DirectConnection);
     QObject::connect(context, &QSGRenderContext::invalidated, q, &QQuickWindow::sceneGraphInvalidated, Qt::DirectConnection);
     QObject::connect(context, &QSGRenderContext::invalidated, q, &QQuickWindow::cleanupSceneGraph, Qt::DirectConnection);
+    QObject::connect(context, &QSGRenderContext::distanceFieldGlyphsGenerated, q, &QQuickWindow::update, Qt::QueuedConnection);
 
     QObject::connect(q, &QQuickWindow::focusObjectChanged, q, &QQuickWindow::activeFocusItemChanged);
     QObject::connect(q, &QQuickWindow::screenChanged, q, &QQuickWindow::handleScreenChanged);
@@ -9,13 +9,36 @@
 #include "qsgsoftwarerenderablenode_p.h"
 
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#include <QtGui/QImage>
+#include <QtGui/QPainter>
 #include <QtGui/QWindow>
 #include <QtQuick/QSGSimpleRectNode>
 
+#include <algorithm>
+
 Q_LOGGING_CATEGORY(lc2DRender, "qt.scenegraph.softwarecontext.abstractrenderer")
 
 QT_BEGIN_NAMESPACE
 
+// How long the nodes of a subtree have to stay the same before it is cached
+static const int LayerCacheUnchangedFrames = 10;
+
+// A subtree painted into an image, standing in for its renderable nodes in
+// the render list as long as they don't change
+struct QSGAbstractSoftwareRenderer::CachedLayer
+{
+    explicit CachedLayer(QSGNode *root)
+        : renderable(QSGSoftwareRenderableNode::CachedLayer, root)
+    {
+    }
+
+    QSGSoftwareRenderableNode renderable;
+    QVector<QSGSoftwareRenderableNode *> nodes;
+    qsizetype size = 0;
+};
+
 QSGAbstractSoftwareRenderer::QSGAbstractSoftwareRenderer(QSGRenderContext *context)
     : QSGRenderer(context)
     , m_background(new QSGSimpleRectNode)
@@ -24,6 +47,9 @@ QSGAbstractSoftwareRenderer::QSGAbstractSoftwareRenderer(QSGRenderContext *conte
     // Setup special background node
     auto backgroundRenderable = new QSGSoftwareRenderableNode(QSGSoftwareRenderableNode::SimpleRect, m_background);
     addNodeMapping(m_background, backgroundRenderable);
+
+    if (QThread::idealThreadCount() > 1)
+        m_tileSize = qMax(0, qEnvironmentVariableIntValue("QSG_SOFTWARE_TILE_SIZE"));
 }
 
 QSGAbstractSoftwareRenderer::~QSGAbstractSoftwareRenderer()
@@ -32,6 +58,7 @@ QSGAbstractSoftwareRenderer::~QSGAbstractSoftwareRenderer()
     delete m_background;
 
     qDeleteAll(m_nodes);
+    clearLayerCache();
 
     delete m_nodeUpdater;
 }
@@ -93,6 +120,9 @@ QRegion QSGAbstractSoftwareRenderer::renderNodes(QPainter *painter)
     if (m_renderableNodes.isEmpty())
         return dirtyRegion;
 
+    if (m_tileSize > 0 && canRenderTiled(painter))
+        return renderNodesTiled(painter);
+
     auto iterator = m_renderableNodes.begin();
     // First node is the background and needs to painted without blending
     auto backgroundNode = *iterator;
@@ -107,6 +137,128 @@ QRegion QSGAbstractSoftwareRenderer::renderNodes(QPainter *painter)
     return dirtyRegion;
 }
 
+bool QSGAbstractSoftwareRenderer::canRenderTiled(QPainter *painter) const
+{
+    // Tiles are painted through QImages sharing the memory of the target
+    // image, so the target has to be an image with whole bytes per pixel
+    QPaintDevice *device = painter->device();
+    if (device->devType() != QInternal::Image)
+        return false;
+    const QImage *image = static_cast<const QImage *>(device);
+    if (image->depth() < 8 || image->depth() % 8 != 0)
+        return false;
+    // Tile edges have to be on device pixels
+    const qreal dpr = image->devicePixelRatio();
+    if (!qFuzzyCompare(dpr, qreal(qRound(dpr))))
+        return false;
+    if (!painter->transform().isIdentity() || painter->hasClipping())
+        return false;
+
+    // Render nodes paint with the renderer's painter
+    for (QSGSoftwareRenderableNode *node : m_renderableNodes) {
+        if (node->type() == QSGSoftwareRenderableNode::RenderNode && node->isDirty())
+            return false;
+    }
+    return true;
+}
+
+/*
+    Splits the area to paint into tiles of m_tileSize and paints them
+    concurrently, one QPainter per tile. optimizeRenderList() has already
+    removed the parts covered by opaque nodes from each node's dirty region,
+    so intersecting that region with the tile gives what the node has to
+    paint there.
+*/
+QRegion QSGAbstractSoftwareRenderer::renderNodesTiled(QPainter *painter)
+{
+    QImage *image = static_cast<QImage *>(painter->device());
+    const qreal dpr = image->devicePixelRatio();
+    const int ratio = qRound(dpr);
+
+    QVector<QSGSoftwareRenderableNode *> nodesToPaint;
+    QRegion paintRegion;
+    for (QSGSoftwareRenderableNode *node : std::as_const(m_renderableNodes)) {
+        if (node->type() == QSGSoftwareRenderableNode::RenderNode || !node->needsPaint())
+            continue;
+        node->preparePaint(dpr);
+        nodesToPaint.append(node);
+        paintRegion += node->dirtyRegion();
+    }
+
+    QVector<QRect> tiles;
+    const QRect bounds = paintRegion.boundingRect() & backgroundRect();
+    const int left = bounds.left() - bounds.left() % m_tileSize;
+    const int top = bounds.top() - bounds.top() % m_tileSize;
+    for (int y = top; y <= bounds.bottom(); y += m_tileSize) {
+        for (int x = left; x <= bounds.right(); x += m_tileSize) {
+            const QRect tile = QRect(x, y, m_tileSize, m_tileSize) & bounds;
+            if (paintRegion.intersects(tile))
+                tiles.append(tile);
+        }
+    }
+
+    if (tiles.size() > 1) {
+        if (!m_tilePool) {
+            m_tilePool.reset(new QThreadPool);
+            m_tilePool->setObjectName(QLatin1String("QSGSoftwareTilePool"));
+        }
+
+        QSGSoftwareRenderableNode *backgroundNode = m_renderableNodes.first();
+        const QPainter::RenderHints renderHints = painter->renderHints();
+        // bits() must be called before painting, it may detach
+        uchar *bits = image->bits();
+        const qsizetype bytesPerLine = image->bytesPerLine();
+        const int bytesPerPixel = image->depth() / 8;
+        const QImage::Format format = image->format();
+
+        for (const QRect &tile : std::as_const(tiles)) {
+            m_tilePool->start([this, &nodesToPaint, backgroundNode, renderHints, bits, bytesPerLine,
+                               bytesPerPixel, format, tile, ratio, dpr]() {
+                const QRect deviceRect(tile.topLeft() * ratio, tile.size() * ratio);
+                QImage tileImage(bits + deviceRect.y() * bytesPerLine
+                                         + deviceRect.x() * bytesPerPixel,
+                                 deviceRect.width(), deviceRect.height(), bytesPerLine, format);
+                tileImage.setDevicePixelRatio(dpr);
+
+                QPainter tilePainter(&tileImage);
+                tilePainter.setRenderHints(renderHints);
+                // The window has the size of the viewport, which is in device
+                // pixels, so this only moves the tile's origin to (0, 0).
+                // Nodes replace the world transform, so it can't be used here.
+                tilePainter.setWindow(QRect(tile.topLeft(), deviceRect.size()));
+
+                for (QSGSoftwareRenderableNode *node : nodesToPaint) {
+                    const QRegion clipRegion = node->dirtyRegion() & tile;
+                    if (clipRegion.isEmpty())
+                        continue;
+                    const bool forceOpaque = node == backgroundNode;
+                    if (node->type() == QSGSoftwareRenderableNode::Glyph) {
+                        // The glyph caches of the font engines are not thread-safe
+                        QMutexLocker locker(&m_glyphMutex);
+                        node->paint(&tilePainter, clipRegion, forceOpaque);
+                    } else {
+                        node->paint(&tilePainter, clipRegion, forceOpaque);
+                    }
+                }
+            });
+        }
+        m_tilePool->waitForDone();
+    } else {
+        // Not worth the thread hop
+        for (QSGSoftwareRenderableNode *node : std::as_const(nodesToPaint))
+            node->paint(painter, node->dirtyRegion(), node == m_renderableNodes.first());
+    }
+
+    QRegion dirtyRegion;
+    for (QSGSoftwareRenderableNode *node : std::as_const(m_renderableNodes)) {
+        if (node->type() == QSGSoftwareRenderableNode::RenderNode)
+            dirtyRegion += node->renderNode(painter); // not dirty, just resets the state
+        else
+            dirtyRegion += node->finishPaint();
+    }
+    return dirtyRegion;
+}
+
 void QSGAbstractSoftwareRenderer::buildRenderList()
 {
     // Clear the previous renderlist
@@ -114,7 +266,140 @@ void QSGAbstractSoftwareRenderer::buildRenderList()
     // Add the background renderable (always first)
     m_renderableNodes.append(renderableNode(m_background));
     // Build the renderlist
-    QSGSoftwareRenderListBuilder(this).visitChildren(rootNode());
+    const int firstIndex = m_renderableNodes.size();
+    QSGSoftwareRenderListBuilder builder(this);
+    builder.visitChildren(rootNode());
+
+    if (m_layerCacheSize > 0)
+        updateLayerCache(builder, firstIndex);
+}
+
+void QSGAbstractSoftwareRenderer::setLayerCacheSize(qsizetype bytes)
+{
+    m_layerCacheSize = bytes;
+    if (m_layerCacheSize <= 0)
+        clearLayerCache();
+}
+
+/*
+    Replaces the renderable nodes of subtrees that have not changed for
+    LayerCacheUnchangedFrames frames with a CachedLayer each. Outer subtrees
+    are preferred, until the layers would take up more than m_layerCacheSize.
+
+    A layer shows exactly what its nodes have painted, so it can replace them
+    without repainting anything. When one of the nodes changes, the subtree
+    isn't a candidate anymore and its nodes are back in the render list, where
+    optimizeRenderList() handles the change like without a layer.
+*/
+void QSGAbstractSoftwareRenderer::updateLayerCache(const QSGSoftwareRenderListBuilder &builder,
+                                                   int firstIndex)
+{
+    // The layers are painted in device pixels and put on pixel boundaries
+    if (!qFuzzyCompare(m_devicePixelRatio, qreal(qRound(m_devicePixelRatio)))) {
+        clearLayerCache();
+        return;
+    }
+
+    QList<QSGSoftwareRenderListBuilder::Subtree> subtrees = builder.subtrees();
+    // Outer subtrees first
+    std::stable_sort(subtrees.begin(), subtrees.end(), [](const auto &a, const auto &b) {
+        return a.start < b.start || (a.start == b.start && a.end > b.end);
+    });
+
+    const int ratio = qRound(m_devicePixelRatio);
+    QHash<QSGNode *, CachedLayer *> layers;
+    qsizetype cacheSize = 0;
+    QVector<QSGSoftwareRenderableNode *> renderList;
+    int copied = 0;
+    for (const QSGSoftwareRenderListBuilder::Subtree &subtree : std::as_const(subtrees)) {
+        const int start = firstIndex + subtree.start;
+        const int end = firstIndex + subtree.end;
+        if (start < copied || subtree.hasRenderNode
+            || subtree.unchangedFrames < LayerCacheUnchangedFrames) {
+            continue;
+        }
+
+        const auto first = m_renderableNodes.cbegin() + start;
+        const auto last = m_renderableNodes.cbegin() + end;
+        CachedLayer *layer = m_layerCache.take(subtree.root);
+        if (layer && !std::equal(layer->nodes.cbegin(), layer->nodes.cend(), first, last)) {
+            delete layer;
+            layer = nullptr;
+        }
+
+        if (!layer) {
+            QRect rect;
+            for (auto it = first; it != last; ++it)
+                rect |= (*it)->boundingRectMax();
+            rect &= backgroundRect();
+            if (rect.isEmpty())
+                continue;
+            const qsizetype size = qsizetype(rect.width()) * rect.height() * ratio * ratio * 4;
+            if (cacheSize + size > m_layerCacheSize)
+                continue;
+            layer = createCachedLayer(subtree.root, start, end, rect);
+            if (!layer)
+                continue;
+        } else if (cacheSize + layer->size > m_layerCacheSize) {
+            delete layer;
+            continue;
+        }
+
+        cacheSize += layer->size;
+        layers.insert(subtree.root, layer);
+        renderList += m_renderableNodes.mid(copied, start - copied);
+        renderList.append(&layer->renderable);
+        copied = end;
+    }
+
+    // Whatever is left over has changed or doesn't fit anymore
+    qDeleteAll(m_layerCache);
+    m_layerCache = std::move(layers);
+
+    if (copied > 0) {
+        renderList += m_renderableNodes.mid(copied);
+        m_renderableNodes = std::move(renderList);
+    }
+    qCDebug(lc2DRender) << "layer cache:" << m_layerCache.size() << "layers," << cacheSize << "bytes";
+}
+
+QSGAbstractSoftwareRenderer::CachedLayer *
+QSGAbstractSoftwareRenderer::createCachedLayer(QSGNode *root, int start, int end,
+                                               const QRect &rect) const
+{
+    const int ratio = qRound(m_devicePixelRatio);
+    QImage image(rect.size() * ratio, QImage::Format_ARGB32_Premultiplied);
+    if (image.isNull())
+        return nullptr;
+    image.setDevicePixelRatio(ratio);
+    image.fill(Qt::transparent);
+
+    auto layer = new CachedLayer(root);
+    layer->nodes = m_renderableNodes.mid(start, end - start);
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    // Moves the layer's origin to (0, 0), like for the tiles in renderNodesTiled()
+    painter.setWindow(QRect(rect.topLeft(), image.size()));
+    for (QSGSoftwareRenderableNode *node : std::as_const(layer->nodes)) {
+        // Like the dirty region, the area to paint must not go past the node's clip
+        const QRegion clipRegion(node->boundingRectMax() & rect);
+        if (clipRegion.isEmpty())
+            continue;
+        node->preparePaint(ratio);
+        node->paint(&painter, clipRegion, false);
+    }
+    painter.end();
+
+    layer->size = image.sizeInBytes();
+    layer->renderable.setLayerImage(image, rect);
+    return layer;
+}
+
+void QSGAbstractSoftwareRenderer::clearLayerCache()
+{
+    qDeleteAll(m_layerCache);
+    m_layerCache.clear();
 }
 
 QRegion QSGAbstractSoftwareRenderer::optimizeRenderList()
@@ -214,6 +499,8 @@ void QSGAbstractSoftwareRenderer::setBackgroundRect(const QRect &rect, qreal dev
     m_background->setRect(rect);
     m_devicePixelRatio = devicePixelRatio;
         renderableNode(m_background)->markGeometryDirty();
+    // Layers are clipped to the background and painted for its pixel ratio
+    clearLayerCache();
     // Invalidate the whole scene when the background is resized
     markDirty();
 }
@@ -250,6 +537,7 @@ void QSGAbstractSoftwareRenderer::nodeRemoved(QSGNode *node)
         m_nodes.remove(node);
         delete renderable;
     }
+    delete m_layerCache.take(node);
 
     // Remove all children nodes as well
     for (QSGNode *child = node->firstChild(); child; child = child->nextSibling()) {
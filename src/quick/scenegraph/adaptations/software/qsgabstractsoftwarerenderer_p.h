@@ -18,13 +18,18 @@
 #include <private/qsgrenderer_p.h>
 
 #include <QtCore/QHash>
+#include <QtCore/QMutex>
+
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
 class QSGSimpleRectNode;
+class QThreadPool;
 
 class QSGSoftwareRenderableNode;
 class QSGSoftwareRenderableNodeUpdater;
+class QSGSoftwareRenderListBuilder;
 
 class Q_QUICK_EXPORT QSGAbstractSoftwareRenderer : public QSGRenderer
 {
@@ -52,6 +57,8 @@ protected:
     // only known after calling optimizeRenderList()
     bool isOpaque() const { return m_isOpaque; }
     const QVector<QSGSoftwareRenderableNode*> &renderableNodes() const;
+    // 0 disables layer caching
+    void setLayerCacheSize(qsizetype bytes);
 
 private:
     void nodeAdded(QSGNode *node);
@@ -61,6 +68,14 @@ private:
     void nodeMatrixUpdated(QSGNode *node);
     void nodeOpacityUpdated(QSGNode *node);
 
+    bool canRenderTiled(QPainter *painter) const;
+    QRegion renderNodesTiled(QPainter *painter);
+
+    struct CachedLayer;
+    void updateLayerCache(const QSGSoftwareRenderListBuilder &builder, int firstIndex);
+    CachedLayer *createCachedLayer(QSGNode *root, int start, int end, const QRect &rect) const;
+    void clearLayerCache();
+
     QHash<QSGNode*, QSGSoftwareRenderableNode*> m_nodes;
     QVector<QSGSoftwareRenderableNode*> m_renderableNodes;
 
@@ -72,6 +87,15 @@ private:
     bool m_isOpaque = false;
 
     QSGSoftwareRenderableNodeUpdater *m_nodeUpdater;
+
+    // Tiled rendering, enabled with QSG_SOFTWARE_TILE_SIZE
+    int m_tileSize = 0;
+    std::unique_ptr<QThreadPool> m_tilePool;
+    QMutex m_glyphMutex;
+
+    // Layer caching, see setLayerCacheSize()
+    qsizetype m_layerCacheSize = 0;
+    QHash<QSGNode *, CachedLayer *> m_layerCache;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,251 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qsgsoftwareblitter_p.h"
+
+#include <QtCore/QVarLengthArray>
+#include <QtGui/QTransform>
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#  define QSG_SOFTWARE_BLITTER_SSE2
+#elif (defined(__ARM_NEON__) || defined(__ARM_NEON)) && Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+#  include <arm_neon.h>
+#  define QSG_SOFTWARE_BLITTER_NEON
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace QSGSoftwareBlitter {
+
+// Same rounding as BYTE_MUL() in qdrawhelper_p.h, so that blending gives
+// exactly what QPainter's raster engine gives
+static inline quint32 byteMul(quint32 x, quint32 a)
+{
+    quint32 t = (x & 0xff00ff) * a;
+    t = (t + ((t >> 8) & 0xff00ff) + 0x800080) >> 8;
+    t &= 0xff00ff;
+
+    x = ((x >> 8) & 0xff00ff) * a;
+    x = (x + ((x >> 8) & 0xff00ff) + 0x800080);
+    x &= 0xff00ff00;
+    return x | t;
+}
+
+#if defined(QSG_SOFTWARE_BLITTER_SSE2)
+// alpha has the factor in each 16 bit lane
+static inline __m128i byteMul(__m128i pixels, __m128i alpha)
+{
+    const __m128i colorMask = _mm_set1_epi32(0x00ff00ff);
+    const __m128i half = _mm_set1_epi16(0x80);
+    __m128i ag = _mm_srli_epi16(pixels, 8);
+    __m128i rb = _mm_and_si128(pixels, colorMask);
+    ag = _mm_mullo_epi16(ag, alpha);
+    rb = _mm_mullo_epi16(rb, alpha);
+    ag = _mm_add_epi16(ag, _mm_srli_epi16(ag, 8));
+    rb = _mm_add_epi16(rb, _mm_srli_epi16(rb, 8));
+    ag = _mm_andnot_si128(colorMask, _mm_add_epi16(ag, half));
+    rb = _mm_srli_epi16(_mm_add_epi16(rb, half), 8);
+    return _mm_or_si128(ag, rb);
+}
+#elif defined(QSG_SOFTWARE_BLITTER_NEON)
+// One channel of eight pixels
+static inline uint8x8_t byteMul(uint8x8_t x, uint8x8_t a)
+{
+    const uint16x8_t t = vmull_u8(x, a);
+    return vraddhn_u16(t, vshrq_n_u16(t, 8));
+}
+#endif
+
+static void fillRow(quint32 *dst, int count, quint32 color)
+{
+    int x = 0;
+#if defined(QSG_SOFTWARE_BLITTER_SSE2)
+    const __m128i c = _mm_set1_epi32(int(color));
+    for (; x + 4 <= count; x += 4)
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), c);
+#elif defined(QSG_SOFTWARE_BLITTER_NEON)
+    const uint32x4_t c = vdupq_n_u32(color);
+    for (; x + 4 <= count; x += 4)
+        vst1q_u32(dst + x, c);
+#endif
+    for (; x < count; ++x)
+        dst[x] = color;
+}
+
+static void blendColorRow(quint32 *dst, int count, quint32 color)
+{
+    const quint32 inverseAlpha = 255 - (color >> 24);
+    int x = 0;
+#if defined(QSG_SOFTWARE_BLITTER_SSE2)
+    const __m128i c = _mm_set1_epi32(int(color));
+    const __m128i a = _mm_set1_epi16(short(inverseAlpha));
+    for (; x + 4 <= count; x += 4) {
+        __m128i *d = reinterpret_cast<__m128i *>(dst + x);
+        _mm_storeu_si128(d, _mm_add_epi8(c, byteMul(_mm_loadu_si128(d), a)));
+    }
+#elif defined(QSG_SOFTWARE_BLITTER_NEON)
+    const uint8x8_t a = vdup_n_u8(uint8_t(inverseAlpha));
+    uint8x8_t c[4];
+    for (int i = 0; i < 4; ++i)
+        c[i] = vdup_n_u8(uint8_t(color >> (8 * i)));
+    for (; x + 8 <= count; x += 8) {
+        uint8_t *p = reinterpret_cast<uint8_t *>(dst + x);
+        uint8x8x4_t d = vld4_u8(p);
+        for (int i = 0; i < 4; ++i)
+            d.val[i] = vadd_u8(c[i], byteMul(d.val[i], a));
+        vst4_u8(p, d);
+    }
+#endif
+    for (; x < count; ++x)
+        dst[x] = color + byteMul(dst[x], inverseAlpha);
+}
+
+static void blendRow(quint32 *dst, const quint32 *src, int count)
+{
+    int x = 0;
+#if defined(QSG_SOFTWARE_BLITTER_SSE2)
+    const __m128i alphaMask = _mm_set1_epi32(int(0xff000000));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi16(0xff);
+    for (; x + 4 <= count; x += 4) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(s, zero)) == 0xffff)
+            continue;
+        __m128i *d = reinterpret_cast<__m128i *>(dst + x);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(s, alphaMask), alphaMask)) == 0xffff) {
+            _mm_storeu_si128(d, s);
+            continue;
+        }
+        __m128i alpha = _mm_srli_epi32(s, 24);
+        alpha = _mm_sub_epi16(max, _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16)));
+        _mm_storeu_si128(d, _mm_add_epi8(s, byteMul(_mm_loadu_si128(d), alpha)));
+    }
+#elif defined(QSG_SOFTWARE_BLITTER_NEON)
+    for (; x + 8 <= count; x += 8) {
+        const uint8x8x4_t s = vld4_u8(reinterpret_cast<const uint8_t *>(src + x));
+        uint8_t *p = reinterpret_cast<uint8_t *>(dst + x);
+        uint8x8x4_t d = vld4_u8(p);
+        const uint8x8_t inverseAlpha = vmvn_u8(s.val[3]);
+        for (int i = 0; i < 4; ++i)
+            d.val[i] = vadd_u8(s.val[i], byteMul(d.val[i], inverseAlpha));
+        vst4_u8(p, d);
+    }
+#endif
+    for (; x < count; ++x) {
+        const quint32 s = src[x];
+        if (s >= 0xff000000)
+            dst[x] = s;
+        else if (s != 0)
+            dst[x] = s + byteMul(dst[x], 255 - (s >> 24));
+    }
+}
+
+static inline bool isWhole(qreal value)
+{
+    return qAbs(value - qRound(value)) < qreal(0.001);
+}
+
+bool isSupportedFormat(QImage::Format format)
+{
+    return format == QImage::Format_RGB32 || format == QImage::Format_ARGB32_Premultiplied;
+}
+
+bool isPixelAligned(const QTransform &transform)
+{
+    return transform.type() <= QTransform::TxScale
+            && transform.m11() > 0 && transform.m22() > 0
+            && isWhole(transform.m11()) && isWhole(transform.m22())
+            && isWhole(transform.dx()) && isWhole(transform.dy());
+}
+
+bool mapToPixels(const QTransform &transform, const QRectF &rect, QRect *pixelRect)
+{
+    const QRectF mapped = transform.mapRect(rect);
+    if (!isWhole(mapped.left()) || !isWhole(mapped.top())
+        || !isWhole(mapped.right()) || !isWhole(mapped.bottom())) {
+        return false;
+    }
+    const int left = qRound(mapped.left());
+    const int top = qRound(mapped.top());
+    *pixelRect = QRect(left, top, qRound(mapped.right()) - left, qRound(mapped.bottom()) - top);
+    return true;
+}
+
+void fillRect(QImage *image, const QRect &rect, QRgb premultipliedColor, bool blend,
+              const QRect &clip)
+{
+    Q_ASSERT(isSupportedFormat(image->format()));
+
+    const QRect area = rect & clip & image->rect();
+    if (area.isEmpty() || (blend && qAlpha(premultipliedColor) == 0))
+        return;
+    if (blend && qAlpha(premultipliedColor) == 255)
+        blend = false;
+
+    uchar *bits = image->bits();
+    const qsizetype bytesPerLine = image->bytesPerLine();
+    for (int y = area.top(); y <= area.bottom(); ++y) {
+        quint32 *dst = reinterpret_cast<quint32 *>(bits + y * bytesPerLine) + area.left();
+        if (blend)
+            blendColorRow(dst, area.width(), premultipliedColor);
+        else
+            fillRow(dst, area.width(), premultipliedColor);
+    }
+}
+
+void drawImage(QImage *image, const QRect &targetRect, const QImage &source,
+               const QRect &sourceRect, bool blend, const QRect &clip)
+{
+    Q_ASSERT(isSupportedFormat(image->format()));
+    Q_ASSERT(isSupportedFormat(source.format()));
+    Q_ASSERT(source.rect().contains(sourceRect));
+    Q_ASSERT(targetRect.width() % sourceRect.width() == 0);
+    Q_ASSERT(targetRect.height() % sourceRect.height() == 0);
+
+    const QRect area = targetRect & clip & image->rect();
+    if (area.isEmpty())
+        return;
+
+    const int scaleX = targetRect.width() / sourceRect.width();
+    const int scaleY = targetRect.height() / sourceRect.height();
+    const int width = area.width();
+    uchar *bits = image->bits();
+    const qsizetype bytesPerLine = image->bytesPerLine();
+
+    // Scaled source rows are built once and reused for all rows they cover
+    QVarLengthArray<quint32, 1024> scaledRow;
+    if (scaleX > 1)
+        scaledRow.resize(width);
+    int scaledSourceY = -1;
+
+    for (int y = area.top(); y <= area.bottom(); ++y) {
+        const int sourceY = sourceRect.top() + (y - targetRect.top()) / scaleY;
+        const quint32 *sourceLine = reinterpret_cast<const quint32 *>(source.constScanLine(sourceY));
+        const quint32 *src;
+        if (scaleX == 1) {
+            src = sourceLine + sourceRect.left() + (area.left() - targetRect.left());
+        } else {
+            if (sourceY != scaledSourceY) {
+                for (int x = 0; x < width; ++x) {
+                    scaledRow[x] = sourceLine[sourceRect.left()
+                                              + (area.left() + x - targetRect.left()) / scaleX];
+                }
+                scaledSourceY = sourceY;
+            }
+            src = scaledRow.constData();
+        }
+
+        quint32 *dst = reinterpret_cast<quint32 *>(bits + y * bytesPerLine) + area.left();
+        if (blend)
+            blendRow(dst, src, width);
+        else
+            std::memcpy(dst, src, width * sizeof(quint32));
+    }
+}
+
+} // namespace QSGSoftwareBlitter
+
+QT_END_NAMESPACE
@@ -0,0 +1,54 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSGSOFTWAREBLITTER_H
+#define QSGSOFTWAREBLITTER_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick/private/qtquickglobal_p.h>
+
+#include <QtGui/QImage>
+#include <QtCore/QRect>
+
+QT_BEGIN_NAMESPACE
+
+class QTransform;
+
+// Fills and image copies for the cases where a node is drawn axis-aligned and
+// on whole pixels, writing directly into the image QPainter would paint on.
+// The results are the same as QPainter's with the default
+// CompositionMode_SourceOver (blend) or CompositionMode_Source. All rects are
+// in the pixels of the destination image, nothing outside clip is touched.
+namespace QSGSoftwareBlitter {
+
+// QImage::Format_RGB32 or QImage::Format_ARGB32_Premultiplied
+Q_QUICK_EXPORT bool isSupportedFormat(QImage::Format format);
+// Only translation by whole pixels and scaling by whole numbers
+Q_QUICK_EXPORT bool isPixelAligned(const QTransform &transform);
+// Returns false if rect doesn't map to whole pixels
+Q_QUICK_EXPORT bool mapToPixels(const QTransform &transform, const QRectF &rect,
+                                QRect *pixelRect);
+
+Q_QUICK_EXPORT void fillRect(QImage *image, const QRect &rect, QRgb premultipliedColor, bool blend,
+                             const QRect &clip);
+// targetRect has to be the size of sourceRect, multiplied by whole numbers.
+// The source pixels are repeated like QPainter does without
+// QPainter::SmoothPixmapTransform.
+Q_QUICK_EXPORT void drawImage(QImage *image, const QRect &targetRect, const QImage &source,
+                              const QRect &sourceRect, bool blend, const QRect &clip);
+
+} // namespace QSGSoftwareBlitter
+
+QT_END_NAMESPACE
+
+#endif // QSGSOFTWAREBLITTER_H
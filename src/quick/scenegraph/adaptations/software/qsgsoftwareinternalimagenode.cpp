@@ -451,6 +451,29 @@ void QSGSoftwareInternalImageNode::paint(QPainter *painter)
     }
 }
 
+QImage QSGSoftwareInternalImageNode::image(QRectF *sourceRect, QMargins *margins, bool *smooth) const
+{
+    if (m_tileHorizontal || m_tileVertical)
+        return QImage();
+
+    const QPixmap &pm = m_mirrorHorizontally || m_mirrorVertically || m_textureIsLayer ? m_cachedMirroredPixmap : pixmap();
+    if (m_innerTargetRect != m_targetRect) {
+        if (getTileRule(m_subSourceRect.width()) != Qt::StretchTile
+            || getTileRule(m_subSourceRect.height()) != Qt::StretchTile) {
+            return QImage();
+        }
+        // same as in paint()
+        *margins = QMargins(m_innerTargetRect.left() - m_targetRect.left(), m_innerTargetRect.top() - m_targetRect.top(),
+                            m_targetRect.right() - m_innerTargetRect.right(), m_targetRect.bottom() - m_innerTargetRect.bottom());
+        *sourceRect = QRectF(0, 0, pm.width(), pm.height());
+    } else {
+        *margins = QMargins();
+        *sourceRect = QRectF(m_subSourceRect.left() * pm.width(), m_subSourceRect.top() * pm.height(),
+                             m_subSourceRect.width() * pm.width(), m_subSourceRect.height() * pm.height());
+    }
+    *smooth = m_smooth;
+    return pm.toImage();
+}
 
 QRectF QSGSoftwareInternalImageNode::rect() const
 {
@@ -91,6 +91,9 @@ public:
     QRectF rect() const;
 
     const QPixmap &pixmap() const;
+    // What paint() draws to rect() and from where, if it draws the image once
+    // or as a stretched border image with margins. Otherwise returns a null image.
+    QImage image(QRectF *sourceRect, QMargins *margins, bool *smooth) const;
 private:
 
     QRectF m_targetRect;
@@ -238,14 +238,19 @@ void QSGSoftwareInternalRectangleNode::update()
     }
 }
 
+void QSGSoftwareInternalRectangleNode::updateDevicePixelRatio(qreal devicePixelRatio)
+{
+    if (!qFuzzyCompare(devicePixelRatio, m_devicePixelRatio)) {
+        m_devicePixelRatio = devicePixelRatio;
+        generateCornerPixmap();
+    }
+}
+
 void QSGSoftwareInternalRectangleNode::paint(QPainter *painter)
 {
     //We can only check for a device pixel ratio change when we know what
     //paint device is being used.
-    if (!qFuzzyCompare(painter->device()->devicePixelRatio(), m_devicePixelRatio)) {
-        m_devicePixelRatio = painter->device()->devicePixelRatio();
-        generateCornerPixmap();
-    }
+    updateDevicePixelRatio(painter->device()->devicePixelRatio());
 
     if (painter->transform().isRotating()) {
         //Rotated rectangles lose the benefits of direct rendering, and have poor rendering
@@ -310,6 +315,17 @@ void QSGSoftwareInternalRectangleNode::paint(QPainter *painter)
 
 }
 
+bool QSGSoftwareInternalRectangleNode::isPlainColor() const
+{
+    return m_penWidth <= 0
+            && m_stops.isEmpty()
+            && m_radius <= 0
+            && m_topLeftRadius < 0
+            && m_topRightRadius < 0
+            && m_bottomLeftRadius < 0
+            && m_bottomRightRadius < 0;
+}
+
 bool QSGSoftwareInternalRectangleNode::isOpaque() const
 {
     if (m_radius > 0.0f)
@@ -45,9 +45,13 @@ public:
     void update() override;
 
     void paint(QPainter *);
+    void updateDevicePixelRatio(qreal devicePixelRatio);
 
     bool isOpaque() const;
     QRectF rect() const;
+    // No border, gradient or rounded corners
+    bool isPlainColor() const;
+    QColor color() const { return m_color; }
 private:
     void paintRectangle(QPainter *painter, const QRect &rect);
     void paintRectangleIndividualCorners(QPainter *painter, const QRect &rect);
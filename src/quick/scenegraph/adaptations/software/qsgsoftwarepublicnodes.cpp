@@ -60,8 +60,7 @@ void QSGSoftwareImageNode::setTextureCoordinatesTransform(QSGImageNode::TextureC
 
 void QSGSoftwareImageNode::paint(QPainter *painter)
 {
-    if (m_cachedMirroredPixmapIsDirty)
-        updateCachedMirroredPixmap();
+    preparePaint();
 
     painter->setRenderHint(QPainter::SmoothPixmapTransform, (m_filtering == QSGTexture::Linear));
     // Disable antialiased clipping. It causes transformed tiles to have gaps.
@@ -81,6 +80,22 @@ void QSGSoftwareImageNode::paint(QPainter *painter)
     }
 }
 
+QImage QSGSoftwareImageNode::image() const
+{
+    if (m_cachedMirroredPixmapIsDirty)
+        return QImage();
+
+    if (!m_cachedPixmap.isNull())
+        return m_cachedPixmap.toImage();
+    if (QSGSoftwarePixmapTexture *pt = qobject_cast<QSGSoftwarePixmapTexture *>(m_texture))
+        return pt->pixmap().toImage();
+    if (QSGSoftwareLayer *pt = qobject_cast<QSGSoftwareLayer *>(m_texture))
+        return pt->pixmap().toImage();
+    if (QSGPlainTexture *pt = qobject_cast<QSGPlainTexture *>(m_texture))
+        return pt->image();
+    return QImage();
+}
+
 void QSGSoftwareImageNode::updateCachedMirroredPixmap()
 {
     if (m_transformMode == NoTransform) {
@@ -72,6 +72,13 @@ public:
     bool ownsTexture() const override { return m_owns; }
 
     void paint(QPainter *painter);
+    void preparePaint()
+    {
+        if (m_cachedMirroredPixmapIsDirty)
+            updateCachedMirroredPixmap();
+    }
+    // What paint() draws, null before preparePaint() or if not available as QImage
+    QImage image() const;
 
 private:
     void updateCachedMirroredPixmap();
@@ -100,6 +107,8 @@ public:
     void paint(QPainter *painter);
 
     QRectF bounds() const;
+    const QPixmap &pixmap() const { return m_pixmap; }
+    QMargins padding() const { return m_margins; }
 
     bool isOpaque() const { return !m_pixmap.hasAlphaChannel(); }
 
@@ -3,6 +3,7 @@
 
 #include "qsgsoftwarerenderablenode_p.h"
 
+#include "qsgsoftwareblitter_p.h"
 #include "qsgsoftwareinternalimagenode_p.h"
 #include "qsgsoftwareinternalrectanglenode_p.h"
 #include "qsgsoftwareglyphnode_p.h"
@@ -17,6 +18,9 @@
 #include <qsgsimpletexturenode.h>
 #include <private/qsgrendernode_p.h>
 #include <private/qsgplaintexture_p.h>
+#include <private/qqmlglobal_p.h>
+
+#include <QtCore/QVarLengthArray>
 
 #include <qmath.h>
 
@@ -24,6 +28,8 @@ Q_LOGGING_CATEGORY(lcRenderable, "qt.scenegraph.softwarecontext.renderable")
 
 QT_BEGIN_NAMESPACE
 
+DEFINE_BOOL_CONFIG_OPTION(qsgSoftwareDisableBlit, QSG_SOFTWARE_DISABLE_BLIT)
+
 // Largest subrectangle with integer coordinates
 inline QRect toRectMin(const QRectF & r)
 {
@@ -83,6 +89,9 @@ QSGSoftwareRenderableNode::QSGSoftwareRenderableNode(NodeType type, QSGNode *nod
     case QSGSoftwareRenderableNode::RenderNode:
         m_handle.renderNode = static_cast<QSGRenderNode*>(node);
         break;
+    case QSGSoftwareRenderableNode::CachedLayer:
+        m_handle.node = node;
+        break;
     case QSGSoftwareRenderableNode::Invalid:
         m_handle.simpleRectNode = nullptr;
         break;
@@ -96,9 +105,12 @@ QSGSoftwareRenderableNode::~QSGSoftwareRenderableNode()
 
 void QSGSoftwareRenderableNode::update()
 {
+    Q_ASSERT(m_nodeType != CachedLayer);
+
     // Update the Node properties
     m_isDirty = true;
     m_isOpaque = false;
+    m_unchangedFrames = 0;
 
     QRectF boundingRect;
 
@@ -213,11 +225,9 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
 
     // Check for don't paint conditions
     if (m_nodeType != RenderNode) {
-        if (!m_isDirty || qFuzzyIsNull(m_opacity) || m_dirtyRegion.isEmpty()) {
-            m_isDirty = false;
-            m_dirtyRegion = QRegion();
-            return QRegion();
-        }
+        if (needsPaint())
+            paint(painter, m_dirtyRegion, forceOpaquePainting);
+        return finishPaint();
     } else {
         if (!m_isDirty || qFuzzyIsNull(m_opacity)) {
             m_isDirty = false;
@@ -249,13 +259,47 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
             return br;
         }
     }
+}
+
+// True when renderNode() would paint something. Not used for render nodes.
+bool QSGSoftwareRenderableNode::needsPaint() const
+{
+    Q_ASSERT(m_nodeType != RenderNode);
+    return m_isDirty && !qFuzzyIsNull(m_opacity) && !m_dirtyRegion.isEmpty();
+}
+
+// Updates state that the node would otherwise update lazily while painting,
+// so that paint() can be called from several threads at once.
+void QSGSoftwareRenderableNode::preparePaint(qreal devicePixelRatio)
+{
+    switch (m_nodeType) {
+    case QSGSoftwareRenderableNode::Rectangle:
+        m_handle.rectangleNode->updateDevicePixelRatio(devicePixelRatio);
+        break;
+    case QSGSoftwareRenderableNode::SimpleImage:
+        static_cast<QSGSoftwareImageNode *>(m_handle.simpleImageNode)->preparePaint();
+        break;
+    default:
+        break;
+    }
+}
+
+// Paints the part of the node inside clipRegion (in world coordinates). The
+// node's dirty state is left alone, see finishPaint().
+void QSGSoftwareRenderableNode::paint(QPainter *painter, const QRegion &clipRegion,
+                                      bool forceOpaquePainting) const
+{
+    Q_ASSERT(m_nodeType != RenderNode);
+
+    if (blit(painter, clipRegion, forceOpaquePainting))
+        return;
 
     painter->save();
     painter->setOpacity(m_opacity);
 
     // Set clipRegion to m_dirtyRegion (in world coordinates, so must be done before the setTransform below)
     // as m_dirtyRegion already accounts for clipRegion
-    painter->setClipRegion(m_dirtyRegion, Qt::ReplaceClip);
+    painter->setClipRegion(clipRegion, Qt::ReplaceClip);
     if (m_clipRegion.rectCount() > 1)
         painter->setClipRegion(m_clipRegion, Qt::IntersectClip);
 
@@ -305,14 +349,231 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
         static_cast<QSGSoftwareSpriteNode *>(m_handle.spriteNode)->paint(painter);
         break;
 #endif
+    case QSGSoftwareRenderableNode::CachedLayer:
+        painter->drawImage(m_boundingRectMax.topLeft(), m_layerImage);
+        break;
     default:
         break;
     }
 
     painter->restore();
+}
+
+using ClipRects = QVarLengthArray<QRect, 16>;
+
+static bool blitFill(QImage *image, const QTransform &transform, const QRectF &rect,
+                     const QColor &color, bool blend, const ClipRects &clipRects)
+{
+    const QRgb premultipliedColor = qPremultiply(color.rgba());
+    // QPainter keeps an opaque image opaque
+    if (!blend && image->format() == QImage::Format_RGB32 && qAlpha(premultipliedColor) != 255)
+        return false;
+    QRect targetRect;
+    if (!QSGSoftwareBlitter::mapToPixels(transform, rect, &targetRect))
+        return false;
+
+    for (const QRect &clip : clipRects)
+        QSGSoftwareBlitter::fillRect(image, targetRect, premultipliedColor, blend, clip);
+    return true;
+}
+
+static bool blitImage(QImage *image, const QTransform &transform, const QRectF &rect,
+                      const QImage &source, const QRectF &sourceRect, bool smooth, bool blend,
+                      const ClipRects &clipRects)
+{
+    if (source.isNull() || !QSGSoftwareBlitter::isSupportedFormat(source.format()))
+        return false;
+    if (!blend && image->format() == QImage::Format_RGB32 && source.format() != QImage::Format_RGB32)
+        return false;
+    QRect targetRect;
+    QRect sourcePixels;
+    if (!QSGSoftwareBlitter::mapToPixels(transform, rect, &targetRect)
+        || !QSGSoftwareBlitter::mapToPixels(QTransform(), sourceRect, &sourcePixels)) {
+        return false;
+    }
+    if (sourcePixels.isEmpty() || !source.rect().contains(sourcePixels))
+        return false;
+    // Only scaling by whole numbers, where not smoothing repeats pixels
+    if (targetRect.width() % sourcePixels.width() != 0
+        || targetRect.height() % sourcePixels.height() != 0
+        || (smooth && targetRect.size() != sourcePixels.size())) {
+        return false;
+    }
+
+    for (const QRect &clip : clipRects)
+        QSGSoftwareBlitter::drawImage(image, targetRect, source, sourcePixels, blend, clip);
+    return true;
+}
+
+// Same as QSGSoftwareHelpers::qDrawBorderPixmap() with Qt::StretchTile and the
+// same margins for source and target, for when every one of the nine parts is
+// scaled by whole numbers
+static bool blitNinePatch(QImage *image, const QTransform &transform, const QRect &rect,
+                          const QImage &source, const QMargins &margins, bool smooth, bool blend,
+                          const ClipRects &clipRects)
+{
+    if (source.isNull() || !QSGSoftwareBlitter::isSupportedFormat(source.format())
+        || !qFuzzyCompare(source.devicePixelRatio(), qreal(1))) {
+        return false;
+    }
+    if (!blend && image->format() == QImage::Format_RGB32 && source.format() != QImage::Format_RGB32)
+        return false;
+    if (margins.left() < 0 || margins.top() < 0 || margins.right() < 0 || margins.bottom() < 0
+        || margins.left() + margins.right() > qMin(rect.width(), source.width())
+        || margins.top() + margins.bottom() > qMin(rect.height(), source.height())) {
+        return false;
+    }
 
-    QRegion areaToBeFlushed = m_dirtyRegion;
-    m_previousDirtyRegion = QRegion(m_boundingRectMax);
+    QRect outer;
+    QRect inner;
+    if (!QSGSoftwareBlitter::mapToPixels(transform, rect, &outer)
+        || !QSGSoftwareBlitter::mapToPixels(transform, rect.marginsRemoved(margins), &inner)) {
+        return false;
+    }
+    const int targetX[] = { outer.left(), inner.left(), inner.left() + inner.width(),
+                            outer.left() + outer.width() };
+    const int targetY[] = { outer.top(), inner.top(), inner.top() + inner.height(),
+                            outer.top() + outer.height() };
+    const int sourceX[] = { 0, margins.left(), source.width() - margins.right(), source.width() };
+    const int sourceY[] = { 0, margins.top(), source.height() - margins.bottom(), source.height() };
+
+    auto isScaledByWholeNumber = [smooth](const int *targetEdges, const int *sourceEdges, int i) {
+        const int targetSize = targetEdges[i + 1] - targetEdges[i];
+        const int sourceSize = sourceEdges[i + 1] - sourceEdges[i];
+        if (targetSize == 0)
+            return true;
+        return sourceSize > 0 && targetSize % sourceSize == 0
+                && (!smooth || targetSize == sourceSize);
+    };
+    for (int i = 0; i < 3; ++i) {
+        if (!isScaledByWholeNumber(targetX, sourceX, i) || !isScaledByWholeNumber(targetY, sourceY, i))
+            return false;
+    }
+
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            const QRect targetRect(QPoint(targetX[column], targetY[row]),
+                                   QPoint(targetX[column + 1] - 1, targetY[row + 1] - 1));
+            if (targetRect.isEmpty())
+                continue;
+            const QRect sourceRect(QPoint(sourceX[column], sourceY[row]),
+                                   QPoint(sourceX[column + 1] - 1, sourceY[row + 1] - 1));
+            for (const QRect &clip : clipRects)
+                QSGSoftwareBlitter::drawImage(image, targetRect, source, sourceRect, blend, clip);
+        }
+    }
+    return true;
+}
+
+/*
+    Paints the node directly into the image the painter paints on when it is
+    axis-aligned and on whole pixels, which saves setting up the painter and
+    going through its generic code paths for the most common nodes. Returns
+    false when the node has to be painted with QPainter.
+*/
+bool QSGSoftwareRenderableNode::blit(QPainter *painter, const QRegion &clipRegion,
+                                     bool forceOpaquePainting) const
+{
+    if (qsgSoftwareDisableBlit() || m_opacity < 1.0f || m_clipRegion.rectCount() > 1)
+        return false;
+
+    QPaintDevice *device = painter->device();
+    if (device->devType() != QInternal::Image || painter->hasClipping()
+        || painter->compositionMode() != QPainter::CompositionMode_SourceOver
+        || !painter->worldTransform().isIdentity()) {
+        return false;
+    }
+    QImage *image = static_cast<QImage *>(device);
+    if (!QSGSoftwareBlitter::isSupportedFormat(image->format()))
+        return false;
+    // From the world coordinates of clipRegion to pixels in image
+    const QTransform deviceTransform = painter->combinedTransform();
+    if (!QSGSoftwareBlitter::isPixelAligned(deviceTransform))
+        return false;
+    const QTransform transform = m_transform * deviceTransform;
+    if (transform.type() > QTransform::TxScale || transform.m11() <= 0 || transform.m22() <= 0)
+        return false;
+
+    ClipRects clipRects;
+    for (const QRect &rect : clipRegion)
+        clipRects.append(deviceTransform.mapRect(rect));
+
+    const bool blend = !forceOpaquePainting && !m_isOpaque;
+    const bool smooth = painter->testRenderHint(QPainter::SmoothPixmapTransform);
+
+    switch (m_nodeType) {
+    case QSGSoftwareRenderableNode::SimpleRect:
+        return blitFill(image, transform, m_handle.simpleRectNode->rect(),
+                        m_handle.simpleRectNode->color(), blend, clipRects);
+    case QSGSoftwareRenderableNode::SimpleRectangle:
+        return blitFill(image, transform, m_handle.simpleRectangleNode->rect(),
+                        m_handle.simpleRectangleNode->color(), blend, clipRects);
+    case QSGSoftwareRenderableNode::Rectangle:
+        if (!m_handle.rectangleNode->isPlainColor())
+            return false;
+        return blitFill(image, transform, m_handle.rectangleNode->rect(),
+                        m_handle.rectangleNode->color(), blend, clipRects);
+    case QSGSoftwareRenderableNode::SimpleTexture:
+    {
+        QSGTexture *texture = m_handle.simpleTextureNode->texture();
+        QImage source;
+        if (QSGSoftwarePixmapTexture *pt = qobject_cast<QSGSoftwarePixmapTexture *>(texture))
+            source = pt->pixmap().toImage();
+        else if (QSGPlainTexture *pt = qobject_cast<QSGPlainTexture *>(texture))
+            source = pt->image();
+        return blitImage(image, transform, m_handle.simpleTextureNode->rect(), source,
+                         m_handle.simpleTextureNode->sourceRect(), smooth, blend, clipRects);
+    }
+    case QSGSoftwareRenderableNode::SimpleImage:
+    {
+        auto imageNode = static_cast<QSGSoftwareImageNode *>(m_handle.simpleImageNode);
+        return blitImage(image, transform, imageNode->rect(), imageNode->image(),
+                         imageNode->sourceRect(), imageNode->filtering() == QSGTexture::Linear,
+                         blend, clipRects);
+    }
+    case QSGSoftwareRenderableNode::Image:
+    {
+        QRectF sourceRect;
+        QMargins margins;
+        bool imageSmooth = false;
+        const QImage source = m_handle.imageNode->image(&sourceRect, &margins, &imageSmooth);
+        if (!margins.isNull()) {
+            return blitNinePatch(image, transform, m_handle.imageNode->rect().toRect(), source,
+                                 margins, imageSmooth, blend, clipRects);
+        }
+        return blitImage(image, transform, m_handle.imageNode->rect(), source, sourceRect,
+                         imageSmooth, blend, clipRects);
+    }
+    case QSGSoftwareRenderableNode::NinePatch:
+    {
+        const QMargins margins = m_handle.ninePatchNode->padding();
+        if (margins.isNull()) {
+            const QPixmap &pixmap = m_handle.ninePatchNode->pixmap();
+            return blitImage(image, transform, m_handle.ninePatchNode->bounds(), pixmap.toImage(),
+                             QRectF(pixmap.rect()), smooth, blend, clipRects);
+        }
+        return blitNinePatch(image, transform, m_handle.ninePatchNode->bounds().toRect(),
+                             m_handle.ninePatchNode->pixmap().toImage(), margins, smooth, blend,
+                             clipRects);
+    }
+    case QSGSoftwareRenderableNode::CachedLayer:
+        return blitImage(image, transform, QRectF(m_boundingRectMax), m_layerImage,
+                         QRectF(m_layerImage.rect()), false, blend, clipRects);
+    default:
+        return false;
+    }
+}
+
+// Marks the node as painted and returns the area to be flushed.
+QRegion QSGSoftwareRenderableNode::finishPaint()
+{
+    Q_ASSERT(m_nodeType != RenderNode);
+
+    QRegion areaToBeFlushed;
+    if (needsPaint()) {
+        areaToBeFlushed = m_dirtyRegion;
+        m_previousDirtyRegion = QRegion(m_boundingRectMax);
+    }
     m_isDirty = false;
     m_dirtyRegion = QRegion();
 
@@ -361,6 +622,21 @@ void QSGSoftwareRenderableNode::markMaterialDirty()
     update();
 }
 
+// A cached layer stands in for the nodes it was painted from, which are
+// already on screen, so it starts out clean.
+void QSGSoftwareRenderableNode::setLayerImage(const QImage &image, const QRect &rect)
+{
+    Q_ASSERT(m_nodeType == CachedLayer);
+
+    m_layerImage = image;
+    m_isOpaque = false;
+    m_boundingRectMin = QRect();
+    m_boundingRectMax = rect;
+    m_isDirty = false;
+    m_dirtyRegion = QRegion();
+    m_previousDirtyRegion = QRegion(rect);
+}
+
 void QSGSoftwareRenderableNode::addDirtyRegion(const QRegion &dirtyRegion, bool forceDirty)
 {
     // Check if the dirty region applies to this node
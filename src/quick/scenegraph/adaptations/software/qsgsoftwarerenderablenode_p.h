@@ -17,6 +17,7 @@
 
 #include <QtQuick/private/qtquickglobal_p.h>
 
+#include <QtGui/QImage>
 #include <QtGui/QRegion>
 #include <QtCore/QRect>
 #include <QtGui/QTransform>
@@ -24,6 +25,8 @@
 #include <QtQuick/qsgimagenode.h>
 #include <QtQuick/qsgninepatchnode.h>
 
+#include <limits>
+
 QT_BEGIN_NAMESPACE
 
 class QSGSimpleRectNode;
@@ -53,7 +56,8 @@ public:
 #if QT_CONFIG(quick_sprite)
         SpriteNode,
 #endif
-        RenderNode
+        RenderNode,
+        CachedLayer
     };
 
     QSGSoftwareRenderableNode(NodeType type, QSGNode *node);
@@ -62,6 +66,11 @@ public:
     void update();
 
     QRegion renderNode(QPainter *painter, bool forceOpaquePainting = false);
+    // renderNode() in steps, for painting the node in parts
+    bool needsPaint() const;
+    void preparePaint(qreal devicePixelRatio);
+    void paint(QPainter *painter, const QRegion &clipRegion, bool forceOpaquePainting) const;
+    QRegion finishPaint();
     QRect boundingRectMin() const { return m_boundingRectMin; }
     QRect boundingRectMax() const { return m_boundingRectMax; }
     NodeType type() const { return m_nodeType; }
@@ -80,6 +89,17 @@ public:
     void markGeometryDirty();
     void markMaterialDirty();
 
+    // Frames the node has been in the render list without an update()
+    int unchangedFrames() const { return m_unchangedFrames; }
+    void countUnchangedFrame()
+    {
+        if (m_unchangedFrames < std::numeric_limits<int>::max())
+            ++m_unchangedFrames;
+    }
+
+    // Only for CachedLayer nodes, image covers rect in world coordinates
+    void setLayerImage(const QImage &image, const QRect &rect);
+
     void addDirtyRegion(const QRegion &dirtyRegion, bool forceDirty = true);
     void subtractDirtyRegion(const QRegion &dirtyRegion);
 
@@ -87,6 +107,8 @@ public:
     QRegion dirtyRegion() const;
 
 private:
+    bool blit(QPainter *painter, const QRegion &clipRegion, bool forceOpaquePainting) const;
+
     union RenderableNodeHandle {
         QSGNode *node;
         QSGSimpleRectNode *simpleRectNode;
@@ -118,6 +140,9 @@ private:
 
     QRect m_boundingRectMin;
     QRect m_boundingRectMax;
+
+    int m_unchangedFrames = 0;
+    QImage m_layerImage;
 };
 
 QT_END_NAMESPACE
@@ -21,6 +21,10 @@ QSGSoftwareRenderer::QSGSoftwareRenderer(QSGRenderContext *context)
     , m_paintDevice(nullptr)
     , m_backingStore(nullptr)
 {
+    // In megabytes. Not done by the pixmap renderer, which may scale the scene.
+    const int layerCacheSize = qEnvironmentVariableIntValue("QSG_SOFTWARE_LAYER_CACHE_SIZE");
+    if (layerCacheSize > 0)
+        setLayerCacheSize(qsizetype(layerCacheSize) * 1024 * 1024);
 }
 
 QSGSoftwareRenderer::~QSGSoftwareRenderer()
@@ -16,6 +16,8 @@
 #include <QtQuick/qsgsimpletexturenode.h>
 #include <QtQuick/qsgrendernode.h>
 
+#include <limits>
+
 QT_BEGIN_NAMESPACE
 
 QSGSoftwareRenderListBuilder::QSGSoftwareRenderListBuilder(QSGAbstractSoftwareRenderer *renderer)
@@ -24,13 +26,24 @@ QSGSoftwareRenderListBuilder::QSGSoftwareRenderListBuilder(QSGAbstractSoftwareRe
 
 }
 
-bool QSGSoftwareRenderListBuilder::visit(QSGTransformNode *)
+bool QSGSoftwareRenderListBuilder::visit(QSGTransformNode *node)
 {
+    m_subtreeStack.append({ node, m_nodeCount, 0, std::numeric_limits<int>::max(), false });
     return true;
 }
 
 void QSGSoftwareRenderListBuilder::endVisit(QSGTransformNode *)
 {
+    Subtree subtree = m_subtreeStack.takeLast();
+    subtree.end = m_nodeCount;
+    if (subtree.end - subtree.start > 1)
+        m_subtrees.append(subtree);
+
+    if (!m_subtreeStack.isEmpty()) {
+        Subtree &parent = m_subtreeStack.last();
+        parent.unchangedFrames = qMin(parent.unchangedFrames, subtree.unchangedFrames);
+        parent.hasRenderNode |= subtree.hasRenderNode;
+    }
 }
 
 bool QSGSoftwareRenderListBuilder::visit(QSGClipNode *)
@@ -134,6 +147,15 @@ bool QSGSoftwareRenderListBuilder::addRenderableNode(QSGNode *node)
         return false;
     }
     m_renderer->appendRenderableNode(renderableNode);
+    ++m_nodeCount;
+
+    renderableNode->countUnchangedFrame();
+    if (!m_subtreeStack.isEmpty()) {
+        Subtree &subtree = m_subtreeStack.last();
+        subtree.unchangedFrames = qMin(subtree.unchangedFrames, renderableNode->unchangedFrames());
+        if (renderableNode->type() == QSGSoftwareRenderableNode::RenderNode)
+            subtree.hasRenderNode = true;
+    }
     return true;
 }
 
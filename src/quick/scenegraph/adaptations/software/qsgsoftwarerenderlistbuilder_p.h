@@ -17,6 +17,8 @@
 
 #include <private/qsgadaptationlayer_p.h>
 
+#include <QtCore/QList>
+
 QT_BEGIN_NAMESPACE
 
 class QSGAbstractSoftwareRenderer;
@@ -24,6 +26,16 @@ class QSGAbstractSoftwareRenderer;
 class QSGSoftwareRenderListBuilder : public QSGNodeVisitorEx
 {
 public:
+    // A transform node with the [start, end) range of the renderable nodes
+    // appended by the builder that belong to it
+    struct Subtree {
+        QSGNode *root;
+        int start;
+        int end;
+        int unchangedFrames; // of the most recently changed node
+        bool hasRenderNode;
+    };
+
     QSGSoftwareRenderListBuilder(QSGAbstractSoftwareRenderer *renderer);
 
     bool visit(QSGTransformNode *) override;
@@ -51,10 +63,16 @@ public:
     bool visit(QSGRenderNode *) override;
     void endVisit(QSGRenderNode *) override;
 
+    // Subtrees with at least two renderable nodes, children before parents
+    const QList<Subtree> &subtrees() const { return m_subtrees; }
+
 private:
     bool addRenderableNode(QSGNode *node);
 
     QSGAbstractSoftwareRenderer *m_renderer;
+    int m_nodeCount = 0;
+    QList<Subtree> m_subtreeStack;
+    QList<Subtree> m_subtrees;
 };
 
 QT_END_NAMESPACE
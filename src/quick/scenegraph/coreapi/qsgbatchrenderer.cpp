@@ -8,10 +8,15 @@
 #include <qmath.h>
 
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QThreadPool>
 #include <QtCore/QtNumeric>
 
 #include <QtGui/QGuiApplication>
 
+#include <QtQuick/qsgflatcolormaterial.h>
+#include <QtQuick/qsgtexturematerial.h>
+#include <QtQuick/qsgvertexcolormaterial.h>
+
 #include <private/qnumeric_p.h>
 #include "qsgmaterialshader_p.h"
 
@@ -42,6 +47,7 @@ DECLARE_DEBUG_VAR(dump)
 DECLARE_DEBUG_VAR(noalpha)
 DECLARE_DEBUG_VAR(noopaque)
 DECLARE_DEBUG_VAR(noclip)
+DECLARE_DEBUG_VAR(noculling)
 #undef DECLARE_DEBUG_VAR
 
 #define QSGNODE_TRAVERSE(NODE) for (QSGNode *child = NODE->firstChild(); child; child = child->nextSibling())
@@ -81,6 +87,8 @@ static bool is2DSafe(const QMatrix4x4 &m) { return m.flags() < QMatrix4x4::Rotat
 const float OPAQUE_LIMIT                = 0.999f;
 
 const uint DYNAMIC_VERTEX_INDEX_BUFFER_THRESHOLD = 4;
+const int CONCURRENT_UPLOAD_CHUNK_VERTICES = 4096;
+const int MAX_OCCLUDERS = 8;
 const int VERTEX_BUFFER_BINDING = 0;
 const int ZORDER_BUFFER_BINDING = VERTEX_BUFFER_BINDING + 1;
 
@@ -713,19 +721,20 @@ BatchCompatibility Batch::isMaterialCompatible(Element *e) const
 }
 
 /*
- * Marks this batch as dirty or in the case where the geometry node has
- * changed to be incompatible with this batch, return false so that
- * the caller can mark the entire sg for a full rebuild...
+ * Marks the changed element of this batch as dirty or in the case where the
+ * geometry node has changed to be incompatible with this batch, return false
+ * so that the caller can mark the entire sg for a full rebuild...
  */
-bool Batch::geometryWasChanged(QSGGeometryNode *gn)
+bool Batch::geometryWasChanged(Element *changed)
 {
+    QSGGeometryNode *gn = changed->node;
     Element *e = first;
     Q_ASSERT_X(e, "Batch::geometryWasChanged", "Batch is expected to 'valid' at this time");
     // 'gn' is the first node in the batch, compare against the next one.
     while (e && (e->node == gn || e->removed))
         e = e->nextInBatch;
     if (!e || e->node->geometry()->attributes() == gn->geometry()->attributes()) {
-        needsUpload = true;
+        elementChanged(changed);
         return true;
     } else {
         return false;
@@ -890,10 +899,11 @@ Renderer::Renderer(QSGDefaultRenderContext *ctx, QSGRendererInterface::RenderMod
     m_batchNodeThreshold = qt_sg_envInt("QSG_RENDERER_BATCH_NODE_THRESHOLD", 64);
     m_batchVertexThreshold = qt_sg_envInt("QSG_RENDERER_BATCH_VERTEX_THRESHOLD", 1024);
     m_srbPoolThreshold = qt_sg_envInt("QSG_RENDERER_SRB_POOL_THRESHOLD", 1024);
+    m_uploadThreadCount = qt_sg_envInt("QSG_RENDERER_UPLOAD_THREADS", 0);
 
     if (Q_UNLIKELY(debug_build() || debug_render())) {
-        qDebug("Batch thresholds: nodes: %d vertices: %d Srb pool threshold: %d",
-               m_batchNodeThreshold, m_batchVertexThreshold, m_srbPoolThreshold);
+        qDebug("Batch thresholds: nodes: %d vertices: %d Srb pool threshold: %d Upload threads: %d",
+               m_batchNodeThreshold, m_batchVertexThreshold, m_srbPoolThreshold, m_uploadThreadCount);
     }
 }
 
@@ -1082,19 +1092,24 @@ void Renderer::unmap(Buffer *buffer, bool isIndexBuf)
         }
     }
     if (buffer->buf) {
-        if (buffer->buf->type() != QRhiBuffer::Dynamic) {
-            m_resourceUpdates->uploadStaticBuffer(buffer->buf,
-                                                 0, buffer->size, buffer->data);
+        uploadRange(buffer, 0, buffer->size, buffer->data);
+        if (buffer->buf->type() != QRhiBuffer::Dynamic)
             buffer->nonDynamicChangeCount += 1;
-        } else {
-            m_resourceUpdates->updateDynamicBuffer(buffer->buf, 0, buffer->size,
-                                                   buffer->data);
-        }
     }
     if (m_visualizer->mode() == Visualizer::VisualizeNothing)
         buffer->data = nullptr;
 }
 
+void Renderer::uploadRange(Buffer *buffer, quint32 offset, quint32 size, const char *data)
+{
+    Q_ASSERT(buffer->buf);
+    Q_ASSERT(offset + size <= buffer->size);
+    if (buffer->buf->type() != QRhiBuffer::Dynamic)
+        m_resourceUpdates->uploadStaticBuffer(buffer->buf, offset, size, data);
+    else
+        m_resourceUpdates->updateDynamicBuffer(buffer->buf, offset, size, data);
+}
+
 BatchRootInfo *Renderer::batchRootInfo(Node *node)
 {
     BatchRootInfo *info = node->rootInfo();
@@ -1181,7 +1196,7 @@ void Renderer::nodeWasTransformed(Node *node, int *vertexCount)
                 if (!e->batch->isOpaque) {
                     invalidateBatchAndOverlappingRenderOrders(e->batch);
                 } else if (e->batch->merged) {
-                    e->batch->needsUpload = true;
+                    e->batch->elementChanged(e);
                 }
             }
         }
@@ -1402,17 +1417,12 @@ void Renderer::nodeChanged(QSGNode *node, QSGNode::DirtyState state)
     }
 
     if (state & QSGNode::DirtyGeometry && node->type() == QSGNode::GeometryNodeType) {
-        QSGGeometryNode *gn = static_cast<QSGGeometryNode *>(node);
         Element *e = shadowNode->element();
         if (e) {
             e->boundsComputed = false;
-            Batch *b = e->batch;
-            if (b) {
-                if (!e->batch->geometryWasChanged(gn) || !e->batch->isOpaque) {
+            if (e->batch) {
+                if (!e->batch->geometryWasChanged(e) || !e->batch->isOpaque)
                     invalidateBatchAndOverlappingRenderOrders(e->batch);
-                } else {
-                    b->needsUpload = true;
-                }
             }
         }
     }
@@ -1878,6 +1888,185 @@ void Renderer::prepareAlphaBatches()
 
 }
 
+// x and y of a point with z = 0 don't depend on w
+static bool qsg_isAffine2D(const QMatrix4x4 &m)
+{
+    const float *d = m.constData();
+    return d[3] == 0 && d[7] == 0 && d[15] == 1;
+}
+
+// Materials that write every fragment they cover when drawn without blending
+static bool qsg_isKnownOpaqueMaterial(const QSGMaterial *material)
+{
+    static const QSGMaterialType *const types[] = {
+        QSGFlatColorMaterial().type(),
+        QSGVertexColorMaterial().type(),
+        QSGOpaqueTextureMaterial().type(),
+        QSGTextureMaterial().type()
+    };
+    return std::find(std::begin(types), std::end(types), material->type()) != std::end(types);
+}
+
+/* Returns true if g is a triangle strip of four vertices that fills exactly
+ * the axis aligned rectangle it spans, as generated for Rectangle and Image.
+ */
+static bool qsg_geometryIsRect(QSGGeometry *g, Rect *rect)
+{
+    if (g->vertexCount() != 4 || g->drawingMode() != QSGGeometry::DrawTriangleStrip)
+        return false;
+    const int offset = qsg_positionAttribute(g);
+    if (offset == -1)
+        return false;
+
+    uint indices[4] = { 0, 1, 2, 3 };
+    if (g->indexCount() == 4) {
+        for (int i = 0; i < 4; ++i) {
+            if (g->indexType() == QSGGeometry::UnsignedShortType)
+                indices[i] = g->indexDataAsUShort()[i];
+            else if (g->indexType() == QSGGeometry::UnsignedIntType)
+                indices[i] = g->indexDataAsUInt()[i];
+            else
+                return false;
+            if (indices[i] > 3)
+                return false;
+        }
+    } else if (g->indexCount() != 0) {
+        return false;
+    }
+
+    Pt p[4];
+    const char *vd = static_cast<const char *>(g->vertexData()) + offset;
+    rect->set(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (int i = 0; i < 4; ++i) {
+        p[i] = *reinterpret_cast<const Pt *>(vd + indices[i] * g->sizeOfVertex());
+        *rect |= p[i];
+    }
+    if (!(rect->tl.x < rect->br.x && rect->tl.y < rect->br.y))
+        return false;
+    for (int i = 0; i < 4; ++i) {
+        if ((p[i].x != rect->tl.x && p[i].x != rect->br.x)
+                || (p[i].y != rect->tl.y && p[i].y != rect->br.y))
+            return false;
+    }
+    // The triangles 0-1-2 and 1-2-3 cover the rectangle only if they share a diagonal
+    return p[1].x != p[2].x && p[1].y != p[2].y && p[0].x != p[3].x && p[0].y != p[3].y;
+}
+
+struct Occluder
+{
+    Rect rect; // in normalized device coordinates
+    float area;
+    int order;
+};
+
+static bool qsg_isCulled(Element *e, const QMatrix4x4 &m, const Occluder *occluders, int occluderCount)
+{
+    // Lines and points can be drawn wider than their bounds
+    const int mode = e->node->geometry()->drawingMode();
+    if (mode != QSGGeometry::DrawTriangles && mode != QSGGeometry::DrawTriangleStrip
+            && mode != QSGGeometry::DrawTriangleFan)
+        return false;
+
+    // The bounds are mapped without dividing by w, which is only right when
+    // the node's matrix, e.g. one with a projected Rotation, doesn't change it
+    if (!qsg_isAffine2D(*e->node->matrix()))
+        return false;
+
+    e->ensureBoundsValid();
+    if (e->boundsOutsideFloatRange)
+        return false;
+
+    Rect r = e->bounds;
+    r.map(m);
+    if (r.br.x < -1 || r.tl.x > 1 || r.br.y < -1 || r.tl.y > 1)
+        return true;
+
+    for (int i = 0; i < occluderCount; ++i) {
+        const Occluder &o = occluders[i];
+        if (o.order > e->order
+                && o.rect.tl.x <= r.tl.x && o.rect.tl.y <= r.tl.y
+                && o.rect.br.x >= r.br.x && o.rect.br.y >= r.br.y)
+            return true;
+    }
+    return false;
+}
+
+/* Marks the elements that are outside the viewport, or that are completely
+ * behind one of the largest opaque rectangles of the scene, as culled. A
+ * batch in which all elements are culled is neither uploaded nor drawn, so
+ * it keeps its pending uploads until it becomes visible again. Unmerged
+ * batches also skip the draw calls of their culled elements.
+ *
+ * Only opaque batches can occlude, as they are drawn with depth testing,
+ * and the elements behind them are all those with a lower order.
+ */
+void Renderer::cullBatches()
+{
+    QMatrix4x4 projection;
+    bool enabled = !debug_noculling() && projectionMatrixCount() == 1
+            && m_visualizer->mode() == Visualizer::VisualizeNothing;
+    if (enabled) {
+        projection = projectionMatrix(0);
+        enabled = qsg_isAffine2D(projection);
+    }
+
+    Occluder occluders[MAX_OCCLUDERS];
+    int occluderCount = 0;
+    if (enabled && !debug_noopaque()) {
+        for (int i = 0; i < m_opaqueBatches.size(); ++i) {
+            Batch *b = m_opaqueBatches.at(i);
+            const QMatrix4x4 m = b->root ? projection * qsg_matrixForRoot(b->root) : projection;
+            if (!isScale(m))
+                continue;
+            for (Element *e = b->first; e; e = e->nextInBatch) {
+                QSGGeometryNode *gn = e->node;
+                Rect rect;
+                if (gn->clipList() || !isScale(*gn->matrix())
+                        || !qsg_geometryIsRect(gn->geometry(), &rect)
+                        || !qsg_isKnownOpaqueMaterial(gn->activeMaterial()))
+                    continue;
+                rect.map(*gn->matrix());
+                rect.map(m);
+                const float area = (rect.br.x - rect.tl.x) * (rect.br.y - rect.tl.y);
+
+                // Keep only the largest ones, so testing against them stays cheap
+                int slot = occluderCount;
+                if (occluderCount < MAX_OCCLUDERS) {
+                    ++occluderCount;
+                } else {
+                    slot = 0;
+                    for (int j = 1; j < MAX_OCCLUDERS; ++j) {
+                        if (occluders[j].area < occluders[slot].area)
+                            slot = j;
+                    }
+                    if (occluders[slot].area >= area)
+                        continue;
+                }
+                occluders[slot] = { rect, area, e->order };
+            }
+        }
+    }
+
+    QDataBuffer<Batch *> *lists[] = { &m_opaqueBatches, &m_alphaBatches };
+    for (QDataBuffer<Batch *> *list : lists) {
+        for (int i = 0; i < list->size(); ++i) {
+            Batch *b = list->at(i);
+            QMatrix4x4 m;
+            bool cullable = enabled && !b->isRenderNode;
+            if (cullable) {
+                m = b->root ? projection * qsg_matrixForRoot(b->root) : projection;
+                cullable = qsg_isAffine2D(m);
+            }
+            bool allCulled = true;
+            for (Element *e = b->first; e; e = e->nextInBatch) {
+                e->culled = cullable && qsg_isCulled(e, m, occluders, occluderCount);
+                allCulled &= bool(e->culled);
+            }
+            b->culled = cullable && allCulled;
+        }
+    }
+}
+
 static inline int qsg_fixIndexCount(int iCount, int drawMode)
 {
     switch (drawMode) {
@@ -2020,6 +2209,195 @@ void Renderer::uploadMergedElement(Element *e, int vaOffset, char **vertexData,
     *indexCount += iCount;
 }
 
+/*
+ * Fills in the data of the elements from first up to, but not including,
+ * end, at the places uploadBatch() has given them in the batch's buffers.
+ */
+void Renderer::uploadMergedElements(Batch *b, Element *first, Element *end)
+{
+    for (Element *e = first; e != end; e = e->nextInBatch) {
+        char *vertexData = b->vbo.data + e->vertexOffset;
+        char *zData = b->vbo.data + e->zOffset;
+        char *indexData = b->ibo.data + e->indexOffset;
+        quint16 iOffset16 = e->indexBase;
+        quint32 iOffset32 = e->indexBase;
+        void *iBasePtr = m_uint32IndexForRhi ? static_cast<void *>(&iOffset32) : &iOffset16;
+        int indexCount = 0;
+        uploadMergedElement(e, b->positionAttribute, &vertexData, &zData, &indexData, iBasePtr, &indexCount);
+    }
+}
+
+/*
+ * Does uploadMergedElements() in chunks of about
+ * CONCURRENT_UPLOAD_CHUNK_VERTICES vertices on a thread pool of
+ * QSG_RENDERER_UPLOAD_THREADS threads. Every element already has its own
+ * place in the buffers, so the chunks don't depend on each other, and the
+ * nodes are not touched by anything else while the render thread waits here.
+ */
+void Renderer::uploadMergedElementsConcurrently(Batch *b)
+{
+    if (!m_uploadPool) {
+        m_uploadPool.reset(new QThreadPool);
+        m_uploadPool->setObjectName(QLatin1String("QSGBatchRendererUploadPool"));
+        m_uploadPool->setMaxThreadCount(m_uploadThreadCount);
+    }
+
+    Element *chunk = b->first;
+    int chunkVertexCount = 0;
+    for (Element *e = b->first; e; e = e->nextInBatch) {
+        chunkVertexCount += e->uploadedVertexCount;
+        if (chunkVertexCount >= CONCURRENT_UPLOAD_CHUNK_VERTICES && e->nextInBatch) {
+            Element *end = e->nextInBatch;
+            m_uploadPool->start([this, b, chunk, end]() {
+                uploadMergedElements(b, chunk, end);
+            });
+            chunk = end;
+            chunkVertexCount = 0;
+        }
+    }
+    // The last chunk is done on this thread while the others run
+    uploadMergedElements(b, chunk, nullptr);
+    m_uploadPool->waitForDone();
+}
+
+/*
+ * Copies the vertex and index data of an element of an unmerged batch as is,
+ * only widening the indices when the rhi needs 32-bit ones.
+ */
+void Renderer::uploadUnmergedElement(Element *e, char **vertexData, char **indexData)
+{
+    QSGGeometry *g = e->node->geometry();
+    int vbs = g->vertexCount() * g->sizeOfVertex();
+    memcpy(*vertexData, g->vertexData(), vbs);
+    *vertexData += vbs;
+    const int indexCount = g->indexCount();
+    if (indexCount) {
+        const int effectiveIndexSize = m_uint32IndexForRhi ? sizeof(quint32) : g->sizeOfIndex();
+        const int ibs = indexCount * effectiveIndexSize;
+        if (g->sizeOfIndex() == effectiveIndexSize) {
+            memcpy(*indexData, g->indexData(), ibs);
+        } else {
+            if (g->sizeOfIndex() == sizeof(quint16) && effectiveIndexSize == sizeof(quint32)) {
+                quint16 *src = g->indexDataAsUShort();
+                quint32 *dst = (quint32 *) *indexData;
+                for (int i = 0; i < indexCount; ++i)
+                    dst[i] = src[i];
+            } else {
+                Q_ASSERT_X(false, "uploadBatch (unmerged)", "uint index with ushort effective index - cannot happen");
+            }
+        }
+        *indexData += ibs;
+    }
+}
+
+/*
+ * Uploads only the elements of an already uploaded batch which are marked
+ * with Element::needsUpload, writing them over their previous data in the
+ * batch's buffers. That works as long as they have as many vertices and
+ * indices as in the last full upload, as then every element keeps its place.
+ * Consecutive changed elements are uploaded as one range. Returns false when
+ * the whole batch has to be uploaded instead, which also overwrites anything
+ * that was already uploaded here.
+ */
+bool Renderer::uploadChangedElements(Batch *b)
+{
+    // The visualizer reads the data of the whole batch from Buffer::data
+    if (m_visualizer->mode() != Visualizer::VisualizeNothing || !b->vbo.buf
+        || (b->ibo.size > 0 && !b->ibo.buf)) {
+        return false;
+    }
+
+    const bool merged = b->merged;
+    const bool hasZOrders = merged && useDepthBuffer();
+    if (hasZOrders && b->zRange != m_zRange)
+        return false;
+
+    QSGGeometry *g = b->first->node->geometry();
+    const int vSize = g->sizeOfVertex();
+    int changedVertexCount = 0;
+    for (Element *e = b->first; e; e = e->nextInBatch) {
+        if (e->removed)
+            return false;
+        if (!e->needsUpload)
+            continue;
+        QSGGeometry *eg = e->node->geometry();
+        if (eg->vertexCount() != e->uploadedVertexCount
+            || eg->indexCount() != e->uploadedIndexCount
+            || eg->sizeOfIndex() != e->uploadedIndexSize
+            || eg->sizeOfVertex() != vSize
+            || eg->drawingMode() != g->drawingMode()) {
+            return false;
+        }
+        changedVertexCount += e->uploadedVertexCount;
+    }
+    // Many small uploads are not cheaper than a single one of everything
+    if (changedVertexCount > b->vertexCount / 2)
+        return false;
+
+    if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch:" << b << "uploading" << changedVertexCount << "changed vertices...";
+
+    Element *e = b->first;
+    while (e) {
+        if (!e->needsUpload) {
+            e = e->nextInBatch;
+            continue;
+        }
+
+        Element *end = e;
+        int vertexCount = 0;
+        int maxIndexCount = 0;
+        for (; end && end->needsUpload; end = end->nextInBatch) {
+            vertexCount += end->uploadedVertexCount;
+            // Merged elements without indices get one per vertex, strips get
+            // two more for the degenerate triangles
+            maxIndexCount += (end->uploadedIndexCount ? end->uploadedIndexCount : end->uploadedVertexCount) + 2;
+        }
+
+        const quint32 vertexBytes = vertexCount * vSize;
+        m_vertexUploadPool.resize(vertexBytes + (hasZOrders ? vertexCount * sizeof(float) : 0));
+        m_indexUploadPool.resize(maxIndexCount * sizeof(quint32));
+        char *vertexData = m_vertexUploadPool.data();
+        char *zorders = vertexData + vertexBytes;
+        char *indexData = m_indexUploadPool.data();
+
+        for (Element *r = e; r != end; r = r->nextInBatch) {
+            if (merged) {
+                quint16 iOffset16 = r->indexBase;
+                quint32 iOffset32 = r->indexBase;
+                void *iBasePtr = m_uint32IndexForRhi ? static_cast<void *>(&iOffset32) : &iOffset16;
+                int indexCount = 0;
+                uploadMergedElement(r, b->positionAttribute, &vertexData, &zorders, &indexData, iBasePtr, &indexCount);
+            } else {
+                uploadUnmergedElement(r, &vertexData, &indexData);
+            }
+            r->needsUpload = false;
+        }
+
+        // Every byte between this run and the next element is rewritten
+        const quint32 indexBytes = indexData - m_indexUploadPool.data();
+        const quint32 indexEnd = end ? end->indexOffset : b->ibo.size;
+        if (quint32(vertexData - m_vertexUploadPool.data()) != vertexBytes
+            || indexBytes != indexEnd - e->indexOffset) {
+            return false;
+        }
+
+        if (vertexBytes)
+            uploadRange(&b->vbo, e->vertexOffset, vertexBytes, m_vertexUploadPool.data());
+        if (hasZOrders && vertexCount)
+            uploadRange(&b->vbo, e->zOffset, vertexCount * sizeof(float), m_vertexUploadPool.data() + vertexBytes);
+        if (indexBytes)
+            uploadRange(&b->ibo, e->indexOffset, indexBytes, m_indexUploadPool.data());
+
+        e = end;
+    }
+
+    if (b->vbo.buf->type() != QRhiBuffer::Dynamic)
+        b->vbo.nonDynamicChangeCount += 1;
+    if (b->ibo.buf && b->ibo.buf->type() != QRhiBuffer::Dynamic)
+        b->ibo.nonDynamicChangeCount += 1;
+    return true;
+}
+
 QMatrix4x4 qsg_matrixForRoot(Node *node)
 {
     if (node->type() == QSGNode::TransformNodeType)
@@ -2032,7 +2410,7 @@ QMatrix4x4 qsg_matrixForRoot(Node *node)
 void Renderer::uploadBatch(Batch *b)
 {
     // Early out if nothing has changed in this batch..
-    if (!b->needsUpload) {
+    if (!b->needsUpload && !b->needsPartialUpload) {
         if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch:" << b << "already uploaded...";
         return;
     }
@@ -2062,6 +2440,14 @@ void Renderer::uploadBatch(Batch *b)
             && ((flags & QSGMaterial::RequiresFullMatrixExceptTranslate) == 0 || b->isTranslateOnlyToRoot())
             && b->isSafeToBatch();
 
+    // Only some elements changed, try to only upload those
+    if (!b->needsUpload && canMerge == bool(b->merged) && uploadChangedElements(b)) {
+        b->needsPartialUpload = false;
+        if (Q_UNLIKELY(debug_render()))
+            b->uploadedThisFrame = true;
+        return;
+    }
+
     b->merged = canMerge;
 
     // Figure out how much memory we need...
@@ -2072,6 +2458,10 @@ void Renderer::uploadBatch(Batch *b)
 
     while (e) {
         QSGGeometry *eg = e->node->geometry();
+        e->needsUpload = false;
+        e->uploadedVertexCount = eg->vertexCount();
+        e->uploadedIndexCount = eg->indexCount();
+        e->uploadedIndexSize = eg->sizeOfIndex();
         b->vertexCount += eg->vertexCount();
         int iCount = eg->indexCount();
         if (b->merged) {
@@ -2121,12 +2511,14 @@ void Renderer::uploadBatch(Batch *b)
                                              << " vbo:" << b->vbo.buf << ":" << b->vbo.size;
 
     if (b->merged) {
-        char *vertexData = b->vbo.data;
-        char *zData = vertexData + b->vertexCount * g->sizeOfVertex();
-        char *indexData = b->ibo.data;
+        // First give every element its place in the buffers, then fill them
+        const int vSize = g->sizeOfVertex();
+        const quint32 zOffset = b->vertexCount * vSize;
+        quint32 vertexData = 0;
+        quint32 zData = zOffset;
+        quint32 indexData = 0;
 
-        quint16 iOffset16 = 0;
-        quint32 iOffset32 = 0;
+        quint32 iOffset = 0;
         e = b->first;
         uint verticesInSet = 0;
         // Start a new set already after 65534 vertices because 0xFFFF may be
@@ -2135,33 +2527,45 @@ void Renderer::uploadBatch(Batch *b)
         const uint verticesInSetLimit = m_uint32IndexForRhi ? 0xfffffffe : 0xfffe;
         int indicesInSet = 0;
         b->drawSets.reset();
-        int drawSetIndices = 0;
-        const char *indexBase = b->ibo.data;
-        b->drawSets << DrawSet(0, zData - vertexData, drawSetIndices);
+        b->drawSets << DrawSet(0, zOffset, 0);
         while (e) {
-            verticesInSet += e->node->geometry()->vertexCount();
+            QSGGeometry *eg = e->node->geometry();
+            const int vCount = eg->vertexCount();
+            verticesInSet += vCount;
             if (verticesInSet > verticesInSetLimit) {
                 b->drawSets.last().indexCount = indicesInSet;
                 if (g->drawingMode() == QSGGeometry::DrawTriangleStrip) {
                     b->drawSets.last().indices += 1 * mergedIndexElemSize();
                     b->drawSets.last().indexCount -= 2;
                 }
-                drawSetIndices = indexData - indexBase;
-                b->drawSets << DrawSet(vertexData - b->vbo.data,
-                                       zData - b->vbo.data,
-                                       drawSetIndices);
-                iOffset16 = 0;
-                iOffset32 = 0;
-                verticesInSet = e->node->geometry()->vertexCount();
+                b->drawSets << DrawSet(vertexData, zData, indexData);
+                iOffset = 0;
+                verticesInSet = vCount;
                 indicesInSet = 0;
             }
-            void *iBasePtr = &iOffset16;
-            if (m_uint32IndexForRhi)
-                iBasePtr = &iOffset32;
-            uploadMergedElement(e, b->positionAttribute, &vertexData, &zData, &indexData, iBasePtr, &indicesInSet);
+            e->vertexOffset = vertexData;
+            e->zOffset = zData;
+            e->indexOffset = indexData;
+            e->indexBase = iOffset;
+
+            // Same as what uploadMergedElement() writes
+            const int iCount = qsg_fixIndexCount(eg->indexCount() ? eg->indexCount() : vCount,
+                                                 eg->drawingMode());
+            vertexData += vCount * vSize;
+            if (useDepthBuffer())
+                zData += vCount * sizeof(float);
+            indexData += iCount * mergedIndexElemSize();
+            indicesInSet += iCount;
+            iOffset += vCount;
             e = e->nextInBatch;
         }
         b->drawSets.last().indexCount = indicesInSet;
+
+        if (m_uploadThreadCount > 0 && b->vertexCount > 2 * CONCURRENT_UPLOAD_CHUNK_VERTICES)
+            uploadMergedElementsConcurrently(b);
+        else
+            uploadMergedElements(b, b->first, nullptr);
+
         // We skip the very first and very last degenerate triangles since they aren't needed
         // and the first one would reverse the vertex ordering of the merged strips.
         if (g->drawingMode() == QSGGeometry::DrawTriangleStrip) {
@@ -2173,28 +2577,9 @@ void Renderer::uploadBatch(Batch *b)
         char *iboData = b->ibo.data;
         Element *e = b->first;
         while (e) {
-            QSGGeometry *g = e->node->geometry();
-            int vbs = g->vertexCount() * g->sizeOfVertex();
-            memcpy(vboData, g->vertexData(), vbs);
-            vboData = vboData + vbs;
-            const int indexCount = g->indexCount();
-            if (indexCount) {
-                const int effectiveIndexSize = m_uint32IndexForRhi ? sizeof(quint32) : g->sizeOfIndex();
-                const int ibs = indexCount * effectiveIndexSize;
-                if (g->sizeOfIndex() == effectiveIndexSize) {
-                    memcpy(iboData, g->indexData(), ibs);
-                } else {
-                    if (g->sizeOfIndex() == sizeof(quint16) && effectiveIndexSize == sizeof(quint32)) {
-                        quint16 *src = g->indexDataAsUShort();
-                        quint32 *dst = (quint32 *) iboData;
-                        for (int i = 0; i < indexCount; ++i)
-                            dst[i] = src[i];
-                    } else {
-                        Q_ASSERT_X(false, "uploadBatch (unmerged)", "uint index with ushort effective index - cannot happen");
-                    }
-                }
-                iboData += ibs;
-            }
+            e->vertexOffset = vboData - b->vbo.data;
+            e->indexOffset = iboData - b->ibo.data;
+            uploadUnmergedElement(e, &vboData, &iboData);
             e = e->nextInBatch;
         }
     }
@@ -2269,6 +2654,8 @@ void Renderer::uploadBatch(Batch *b)
     if (Q_UNLIKELY(debug_upload())) qDebug() << "  --- vertex/index buffers unmapped, batch upload completed...";
 
     b->needsUpload = false;
+    b->needsPartialUpload = false;
+    b->zRange = m_zRange;
 
     if (Q_UNLIKELY(debug_render()))
         b->uploadedThisFrame = true;
@@ -3505,6 +3892,13 @@ void Renderer::renderUnmergedBatch(PreparedRenderBatch *renderBatch, bool depthP
         checkLineWidth(g);
         const int effectiveIndexSize = m_uint32IndexForRhi ? sizeof(quint32) : g->sizeOfIndex();
 
+        if (e->culled) {
+            vOffset += g->sizeOfVertex() * g->vertexCount();
+            iOffset += g->indexCount() * effectiveIndexSize;
+            e = e->nextInBatch;
+            continue;
+        }
+
         setGraphicsPipeline(cb, batch, e, depthPostPass);
 
         const QRhiCommandBuffer::VertexInput vbufBinding(batch->vbo.buf, vOffset);
@@ -3632,6 +4026,14 @@ void Renderer::renderInline()
     recordRenderPass(&m_mainRenderPassContext);
 }
 
+// Like QElapsedTimer::restart(), but in nanoseconds
+static inline quint64 qsg_restartTimer(QElapsedTimer *timer)
+{
+    const quint64 elapsed = timer->nsecsElapsed();
+    timer->start();
+    return elapsed;
+}
+
 void Renderer::prepareRenderPass(RenderPassContext *ctx)
 {
     if (ctx->valid)
@@ -3650,6 +4052,9 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
     ctx->timeSorting = 0;
     ctx->timeUploadOpaque = 0;
     ctx->timeUploadAlpha = 0;
+    ctx->timing = debug_render() || QSG_LOG_TIME_RENDERER().isDebugEnabled();
+    if (Q_UNLIKELY(ctx->timing))
+        ctx->timer.start();
 
     if (Q_UNLIKELY(debug_render() || debug_build())) {
         QByteArray type("rebuild:");
@@ -3667,7 +4072,6 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
         }
 
         qDebug() << "Renderer::render()" << this << type;
-        ctx->timer.start();
     }
 
     m_resourceUpdates = m_rhi->nextResourceUpdateBatch();
@@ -3693,7 +4097,7 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
             }
         }
     }
-    if (Q_UNLIKELY(debug_render())) ctx->timeRenderLists = ctx->timer.restart();
+    if (Q_UNLIKELY(ctx->timing)) ctx->timeRenderLists = qsg_restartTimer(&ctx->timer);
 
     for (int i=0; i<m_opaqueBatches.size(); ++i)
         m_opaqueBatches.at(i)->cleanupRemovedElements();
@@ -3706,9 +4110,9 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
 
     if (m_rebuild & BuildBatches) {
         prepareOpaqueBatches();
-        if (Q_UNLIKELY(debug_render())) ctx->timePrepareOpaque = ctx->timer.restart();
+        if (Q_UNLIKELY(ctx->timing)) ctx->timePrepareOpaque = qsg_restartTimer(&ctx->timer);
         prepareAlphaBatches();
-        if (Q_UNLIKELY(debug_render())) ctx->timePrepareAlpha = ctx->timer.restart();
+        if (Q_UNLIKELY(ctx->timing)) ctx->timePrepareAlpha = qsg_restartTimer(&ctx->timer);
 
         if (Q_UNLIKELY(debug_build())) {
             qDebug("Opaque Batches:");
@@ -3729,7 +4133,7 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
             }
         }
     } else {
-        if (Q_UNLIKELY(debug_render())) ctx->timePrepareOpaque = ctx->timePrepareAlpha = ctx->timer.restart();
+        if (Q_UNLIKELY(ctx->timing)) ctx->timePrepareOpaque = qsg_restartTimer(&ctx->timer);
     }
 
 
@@ -3750,7 +4154,9 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
                  : 0;
     }
 
-    if (Q_UNLIKELY(debug_render())) ctx->timeSorting = ctx->timer.restart();
+    cullBatches();
+
+    if (Q_UNLIKELY(ctx->timing)) ctx->timeSorting = qsg_restartTimer(&ctx->timer);
 
     // Set size to 0, nothing is deallocated, they will "grow" again
     // as part of uploadBatch.
@@ -3760,16 +4166,18 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
     if (Q_UNLIKELY(debug_upload())) qDebug("Uploading Opaque Batches:");
     for (int i=0; i<m_opaqueBatches.size(); ++i) {
         Batch *b = m_opaqueBatches.at(i);
-        uploadBatch(b);
+        if (!b->culled)
+            uploadBatch(b);
     }
-    if (Q_UNLIKELY(debug_render())) ctx->timeUploadOpaque = ctx->timer.restart();
+    if (Q_UNLIKELY(ctx->timing)) ctx->timeUploadOpaque = qsg_restartTimer(&ctx->timer);
 
     if (Q_UNLIKELY(debug_upload())) qDebug("Uploading Alpha Batches:");
     for (int i=0; i<m_alphaBatches.size(); ++i) {
         Batch *b = m_alphaBatches.at(i);
-        uploadBatch(b);
+        if (!b->culled)
+            uploadBatch(b);
     }
-    if (Q_UNLIKELY(debug_render())) ctx->timeUploadAlpha = ctx->timer.restart();
+    if (Q_UNLIKELY(ctx->timing)) ctx->timeUploadAlpha = qsg_restartTimer(&ctx->timer);
 
     if (Q_UNLIKELY(debug_render())) {
         qDebug().nospace() << "Rendering:" << Qt::endl
@@ -3817,6 +4225,8 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
     if (Q_LIKELY(renderOpaque)) {
         for (int i = 0, ie = m_opaqueBatches.size(); i != ie; ++i) {
             Batch *b = m_opaqueBatches.at(i);
+            if (b->culled)
+                continue;
             PreparedRenderBatch renderBatch;
             bool ok;
             if (b->merged)
@@ -3847,6 +4257,8 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
     if (Q_LIKELY(renderAlpha)) {
         for (int i = 0, ie = m_alphaBatches.size(); i != ie; ++i) {
             Batch *b = m_alphaBatches.at(i);
+            if (b->culled)
+                continue;
             PreparedRenderBatch renderBatch;
             bool ok;
             if (b->merged)
@@ -3957,13 +4369,20 @@ void Renderer::recordRenderPass(RenderPassContext *ctx)
 
     cb->debugMarkEnd();
 
+    if (Q_UNLIKELY(ctx->timing)) {
+        m_timings.buildBatches = ctx->timeRenderLists + ctx->timePrepareOpaque
+                + ctx->timePrepareAlpha + ctx->timeSorting;
+        m_timings.upload = ctx->timeUploadOpaque + ctx->timeUploadAlpha;
+        m_timings.record = ctx->timer.nsecsElapsed();
+    }
+
     if (Q_UNLIKELY(debug_render())) {
         qDebug(" -> times: build: %d, prepare(opaque/alpha): %d/%d, sorting: %d, upload(opaque/alpha): %d/%d, record rendering: %d",
-               (int) ctx->timeRenderLists,
-               (int) ctx->timePrepareOpaque, (int) ctx->timePrepareAlpha,
-               (int) ctx->timeSorting,
-               (int) ctx->timeUploadOpaque, (int) ctx->timeUploadAlpha,
-               (int) ctx->timer.elapsed());
+               int(ctx->timeRenderLists / 1000000),
+               int(ctx->timePrepareOpaque / 1000000), int(ctx->timePrepareAlpha / 1000000),
+               int(ctx->timeSorting / 1000000),
+               int(ctx->timeUploadOpaque / 1000000), int(ctx->timeUploadAlpha / 1000000),
+               int(ctx->timer.elapsed()));
     }
 }
 
@@ -29,8 +29,12 @@
 
 #include <rhi/qrhi.h>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
+class QThreadPool;
+
 namespace QSGBatchRenderer
 {
 
@@ -276,6 +280,8 @@ struct Element {
         , orphaned(false)
         , isRenderNode(false)
         , isMaterialBlended(false)
+        , needsUpload(false)
+        , culled(false)
     {
     }
 
@@ -302,6 +308,16 @@ struct Element {
     QRhiGraphicsPipeline *ps = nullptr;
     QRhiGraphicsPipeline *depthPostPassPs = nullptr;
 
+    // Where the element was put in its batch's buffers by the last full
+    // upload, in bytes. indexBase is the first index of a merged element.
+    quint32 vertexOffset = 0;
+    quint32 zOffset = 0;
+    quint32 indexOffset = 0;
+    quint32 indexBase = 0;
+    int uploadedVertexCount = 0;
+    int uploadedIndexCount = 0;
+    int uploadedIndexSize = 0;
+
     uint boundsComputed : 1;
     uint boundsOutsideFloatRange : 1;
     uint translateOnlyToRoot : 1;
@@ -309,6 +325,8 @@ struct Element {
     uint orphaned : 1;
     uint isRenderNode : 1;
     uint isMaterialBlended : 1;
+    uint needsUpload : 1; // only this element's data changed, see Batch::needsPartialUpload
+    uint culled : 1; // not visible in the current frame, see Renderer::cullBatches()
 };
 
 struct RenderNodeElement : public Element {
@@ -402,7 +420,7 @@ struct StencilClipState
 struct Batch
 {
     Batch() : drawSets(1) {}
-    bool geometryWasChanged(QSGGeometryNode *gn);
+    bool geometryWasChanged(Element *changed);
     BatchCompatibility isMaterialCompatible(Element *e) const;
     void invalidate();
     void cleanupRemovedElements();
@@ -410,6 +428,11 @@ struct Batch
     bool isTranslateOnlyToRoot() const;
     bool isSafeToBatch() const;
 
+    void elementChanged(Element *e) {
+        e->needsUpload = true;
+        needsPartialUpload = true;
+    }
+
     // pseudo-constructor...
     void init() {
         // Only non-reusable members are reset here. See Renderer::newBatch().
@@ -419,12 +442,15 @@ struct Batch
         indexCount = 0;
         isOpaque = false;
         needsUpload = false;
+        needsPartialUpload = false;
         merged = false;
         positionAttribute = -1;
+        zRange = 0;
         uploadedThisFrame = false;
         isRenderNode = false;
         ubufDataValid = false;
         needsPurge = false;
+        culled = false;
         clipState.reset();
         blendConstant = QColor();
     }
@@ -439,12 +465,16 @@ struct Batch
 
     int lastOrderInBatch;
 
+    qreal zRange; // that the z data of a merged batch was calculated with
+
     uint isOpaque : 1;
     uint needsUpload : 1;
+    uint needsPartialUpload : 1;
     uint merged : 1;
     uint isRenderNode : 1;
     uint ubufDataValid : 1;
     uint needsPurge : 1;
+    uint culled : 1; // all elements are culled, so neither uploaded nor drawn this frame
 
     mutable uint uploadedThisFrame : 1; // solely for debugging purposes
 
@@ -762,6 +792,7 @@ protected:
         bool valid = false;
         QVarLengthArray<PreparedRenderBatch, 64> opaqueRenderBatches;
         QVarLengthArray<PreparedRenderBatch, 64> alphaRenderBatches;
+        bool timing = false; // QSG_RENDERER_DEBUG=render or QSG_LOG_TIME_RENDERER, in ns
         QElapsedTimer timer;
         quint64 timeRenderLists;
         quint64 timePrepareOpaque;
@@ -808,9 +839,15 @@ private:
     bool checkOverlap(int first, int last, const Rect &bounds);
     void prepareAlphaBatches();
     void invalidateBatchAndOverlappingRenderOrders(Batch *batch);
+    void cullBatches();
 
     void uploadBatch(Batch *b);
+    bool uploadChangedElements(Batch *b);
+    void uploadRange(Buffer *buffer, quint32 offset, quint32 size, const char *data);
     void uploadMergedElement(Element *e, int vaOffset, char **vertexData, char **zData, char **indexData, void *iBasePtr, int *indexCount);
+    void uploadMergedElements(Batch *b, Element *first, Element *end);
+    void uploadMergedElementsConcurrently(Batch *b);
+    void uploadUnmergedElement(Element *e, char **vertexData, char **indexData);
 
     bool ensurePipelineState(Element *e, const ShaderManager::Shader *sms, bool depthPostPass = false);
     QRhiTexture *dummyTexture();
@@ -888,6 +925,8 @@ private:
     int m_batchNodeThreshold;
     int m_batchVertexThreshold;
     int m_srbPoolThreshold;
+    int m_uploadThreadCount;
+    std::unique_ptr<QThreadPool> m_uploadPool;
 
     Visualizer *m_visualizer;
 
@@ -152,6 +152,12 @@ void QSGRenderer::renderScene()
     m_is_rendering = false;
     m_changed_emitted = false;
 
+    if (profileFrames) {
+        m_timings.preprocess = preprocessTime;
+        m_timings.update = updatePassTime - preprocessTime;
+        m_timings.render = renderTime - updatePassTime;
+    }
+
     qCDebug(QSG_LOG_TIME_RENDERER,
             "time in renderer: total=%dms, preprocess=%d, updates=%d, rendering=%d",
             int(renderTime / 1000000),
@@ -97,6 +97,19 @@ public:
     void setRenderTarget(const QSGRenderTarget &rt) { m_rt = rt; }
     const QSGRenderTarget &renderTarget() const { return m_rt; }
 
+    // Of the last frame rendered with renderScene() while
+    // QSG_LOG_TIME_RENDERER is enabled, in nanoseconds. Renderers that don't
+    // track buildBatches, upload and record leave them at 0.
+    struct Timings {
+        qint64 preprocess = 0;
+        qint64 update = 0;
+        qint64 render = 0;
+        qint64 buildBatches = 0;
+        qint64 upload = 0;
+        qint64 record = 0;
+    };
+    const Timings &timings() const { return m_timings; }
+
     void setRenderPassRecordingCallbacks(QSGRenderContext::RenderPassCallback start,
                                          QSGRenderContext::RenderPassCallback end,
                                          void *userData)
@@ -135,6 +148,7 @@ protected:
         QSGRenderContext::RenderPassCallback end = nullptr;
         void *userData = nullptr;
     } m_renderPassRecordingCallbacks;
+    Timings m_timings;
 
 private:
     QSGNodeUpdater *m_node_updater;
@@ -6,6 +6,7 @@
 #include <qmath.h>
 #include <QtQuick/private/qsgdistancefieldglyphnode_p.h>
 #include <QtQuick/private/qsgcontext_p.h>
+#include <QtQuick/private/qsgdistancefielddiskcache_p.h>
 #include <private/qrawfont_p.h>
 #include <QtGui/qguiapplication.h>
 #include <qdir.h>
@@ -13,6 +14,9 @@
 
 #include <private/qquickprofiler_p.h>
 #include <QElapsedTimer>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+#include <QtQml/private/qqmlglobal_p.h>
 
 #include <qtquick_tracepoints_p.h>
 
@@ -27,6 +31,29 @@ Q_TRACE_POINT(qtquick, QSGDistanceFieldGlyphCache_glyphStore_exit)
 
 static QElapsedTimer qsg_render_timer;
 
+DEFINE_BOOL_CONFIG_OPTION(qsgAsyncDistanceFieldGlyphs, QSG_ASYNC_DISTANCEFIELD_GLYPHS)
+
+// With asynchronous generation, glyphs are still generated in update() until
+// this is spent, so a few new glyphs, e.g. when typing, show up right away
+static const qint64 QSG_SYNC_GLYPH_GENERATION_BUDGET_NS = 2000000;
+static const int QSG_GLYPHS_PER_GENERATION_JOB = 16;
+
+// Leaves a core for the render thread
+struct DistanceFieldGenerators : public QThreadPool
+{
+    DistanceFieldGenerators() { setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1)); }
+};
+Q_GLOBAL_STATIC(DistanceFieldGenerators, qsg_distanceFieldGenerators)
+
+// Shared with the jobs, so they can finish after the cache is gone
+struct QSGDistanceFieldGlyphCache::GeneratedGlyphs
+{
+    QMutex mutex;
+    QList<QDistanceField> distanceFields;
+    std::function<void()> callback;
+    bool cancelled = false;
+};
+
 QSGDistanceFieldGlyphCache::Texture QSGDistanceFieldGlyphCache::s_emptyTexture;
 
 QSGDistanceFieldGlyphCache::QSGDistanceFieldGlyphCache(const QRawFont &font, int renderTypeQuality)
@@ -45,10 +72,17 @@ QSGDistanceFieldGlyphCache::QSGDistanceFieldGlyphCache(const QRawFont &font, int
     // this allows us to call pathForGlyph once and reuse the result.
     m_referenceFont.setPixelSize(baseFontSize() * QT_DISTANCEFIELD_SCALE(m_doubleGlyphResolution));
     Q_ASSERT(m_referenceFont.isValid());
+
+    if (qsgAsyncDistanceFieldGlyphs())
+        m_generatedGlyphs.reset(new GeneratedGlyphs);
 }
 
 QSGDistanceFieldGlyphCache::~QSGDistanceFieldGlyphCache()
 {
+    if (m_generatedGlyphs) {
+        QMutexLocker locker(&m_generatedGlyphs->mutex);
+        m_generatedGlyphs->cancelled = true;
+    }
 }
 
 int QSGDistanceFieldGlyphCache::baseFontSize() const
@@ -150,7 +184,8 @@ void QSGDistanceFieldGlyphCache::update()
 {
     m_populatingGlyphs.clear();
 
-    if (m_pendingGlyphs.isEmpty())
+    const QList<QDistanceField> generatedFields = takeGeneratedGlyphs();
+    if (m_pendingGlyphs.isEmpty() && generatedFields.isEmpty())
         return;
 
     Q_TRACE_SCOPE(QSGDistanceFieldGlyphCache_update, m_pendingGlyphs.size());
@@ -161,19 +196,51 @@ void QSGDistanceFieldGlyphCache::update()
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphAdaptationLayerFrame);
     Q_TRACE(QSGDistanceFieldGlyphCache_glyphRender_entry);
 
-    QList<QDistanceField> distanceFields;
+    // Not in the constructor, a pregenerated cache may change the font size
+    // and resolution after that
+    if (!m_diskCacheChecked) {
+        m_diskCache = QSGDistanceFieldDiskCache::cacheForFont(m_referenceFont, m_doubleGlyphResolution);
+        m_diskCacheChecked = true;
+    }
+
+    QElapsedTimer generationTimer;
+    if (m_generatedGlyphs)
+        generationTimer.start();
+
+    QList<QDistanceField> distanceFields = generatedFields;
+    QList<QDistanceField> newFields;
+    QVector<glyph_t> asyncGlyphs;
+    int cachedCount = 0;
     const int pendingGlyphsSize = m_pendingGlyphs.size();
-    distanceFields.reserve(pendingGlyphsSize);
+    distanceFields.reserve(distanceFields.size() + pendingGlyphsSize);
     for (int i = 0; i < pendingGlyphsSize; ++i) {
-        GlyphData &gd = glyphData(m_pendingGlyphs.at(i));
-        distanceFields.append(QDistanceField(gd.path,
-                                             m_pendingGlyphs.at(i),
-                                             m_doubleGlyphResolution));
+        const glyph_t glyph = m_pendingGlyphs.at(i);
+        GlyphData &gd = glyphData(glyph);
+        QDistanceField field;
+        if (m_diskCache)
+            field = m_diskCache->glyph(glyph);
+        if (!field.isNull()) {
+            ++cachedCount;
+        } else if (m_generatedGlyphs
+                   && generationTimer.nsecsElapsed() > QSG_SYNC_GLYPH_GENERATION_BUDGET_NS) {
+            asyncGlyphs.append(glyph);
+            continue;
+        } else {
+            field = QDistanceField(gd.path, glyph, m_doubleGlyphResolution);
+            if (m_diskCache)
+                newFields.append(field);
+        }
+        distanceFields.append(field);
         gd.path = QPainterPath(); // no longer needed, so release memory used by the painter path
     }
 
+    if (!newFields.isEmpty())
+        m_diskCache->storeGlyphs(newFields);
+    if (!asyncGlyphs.isEmpty())
+        generateGlyphsAsync(asyncGlyphs);
+
     qint64 renderTime = 0;
-    int count = m_pendingGlyphs.size();
+    int count = distanceFields.size();
     if (profileFrames)
         renderTime = qsg_render_timer.nsecsElapsed();
 
@@ -184,7 +251,24 @@ void QSGDistanceFieldGlyphCache::update()
 
     m_pendingGlyphs.reset();
 
-    storeGlyphs(distanceFields);
+    if (!distanceFields.isEmpty())
+        storeGlyphs(distanceFields);
+
+    // Nodes have left these out when they were last updated, as the glyphs
+    // had no texture yet. The renderer has already taken the nodes to
+    // preprocess in this frame, so the invalidated ones need another frame.
+    if (!generatedFields.isEmpty()) {
+        QVector<quint32> generatedGlyphs;
+        generatedGlyphs.reserve(generatedFields.size());
+        for (const QDistanceField &field : generatedFields)
+            generatedGlyphs.append(field.glyph());
+        for (QSGDistanceFieldGlyphConsumerList::iterator iter = m_registeredNodes.begin(); iter != m_registeredNodes.end(); ++iter)
+            iter->invalidateGlyphs(generatedGlyphs);
+
+        QMutexLocker locker(&m_generatedGlyphs->mutex);
+        if (m_generatedGlyphs->callback)
+            m_generatedGlyphs->callback();
+    }
 
 #if defined(QSG_DISTANCEFIELD_CACHE_DEBUG)
     for (Texture texture : std::as_const(m_textures))
@@ -194,11 +278,12 @@ void QSGDistanceFieldGlyphCache::update()
     if (QSG_LOG_TIME_GLYPH().isDebugEnabled()) {
         quint64 now = qsg_render_timer.elapsed();
         qCDebug(QSG_LOG_TIME_GLYPH,
-                "distancefield: %d glyphs prepared in %dms, rendering=%d, upload=%d",
+                "distancefield: %d glyphs prepared in %dms, rendering=%d, upload=%d, from disk cache=%d",
                 count,
                 (int) now,
                 int(renderTime / 1000000),
-                int((now - (renderTime / 1000000))));
+                int((now - (renderTime / 1000000))),
+                cachedCount);
     }
     Q_TRACE(QSGDistanceFieldGlyphCache_glyphStore_exit);
     Q_QUICK_SG_PROFILE_END_WITH_PAYLOAD(QQuickProfiler::SceneGraphAdaptationLayerFrame,
@@ -206,6 +291,81 @@ void QSGDistanceFieldGlyphCache::update()
                                         (qint64)count);
 }
 
+void QSGDistanceFieldGlyphCache::generateGlyphsAsync(const QVector<glyph_t> &glyphs)
+{
+    for (int start = 0; start < glyphs.size(); start += QSG_GLYPHS_PER_GENERATION_JOB) {
+        const int count = qMin(QSG_GLYPHS_PER_GENERATION_JOB, int(glyphs.size()) - start);
+        QVector<glyph_t> jobGlyphs;
+        QList<QPainterPath> jobPaths;
+        jobGlyphs.reserve(count);
+        jobPaths.reserve(count);
+        for (int i = start; i < start + count; ++i) {
+            GlyphData &gd = glyphData(glyphs.at(i));
+            jobGlyphs.append(glyphs.at(i));
+            jobPaths.append(gd.path);
+            gd.path = QPainterPath();
+            m_generatingGlyphs.insert(glyphs.at(i));
+        }
+
+        QSharedPointer<GeneratedGlyphs> generated = m_generatedGlyphs;
+        QSharedPointer<QSGDistanceFieldDiskCache> diskCache = m_diskCache;
+        const bool doubleGlyphResolution = m_doubleGlyphResolution;
+        qsg_distanceFieldGenerators()->start([generated, diskCache, jobGlyphs, jobPaths, doubleGlyphResolution]() {
+            {
+                QMutexLocker locker(&generated->mutex);
+                if (generated->cancelled)
+                    return;
+            }
+
+            QList<QDistanceField> distanceFields;
+            distanceFields.reserve(jobGlyphs.size());
+            for (int i = 0; i < jobGlyphs.size(); ++i)
+                distanceFields.append(QDistanceField(jobPaths.at(i), jobGlyphs.at(i), doubleGlyphResolution));
+
+            if (diskCache)
+                diskCache->storeGlyphs(distanceFields);
+
+            QMutexLocker locker(&generated->mutex);
+            if (generated->cancelled)
+                return;
+            const bool notify = generated->distanceFields.isEmpty();
+            generated->distanceFields += distanceFields;
+            if (notify && generated->callback)
+                generated->callback();
+        });
+    }
+}
+
+QList<QDistanceField> QSGDistanceFieldGlyphCache::takeGeneratedGlyphs()
+{
+    if (!m_generatedGlyphs)
+        return QList<QDistanceField>();
+
+    QList<QDistanceField> generated;
+    {
+        QMutexLocker locker(&m_generatedGlyphs->mutex);
+        generated.swap(m_generatedGlyphs->distanceFields);
+    }
+
+    // Glyphs removed from the cache in the meantime, or generated twice
+    // because they were removed and requested again, are dropped
+    QList<QDistanceField> distanceFields;
+    distanceFields.reserve(generated.size());
+    for (const QDistanceField &field : std::as_const(generated)) {
+        if (m_generatingGlyphs.remove(field.glyph()))
+            distanceFields.append(field);
+    }
+    return distanceFields;
+}
+
+void QSGDistanceFieldGlyphCache::setGlyphsGeneratedCallback(const std::function<void()> &callback)
+{
+    if (!m_generatedGlyphs)
+        return;
+    QMutexLocker locker(&m_generatedGlyphs->mutex);
+    m_generatedGlyphs->callback = callback;
+}
+
 void QSGDistanceFieldGlyphCache::setGlyphsPosition(const QList<GlyphPosition> &glyphs)
 {
     QVector<quint32> invalidatedGlyphs;
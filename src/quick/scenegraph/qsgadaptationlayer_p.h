@@ -33,6 +33,8 @@
 #include <private/qintrusivelist_p.h>
 #include <rhi/qshader.h>
 
+#include <functional>
+
 // ### remove
 #include <QtQuick/private/qquicktext_p.h>
 
@@ -51,6 +53,7 @@ class QSGSpriteNode;
 class QSGRenderNode;
 class QSGRenderContext;
 class QRhiTexture;
+class QSGDistanceFieldDiskCache;
 
 class Q_QUICK_EXPORT QSGNodeVisitorEx
 {
@@ -502,6 +505,11 @@ protected:
 
     void updateRhiTexture(QRhiTexture *oldTex, QRhiTexture *newTex, const QSize &newTexSize);
 
+    // Called from a worker thread when glyphs generated in the background
+    // are ready to be stored by the next update(), and by the update()
+    // storing them, as the nodes using them are only rebuilt on the frame after
+    void setGlyphsGeneratedCallback(const std::function<void()> &callback);
+
     inline bool containsGlyph(glyph_t glyph);
 
     GlyphData &glyphData(glyph_t glyph);
@@ -520,12 +528,21 @@ protected:
     QRawFont m_referenceFont;
 
 private:
+    struct GeneratedGlyphs;
+
+    void generateGlyphsAsync(const QVector<glyph_t> &glyphs);
+    QList<QDistanceField> takeGeneratedGlyphs();
+
     int m_glyphCount;
     QList<Texture> m_textures;
     QHash<glyph_t, GlyphData> m_glyphsData;
     QDataBuffer<glyph_t> m_pendingGlyphs;
     QSet<glyph_t> m_populatingGlyphs;
     QSGDistanceFieldGlyphConsumerList m_registeredNodes;
+    QSharedPointer<QSGDistanceFieldDiskCache> m_diskCache;
+    bool m_diskCacheChecked = false;
+    QSharedPointer<GeneratedGlyphs> m_generatedGlyphs;
+    QSet<glyph_t> m_generatingGlyphs;
 
     static Texture s_emptyTexture;
 };
@@ -545,6 +562,7 @@ inline void QSGDistanceFieldGlyphCache::removeGlyph(glyph_t glyph)
     GlyphData &gd = glyphData(glyph);
     gd.texCoord = TexCoord();
     gd.texture = &s_emptyTexture;
+    m_generatingGlyphs.remove(glyph);
 }
 
 inline bool QSGDistanceFieldGlyphCache::containsGlyph(glyph_t glyph)
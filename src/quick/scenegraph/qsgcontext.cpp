@@ -105,8 +105,22 @@ public:
 
     virtual bool isVSyncDependent() const = 0;
 
+    // How much later than now the frame with the results of the next
+    // advance() is expected to be on screen, in milliseconds
+    void setPresentationDelay(qint64 delay) { m_presentationDelay = delay; }
+
 protected:
+    // Time based elapsed() values are moved ahead by the presentation delay.
+    // As the delay varies, this keeps them from going backwards.
+    qint64 presentationTime(qint64 time) const
+    {
+        m_lastPresentationTime = qMax(m_lastPresentationTime, time + m_presentationDelay);
+        return m_lastPresentationTime;
+    }
+
     float m_vsync = 0;
+    qint64 m_presentationDelay = 0;
+    mutable qint64 m_lastPresentationTime = 0;
 };
 
 // default as in default for the threaded render loop
@@ -145,6 +159,7 @@ public:
     void start() override
     {
         m_time = 0;
+        m_lastPresentationTime = 0;
         m_timer.start();
         m_wallTime.restart();
         QAnimationDriver::start();
@@ -152,9 +167,11 @@ public:
 
     qint64 elapsed() const override
     {
+        // In vsync mode every advance() is one frame, so the time is
+        // aligned with presentation already
         return m_mode == VSyncMode
                 ? qint64(m_time)
-                : qint64(m_time) + m_wallTime.elapsed();
+                : presentationTime(qint64(m_time) + m_wallTime.elapsed());
     }
 
     void advance() override
@@ -269,13 +286,14 @@ public:
 
     void start() override
     {
+        m_lastPresentationTime = 0;
         m_wallTime.restart();
         QAnimationDriver::start();
     }
 
     qint64 elapsed() const override
     {
-        return m_wallTime.elapsed();
+        return presentationTime(m_wallTime.elapsed());
     }
 
     void advance() override
@@ -405,6 +423,17 @@ bool QSGContext::isVSyncDependent(QAnimationDriver *driver)
     return static_cast<QSGAnimationDriver *>(driver)->isVSyncDependent();
 }
 
+/*!
+    Tells the \a driver that was created by createAnimationDriver() that the
+    frame showing the results of its next advance will be presented \a delay
+    milliseconds from now, so that time based animations can be advanced to
+    that point in time instead of the current one.
+ */
+void QSGContext::setPresentationDelayForAnimationDriver(QAnimationDriver *driver, qint64 delay)
+{
+    static_cast<QSGAnimationDriver *>(driver)->setPresentationDelay(delay);
+}
+
 QSize QSGContext::minimumFBOSize() const
 {
     return QSize(1, 1);
@@ -111,6 +111,7 @@ public:
     virtual QAnimationDriver *createAnimationDriver(QObject *parent);
     virtual float vsyncIntervalForAnimationDriver(QAnimationDriver *driver);
     virtual bool isVSyncDependent(QAnimationDriver *driver);
+    virtual void setPresentationDelayForAnimationDriver(QAnimationDriver *driver, qint64 delay);
 
     virtual QSize minimumFBOSize() const;
     virtual QSurfaceFormat defaultSurfaceFormat() const = 0;
@@ -186,6 +187,8 @@ Q_SIGNALS:
     void initialized();
     void invalidated();
     void releaseCachedResourcesRequested();
+    // Asks for a frame, emitted from worker threads and the render thread
+    void distanceFieldGlyphsGenerated();
 
 public Q_SLOTS:
     void textureFactoryDestroyed(QObject *o);
@@ -28,6 +28,10 @@ QSGRhiDistanceFieldGlyphCache::QSGRhiDistanceFieldGlyphCache(QSGDefaultRenderCon
 {
     // Load a pregenerated cache if the font contains one
     loadPregeneratedCache(font);
+
+    setGlyphsGeneratedCallback([rc]() {
+        emit rc->distanceFieldGlyphsGenerated();
+    });
 }
 
 QSGRhiDistanceFieldGlyphCache::~QSGRhiDistanceFieldGlyphCache()
@@ -96,6 +96,13 @@ Q_TRACE_POINT(qtquick, QSG_animations_exit)
 
 #define QSG_RT_PAD "                    (RT) %s"
 
+// Follows increases right away and decreases slowly, so that deadlines
+// computed from the result are rarely missed
+static qint64 qsg_smoothedDuration(qint64 smoothed, qint64 sample)
+{
+    return sample > smoothed ? sample : smoothed + (sample - smoothed) / 8;
+}
+
 extern Q_GUI_EXPORT QImage qt_gl_read_framebuffer(const QSize &size, bool alpha_format, bool include_alpha);
 
 // RL: Render Loop
@@ -301,6 +308,10 @@ public:
 
     QElapsedTimer m_threadTimeBetweenRenders;
 
+    // Written after each frame, read by the gui thread to pace the syncs
+    QAtomicInteger<qint64> lastPresentTime; // on wm->m_frameClock, 0 if none yet
+    QAtomicInteger<qint64> renderDuration; // smoothed, in ns
+
     QQuickWindow *window; // Will be 0 when window is not exposed
     QSize windowSize;
     float dpr = 1;
@@ -687,6 +698,7 @@ void QSGRenderThread::syncAndRender()
         qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- updatePending, doing sync");
         sync(exposeRequested);
     }
+    const qint64 renderStart = wm->m_frameClock.nsecsElapsed();
 #ifndef QSG_NO_RENDER_TIMING
     if (profileFrames)
         syncTime = threadTimer.nsecsElapsed();
@@ -733,6 +745,8 @@ void QSGRenderThread::syncAndRender()
 
         d->renderSceneGraph();
 
+        renderDuration.storeRelaxed(qsg_smoothedDuration(renderDuration.loadRelaxed(),
+                                                         wm->m_frameClock.nsecsElapsed() - renderStart));
         if (profileFrames)
             renderTime = threadTimer.nsecsElapsed();
         Q_TRACE(QSG_render_exit);
@@ -750,6 +764,8 @@ void QSGRenderThread::syncAndRender()
                 QCoreApplication::postEvent(window, new QEvent(QEvent::Type(QQuickWindowPrivate::FullUpdateRequest)));
         } else {
             lastCompletedGpuTime = cd->swapchain->currentFrameCommandBuffer()->lastCompletedGpuTime();
+            // With vsync throttling this is close to when the frame went to screen
+            lastPresentTime.storeRelaxed(wm->m_frameClock.nsecsElapsed());
         }
         d->fireFrameSwapped();
     } else {
@@ -979,7 +995,12 @@ void QSGRenderThread::run()
 QSGThreadedRenderLoop::QSGThreadedRenderLoop()
     : sg(QSGContext::createDefaultContext())
     , m_animation_timer(0)
+    , m_lowLatency(qEnvironmentVariableIntValue("QSG_LOW_LATENCY") != 0)
 {
+    m_frameClock.start();
+    if (m_lowLatency)
+        qCDebug(QSG_LOG_INFO, "Threaded render loop: syncing as late as possible before each vsync");
+
     m_animation_driver = sg->createAnimationDriver(this);
 
     connect(m_animation_driver, SIGNAL(started()), this, SLOT(animationStarted()));
@@ -1248,6 +1269,10 @@ void QSGThreadedRenderLoop::handleExposure(QQuickWindow *window)
         win.timeBetweenPolishAndSyncs.start();
         win.psTimeAccumulator = 0.0f;
         win.psTimeSampleCount = 0;
+        win.syncDuration = 0;
+        win.predictedPresentTime = 0;
+        win.syncTimer = 0;
+        win.syncDeferred = false;
         m_windows << win;
         w = &m_windows.last();
     } else {
@@ -1305,6 +1330,8 @@ void QSGThreadedRenderLoop::handleExposure(QQuickWindow *window)
         qCDebug(QSG_LOG_RENDERLOOP, "- render thread already running");
     }
 
+    // Synced right away, a pending deferred sync would only add a frame
+    cancelDeferredSync(w);
     polishAndSync(w, true);
     qCDebug(QSG_LOG_RENDERLOOP, "- done with handleExposure()");
 
@@ -1324,6 +1351,7 @@ void QSGThreadedRenderLoop::handleObscurity(Window *w)
         return;
 
     qCDebug(QSG_LOG_RENDERLOOP) << "handleObscurity()" << w->window;
+    cancelDeferredSync(w);
     if (w->thread->isRunning()) {
         if (!QQuickWindowPrivate::get(w->window)->updatesEnabled) {
             qCDebug(QSG_LOG_RENDERLOOP, "- updatesEnabled is false, abort");
@@ -1371,8 +1399,106 @@ void QSGThreadedRenderLoop::handleUpdateRequest(QQuickWindow *window)
         return;
     }
     Window *w = windowFor(window);
-    if (w)
-        polishAndSync(w);
+    if (!w)
+        return;
+
+    // A deferred sync is pending already, which covers this update too
+    if (w->syncTimer)
+        return;
+
+    // In low latency mode the sync waits for as long as the frame can still
+    // be presented at the next vsync, so that it picks up the latest input.
+    // This is done for a single window only, the syncs of several windows
+    // would delay each other.
+    if (m_lowLatency && m_windows.size() == 1) {
+        const int delay = int(syncDelay(w) / 1000000);
+        if (delay > 0) {
+            qCDebug(QSG_LOG_RENDERLOOP, "- deferring polishAndSync by %d ms", delay);
+            Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphFrameLatency);
+            w->syncDeferred = true;
+            w->syncTimer = startTimer(delay, Qt::PreciseTimer);
+            return;
+        }
+    }
+
+    polishAndSync(w);
+}
+
+qint64 QSGThreadedRenderLoop::vsyncInterval(Window *w) const
+{
+    QScreen *screen = w->window->screen();
+    qreal refreshRate = screen ? screen->refreshRate() : 60;
+    // To work around that some platforms wrongfully return 0 or something
+    // bogus for the refresh rate.
+    if (refreshRate < 1)
+        refreshRate = 60;
+    return qint64(1000000000.0 / refreshRate);
+}
+
+/*
+    Returns the time of the first vsync, \a interval ns apart, that a frame
+    taking \a work ns from \a now to render can be presented at. This is
+    extrapolated from \a lastPresent, the time the last frame was presented,
+    so 0 is returned when nothing was presented for a while.
+ */
+qint64 qsg_predictPresentTime(qint64 lastPresent, qint64 interval, qint64 now, qint64 work)
+{
+    if (lastPresent == 0 || now - lastPresent > 4 * interval)
+        return 0;
+    const qint64 frames = (now + work - lastPresent + interval - 1) / interval;
+    return lastPresent + qMax<qint64>(frames, 1) * interval;
+}
+
+/*
+    Returns how long from \a now the sync of a frame, expected to take
+    \a frameWork ns to polish, sync and render, can be deferred with it still
+    being presented at the vsync predicted by qsg_predictPresentTime(). An
+    eighth of a frame is kept as a margin for presenting and for variations.
+ */
+qint64 qsg_syncDelay(qint64 lastPresent, qint64 interval, qint64 now, qint64 frameWork)
+{
+    const qint64 work = frameWork + interval / 8;
+    const qint64 present = qsg_predictPresentTime(lastPresent, interval, now, work);
+    return present ? present - work - now : 0;
+}
+
+/*
+    Returns the predicted presentation time of a frame, on m_frameClock, or 0
+    when presenting is not throttled by vsync.
+ */
+qint64 QSGThreadedRenderLoop::predictPresentTime(Window *w, qint64 now, qint64 work) const
+{
+    if (w->actualWindowFormat.swapInterval() == 0 || w->badVSync)
+        return 0;
+    return qsg_predictPresentTime(w->thread->lastPresentTime.loadRelaxed(), vsyncInterval(w),
+                                  now, work);
+}
+
+/*
+    Returns how long polishAndSync() can be deferred, in ns, with the frame
+    still making its vsync. The expected duration of polishing, syncing and
+    rendering comes from the previous frames.
+ */
+qint64 QSGThreadedRenderLoop::syncDelay(Window *w)
+{
+    if (w->actualWindowFormat.swapInterval() == 0 || w->badVSync)
+        return 0;
+    return qsg_syncDelay(w->thread->lastPresentTime.loadRelaxed(), vsyncInterval(w),
+                         m_frameClock.nsecsElapsed(),
+                         w->syncDuration + w->thread->renderDuration.loadRelaxed());
+}
+
+/*
+    Drops a polishAndSync() deferred in low latency mode, for when the window
+    is synced right away or not rendered anymore.
+ */
+void QSGThreadedRenderLoop::cancelDeferredSync(Window *w)
+{
+    if (w->syncTimer) {
+        killTimer(w->syncTimer);
+        w->syncTimer = 0;
+    }
+    w->syncDeferred = false;
 }
 
 void QSGThreadedRenderLoop::maybeUpdate(QQuickWindow *window)
@@ -1504,6 +1630,14 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
         return;
     }
 
+    // A deferred frame started when it was requested
+    if (!w->syncDeferred)
+        Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphFrameLatency);
+    w->syncDeferred = false;
+    Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphFrameLatency,
+                              QQuickProfiler::SceneGraphFrameLatencyDefer);
+    const qint64 syncStart = m_frameClock.nsecsElapsed();
+
     // Flush pending touch events.
     QQuickWindowPrivate::get(window)->deliveryAgentPrivate()->flushFrameSynchronousEvents(window);
     // The delivery of the event might have caused the window to stop rendering
@@ -1621,6 +1755,13 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
     w->thread->mutex.unlock();
     qCDebug(QSG_LOG_RENDERLOOP, "- unlock after sync");
 
+    const qint64 syncEnd = m_frameClock.nsecsElapsed();
+    w->syncDuration = qsg_smoothedDuration(w->syncDuration, syncEnd - syncStart);
+    w->predictedPresentTime = predictPresentTime(w, syncEnd, w->thread->renderDuration.loadRelaxed());
+    Q_QUICK_SG_PROFILE_END_WITH_PAYLOAD(QQuickProfiler::SceneGraphFrameLatency,
+                                        QQuickProfiler::SceneGraphFrameLatencySync,
+                                        w->predictedPresentTime ? w->predictedPresentTime - syncEnd : 0);
+
     if (profileFrames)
         syncTime = timer.nsecsElapsed();
     Q_TRACE(QSG_sync_exit);
@@ -1636,6 +1777,14 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
     // isVSyncDependent() == true, if not then we always use the driver and
     // just advance here)
     if (m_animation_timer == 0 && m_animation_driver->isRunning()) {
+        // In low latency mode the frames are presented at a steady distance
+        // from the end of the sync. What is advanced now is shown by the frame
+        // after the one that was just synced.
+        if (m_lowLatency && w->predictedPresentTime) {
+            const qint64 present = w->predictedPresentTime + vsyncInterval(w);
+            sg->setPresentationDelayForAnimationDriver(
+                    m_animation_driver, (present - m_frameClock.nsecsElapsed()) / 1000000);
+        }
         qCDebug(QSG_LOG_RENDERLOOP, "- advancing animations");
         m_animation_driver->advance();
         qCDebug(QSG_LOG_RENDERLOOP, "- animations done..");
@@ -1678,14 +1827,24 @@ bool QSGThreadedRenderLoop::event(QEvent *e)
     switch ((int) e->type()) {
 
     case QEvent::Timer: {
-        Q_ASSERT(sg->isVSyncDependent(m_animation_driver));
         QTimerEvent *te = static_cast<QTimerEvent *>(e);
         if (te->timerId() == m_animation_timer) {
+            Q_ASSERT(sg->isVSyncDependent(m_animation_driver));
             qCDebug(QSG_LOG_RENDERLOOP, "- ticking non-render thread timer");
             m_animation_driver->advance();
             emit timeToIncubate();
             return true;
         }
+        for (Window &w : m_windows) {
+            if (te->timerId() == w.syncTimer) {
+                qCDebug(QSG_LOG_RENDERLOOP, "- deferred polishAndSync");
+                killTimer(w.syncTimer);
+                w.syncTimer = 0;
+                if (QQuickWindowPrivate::get(w.window)->updatesEnabled)
+                    polishAndSync(&w);
+                return true;
+            }
+        }
     }
 
     default:
@@ -25,6 +25,12 @@ QT_BEGIN_NAMESPACE
 
 class QSGRenderThread;
 
+// The deadlines of the low latency mode, all times in ns
+Q_QUICK_EXPORT qint64 qsg_predictPresentTime(qint64 lastPresent, qint64 interval, qint64 now,
+                                             qint64 work);
+Q_QUICK_EXPORT qint64 qsg_syncDelay(qint64 lastPresent, qint64 interval, qint64 now,
+                                    qint64 frameWork);
+
 class QSGThreadedRenderLoop : public QSGRenderLoop
 {
     Q_OBJECT
@@ -69,9 +75,13 @@ private:
         QElapsedTimer timeBetweenPolishAndSyncs;
         float psTimeAccumulator;
         int psTimeSampleCount;
+        qint64 syncDuration; // polish and sync, smoothed, in ns
+        qint64 predictedPresentTime; // of the last synced frame, on m_frameClock
+        int syncTimer; // pending deferred polishAndSync() in low latency mode
         uint updateDuringSync : 1;
         uint forceRenderPass : 1;
         uint badVSync : 1;
+        uint syncDeferred : 1;
     };
 
     friend class QSGRenderThread;
@@ -88,6 +98,10 @@ private:
     void postUpdateRequest(Window *w);
     void waitForReleaseComplete();
     void polishAndSync(Window *w, bool inExpose = false);
+    qint64 vsyncInterval(Window *w) const;
+    qint64 predictPresentTime(Window *w, qint64 now, qint64 work) const;
+    qint64 syncDelay(Window *w);
+    void cancelDeferredSync(Window *w);
     void maybeUpdate(Window *window);
 
     void handleExposure(QQuickWindow *w);
@@ -107,6 +121,10 @@ private:
 
     bool m_lockedForSync;
     bool m_inPolish = false;
+
+    // Shared by the GUI and render threads for frame timestamps
+    QElapsedTimer m_frameClock;
+    bool m_lowLatency;
 };
 
 QT_END_NAMESPACE
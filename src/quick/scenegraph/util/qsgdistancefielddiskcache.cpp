@@ -0,0 +1,294 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qsgdistancefielddiskcache_p.h"
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qlockfile.h>
+#include <QtCore/qstandardpaths.h>
+#include <QtCore/qthreadpool.h>
+#include <QtGui/qrawfont.h>
+#include <QtGui/private/qfontengine_p.h>
+#include <QtGui/private/qrawfont_p.h>
+#include <QtQml/private/qqmlglobal_p.h>
+
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+DEFINE_BOOL_CONFIG_OPTION(qsgDisableDistanceFieldDiskCache, QSG_DISABLE_DISTANCEFIELD_DISK_CACHE)
+
+// The file is a FileHeader followed by the glyphs, each a GlyphHeader and
+// width * height bytes, padded to 4 bytes. It is written in native byte
+// order, a file from a machine with a different one fails the magic check.
+static const quint32 MagicNumber = 0x46445351; // "QSDF"
+static const quint32 FormatVersion = 1;
+
+// Not filling the disk for fonts with many glyphs, later glyphs are
+// generated at runtime as before
+static const qint64 MaxFileSize = 64 * 1024 * 1024;
+
+struct FileHeader
+{
+    quint32 magic;
+    quint32 version;
+};
+
+struct GlyphHeader
+{
+    quint32 glyph;
+    quint16 width;
+    quint16 height;
+    quint32 checksum;
+};
+
+static inline qint64 recordSize(const GlyphHeader &header)
+{
+    const qint64 size = qint64(sizeof(GlyphHeader)) + qint64(header.width) * header.height;
+    return (size + 3) & ~qint64(3);
+}
+
+static inline quint32 checksum(const uchar *bits, qsizetype size)
+{
+    return qChecksum(QByteArrayView(bits, size));
+}
+
+namespace {
+typedef QHash<QString, QWeakPointer<QSGDistanceFieldDiskCache>> DiskCacheHash;
+}
+
+Q_GLOBAL_STATIC(QMutex, qsg_diskCacheMutex)
+Q_GLOBAL_STATIC(DiskCacheHash, qsg_diskCaches)
+
+// One thread, so the writes of all caches are serialized and don't compete
+// with the render threads for more than one core
+struct DiskCacheWriter : public QThreadPool
+{
+    DiskCacheWriter() { setMaxThreadCount(1); }
+};
+Q_GLOBAL_STATIC(DiskCacheWriter, qsg_diskCacheWriter)
+
+static QString qsg_diskCacheDirectory()
+{
+    static const QString directory = []() {
+        const QByteArray envCachePath = qgetenv("QSG_DISTANCEFIELD_DISK_CACHE_PATH");
+        QString path;
+        if (!envCachePath.isEmpty()) {
+            path = QString::fromLocal8Bit(envCachePath) + QLatin1Char('/');
+        } else {
+            const QString cachePath = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+            if (cachePath.isEmpty())
+                return QString();
+            path = cachePath + QLatin1String("/qtdistancefieldcache/");
+        }
+        QDir::root().mkpath(path);
+        return QFileInfo(path).isWritable() ? path : QString();
+    }();
+    return directory;
+}
+
+QSGDistanceFieldDiskCache::QSGDistanceFieldDiskCache(const QString &fileName)
+    : m_fileName(fileName)
+{
+}
+
+QSGDistanceFieldDiskCache::~QSGDistanceFieldDiskCache()
+{
+    if (m_data)
+        m_file.unmap(const_cast<uchar *>(m_data));
+}
+
+QSharedPointer<QSGDistanceFieldDiskCache> QSGDistanceFieldDiskCache::cacheForFont(const QRawFont &referenceFont,
+                                                                                  bool doubleGlyphResolution)
+{
+    if (qsgDisableDistanceFieldDiskCache())
+        return {};
+
+    // The head table has a checksum of the whole font file, which is as
+    // good as hashing the file itself. Fonts without one are not sfnt
+    // based and are not cached.
+    const QByteArray headTable = referenceFont.fontTable("head");
+    if (headTable.isEmpty())
+        return {};
+
+    QFontEngine *fontEngine = QRawFontPrivate::get(referenceFont)->fontEngine;
+    const quint32 parameters[] = {
+        FormatVersion,
+        quint32(QT_VERSION),
+        quint32(fontEngine->glyphCount()),
+        quint32(fontEngine->synthesized()),
+        quint32(fontEngine->fontDef.weight),
+        quint32(fontEngine->fontDef.style),
+        quint32(qRound(referenceFont.pixelSize() * 64)),
+        quint32(doubleGlyphResolution),
+        quint32(QT_DISTANCEFIELD_RADIUS(doubleGlyphResolution)),
+        quint32(QT_DISTANCEFIELD_SCALE(doubleGlyphResolution))
+    };
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(headTable);
+    hash.addData(referenceFont.fontTable("name"));
+    hash.addData(referenceFont.familyName().toUtf8());
+    hash.addData(referenceFont.styleName().toUtf8());
+    hash.addData(QByteArrayView(reinterpret_cast<const char *>(parameters), sizeof(parameters)));
+    const auto &axes = fontEngine->fontDef.variableAxisValues;
+    for (auto it = axes.cbegin(), end = axes.cend(); it != end; ++it) {
+        const quint32 tag = it.key().value();
+        const float value = it.value();
+        hash.addData(QByteArrayView(reinterpret_cast<const char *>(&tag), sizeof(tag)));
+        hash.addData(QByteArrayView(reinterpret_cast<const char *>(&value), sizeof(value)));
+    }
+
+    QMutexLocker locker(qsg_diskCacheMutex());
+
+    const QString directory = qsg_diskCacheDirectory();
+    if (directory.isEmpty())
+        return {};
+
+    const QString fileName = directory + QString::fromLatin1(hash.result().toHex())
+            + QLatin1String(".qsgdf");
+
+    QSharedPointer<QSGDistanceFieldDiskCache> cache = qsg_diskCaches()->value(fileName).toStrongRef();
+    if (!cache) {
+        cache.reset(new QSGDistanceFieldDiskCache(fileName));
+        cache->load();
+        qsg_diskCaches()->insert(fileName, cache);
+    }
+    return cache;
+}
+
+void QSGDistanceFieldDiskCache::load()
+{
+    m_file.setFileName(m_fileName);
+    if (!m_file.open(QIODevice::ReadOnly))
+        return;
+
+    m_loadedSize = m_file.size();
+    if (m_loadedSize < qint64(sizeof(FileHeader)))
+        return;
+
+    const uchar *data = m_file.map(0, m_loadedSize);
+    if (!data)
+        return;
+
+    FileHeader fileHeader;
+    memcpy(&fileHeader, data, sizeof(FileHeader));
+    if (fileHeader.magic != MagicNumber || fileHeader.version != FormatVersion) {
+        m_file.unmap(const_cast<uchar *>(data));
+        return;
+    }
+
+    // Only the headers are read here, the distance fields are read on use.
+    // A glyph cut short, e.g. because the process writing it was killed,
+    // ends the file, the next write truncates it there.
+    qint64 offset = sizeof(FileHeader);
+    while (m_loadedSize - offset >= qint64(sizeof(GlyphHeader))) {
+        GlyphHeader header;
+        memcpy(&header, data + offset, sizeof(GlyphHeader));
+        const qint64 size = recordSize(header);
+        if (m_loadedSize - offset < size)
+            break;
+        m_offsets.insert(header.glyph, offset);
+        offset += size;
+    }
+
+    m_data = data;
+    m_validSize = offset;
+}
+
+QDistanceField QSGDistanceFieldDiskCache::glyph(glyph_t glyph) const
+{
+    const qint64 offset = m_offsets.value(glyph, -1);
+    if (offset < 0)
+        return QDistanceField();
+
+    GlyphHeader header;
+    memcpy(&header, m_data + offset, sizeof(GlyphHeader));
+    const uchar *bits = m_data + offset + sizeof(GlyphHeader);
+    const qsizetype byteCount = qsizetype(header.width) * header.height;
+    if (checksum(bits, byteCount) != header.checksum)
+        return QDistanceField();
+
+    QDistanceFieldData *d = QDistanceFieldData::create(QSize(header.width, header.height));
+    d->glyph = glyph;
+    memcpy(d->data, bits, byteCount);
+    return QDistanceField(d);
+}
+
+void QSGDistanceFieldDiskCache::storeGlyphs(const QList<QDistanceField> &glyphs)
+{
+    QList<QDistanceField> newGlyphs;
+    {
+        QMutexLocker locker(&m_mutex);
+        for (const QDistanceField &field : glyphs) {
+            if (field.isNull() || field.width() > 0xffff || field.height() > 0xffff)
+                continue;
+            const glyph_t glyph = field.glyph();
+            if (m_offsets.contains(glyph) || m_storedGlyphs.contains(glyph))
+                continue;
+            m_storedGlyphs.insert(glyph);
+            newGlyphs.append(field);
+        }
+    }
+
+    if (newGlyphs.isEmpty())
+        return;
+
+    QSharedPointer<QSGDistanceFieldDiskCache> self = sharedFromThis();
+    qsg_diskCacheWriter()->start([self, newGlyphs]() {
+        self->write(newGlyphs);
+    });
+}
+
+void QSGDistanceFieldDiskCache::write(const QList<QDistanceField> &glyphs)
+{
+    QByteArray buffer;
+    for (const QDistanceField &field : glyphs) {
+        GlyphHeader header;
+        header.glyph = field.glyph();
+        header.width = quint16(field.width());
+        header.height = quint16(field.height());
+        header.checksum = checksum(field.constBits(), qsizetype(header.width) * header.height);
+
+        const qsizetype offset = buffer.size();
+        buffer.resize(offset + recordSize(header), 0);
+        memcpy(buffer.data() + offset, &header, sizeof(GlyphHeader));
+        memcpy(buffer.data() + offset + sizeof(GlyphHeader), field.constBits(),
+               qsizetype(header.width) * header.height);
+    }
+
+    // Other processes using the same font may be writing too
+    QLockFile lock(m_fileName + QLatin1String(".lck"));
+    if (!lock.lock())
+        return;
+
+    QFile file(m_fileName);
+    if (!file.open(QIODevice::ReadWrite))
+        return;
+
+    qint64 size = file.size();
+    if (size == m_loadedSize && m_validSize < m_loadedSize) {
+        // Unchanged since it was loaded, drop what couldn't be read
+        if (!file.resize(m_validSize))
+            return;
+        size = m_validSize;
+    }
+
+    if (size < qint64(sizeof(FileHeader))) {
+        const FileHeader fileHeader = { MagicNumber, FormatVersion };
+        if (!file.resize(0) || file.write(reinterpret_cast<const char *>(&fileHeader), sizeof(FileHeader)) != qint64(sizeof(FileHeader)))
+            return;
+        size = sizeof(FileHeader);
+    }
+
+    if (size + buffer.size() > MaxFileSize)
+        return;
+
+    if (file.seek(size))
+        file.write(buffer);
+
+    m_loadedSize = m_validSize = file.size();
+}
+
+QT_END_NAMESPACE
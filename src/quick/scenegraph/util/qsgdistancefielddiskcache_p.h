@@ -0,0 +1,74 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSGDISTANCEFIELDDISKCACHE_P_H
+#define QSGDISTANCEFIELDDISKCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of a number of Qt sources files.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtGui/private/qdistancefield_p.h>
+
+#include <QtQuick/qtquickexports.h>
+
+QT_BEGIN_NAMESPACE
+
+class QRawFont;
+
+// Distance fields generated at runtime, kept in a file per font and
+// distance field parameters. The file is mapped when the cache is created,
+// glyphs generated later are appended to it on a worker thread, so they are
+// only available to the next process using the font.
+class Q_QUICK_EXPORT QSGDistanceFieldDiskCache
+        : public QEnableSharedFromThis<QSGDistanceFieldDiskCache>
+{
+public:
+    ~QSGDistanceFieldDiskCache();
+
+    // Returns null when the disk cache is disabled or the font can't be
+    // identified. referenceFont has to have the pixel size the distance
+    // fields are generated with.
+    static QSharedPointer<QSGDistanceFieldDiskCache> cacheForFont(const QRawFont &referenceFont,
+                                                                  bool doubleGlyphResolution);
+
+    QString fileName() const { return m_fileName; }
+
+    // Both are safe to call from several render threads
+    QDistanceField glyph(glyph_t glyph) const;
+    void storeGlyphs(const QList<QDistanceField> &glyphs);
+
+private:
+    explicit QSGDistanceFieldDiskCache(const QString &fileName);
+
+    void load();
+    void write(const QList<QDistanceField> &glyphs);
+
+    QString m_fileName;
+    QFile m_file;
+    const uchar *m_data = nullptr;
+    QHash<glyph_t, qint64> m_offsets;
+
+    // Only touched by the writer thread after loading
+    qint64 m_loadedSize = 0;
+    qint64 m_validSize = 0;
+
+    QMutex m_mutex;
+    QSet<glyph_t> m_storedGlyphs;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSGDISTANCEFIELDDISKCACHE_P_H
@@ -183,6 +183,12 @@ public:
         SceneGraphPolishAndSyncAnimations
     };
 
+    enum SceneGraphFrameLatencyStage {
+        SceneGraphFrameLatencyStart,
+        SceneGraphFrameLatencyDefer,
+        SceneGraphFrameLatencySync
+    };
+
     enum SceneGraphTexturePrepareStage {
         SceneGraphTexturePrepareStart,
         SceneGraphTexturePrepareBind,
@@ -278,7 +278,7 @@ void QQuickPropertyChangesPrivate::decodeBinding(const QString &propertyPrefix,
                         new QQmlBoundSignalExpression(
                             prop.object(), QQmlPropertyPrivate::get(prop)->signalIndex(),
                             QQmlContextData::get(qmlContext(q)), prop.object(),
-                            compilationUnit->runtimeFunctions.at(binding->value.compiledScriptIndex)));
+                            compilationUnit->runtimeFunction(binding->value.compiledScriptIndex)));
             signalReplacements << handler;
             return;
         }
@@ -478,7 +478,7 @@ QQuickPropertyChanges::ActionList QQuickPropertyChanges::actions()
                 if (e.binding && e.binding->isTranslationBinding()) {
                     newBinding.reset(QQmlBinding::createTranslationBinding(d->compilationUnit, e.binding, object(), context));
                 } else if (e.id != QQmlBinding::Invalid) {
-                    newBinding.reset(QQmlBinding::create(&QQmlPropertyPrivate::get(prop)->core, d->compilationUnit->runtimeFunctions.at(e.id), object(), context, qmlCtxt));
+                    newBinding.reset(QQmlBinding::create(&QQmlPropertyPrivate::get(prop)->core, d->compilationUnit->runtimeFunction(e.id), object(), context, qmlCtxt));
                 } else {
                     newBinding.reset(QQmlBinding::create(&QQmlPropertyPrivate::get(prop)->core, e.expression, object(), context, e.url.toString(), e.line));
                 }
@@ -489,7 +489,7 @@ QQuickPropertyChanges::ActionList QQuickPropertyChanges::actions()
                     newBinding = QQmlAnyBinding::createTranslationBinding(prop, d->compilationUnit, e.binding, object(), context);
                 } else if (e.id != QQmlBinding::Invalid) {
                     newBinding = QQmlAnyBinding::createFromFunction(prop,
-                                                                       d->compilationUnit->runtimeFunctions.at(e.id),
+                                                                       d->compilationUnit->runtimeFunction(e.id),
                                                                        object(), context, qmlCtxt);
                 } else {
                     newBinding = QQmlAnyBinding::createFromCodeString(prop, e.expression, object(), context, e.url.toString(), e.line);
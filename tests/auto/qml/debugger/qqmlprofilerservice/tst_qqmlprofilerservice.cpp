@@ -125,6 +125,8 @@ void QQmlProfilerTestClient::addEvent(const QQmlProfilerEvent &event)
         jsHeapMessages.append(event);
         break;
     case DebugMessage:
+    case Quick3DFrame:
+    case BindingStatistics:
         // Unhandled
         break;
     case MaximumMessage:
@@ -193,6 +195,7 @@ private:
                 const QVector<qint64> &expectedNumbers);
 
     QList<QQmlDebugClient *> createClients() override;
+    QQmlDebugProcess *createProcess(const QString &executable) override;
     QScopedPointer<QQmlProfilerTestClient> m_client;
 
 private slots:
@@ -202,6 +205,7 @@ private slots:
     void connect();
     void pixmapCacheData();
     void scenegraphData();
+    void scenegraphFrameLatency();
     void profileOnExit();
     void controlFromJS();
     void signalSourceLocation();
@@ -217,6 +221,7 @@ private:
     bool m_recordFromStart = true;
     bool m_flushInterval = false;
     bool m_isComplete = false;
+    QStringList m_environment;
 
     // Don't use ({...}) here as MSVC will interpret that as the "QVector(int size)" ctor.
     const QVector<qint64> m_rangeStart = (QVector<qint64>() << RangeStart);
@@ -458,6 +463,14 @@ QList<QQmlDebugClient *> tst_QQmlProfilerService::createClients()
     return QList<QQmlDebugClient *>({m_client->client});
 }
 
+QQmlDebugProcess *tst_QQmlProfilerService::createProcess(const QString &executable)
+{
+    QQmlDebugProcess *process = QQmlDebugTest::createProcess(executable);
+    for (const QString &environment : std::as_const(m_environment))
+        process->addEnvironment(environment);
+    return process;
+}
+
 void tst_QQmlProfilerService::cleanup()
 {
     auto log = [this](const QQmlProfilerEvent &data, int i) {
@@ -503,6 +516,7 @@ void tst_QQmlProfilerService::cleanup()
     }
 
     m_client.reset();
+    m_environment.clear();
     QQmlDebugTest::cleanup();
 }
 
@@ -606,6 +620,38 @@ void tst_QQmlProfilerService::scenegraphData()
     QVERIFY(renderFrameTime != -1);
 }
 
+void tst_QQmlProfilerService::scenegraphFrameLatency()
+{
+    const QByteArray backend = qgetenv("QT_QUICK_BACKEND") + qgetenv("QMLSCENE_DEVICE");
+    if (backend.contains("software"))
+        QSKIP("The latency is only reported by the threaded render loop of the RHI backend");
+
+    m_environment << QLatin1String("QSG_RENDER_LOOP=threaded")
+                  << QLatin1String("QSG_LOW_LATENCY=1");
+    QCOMPARE(connectTo(true, "scenegraphTest.qml"), ConnectSuccess);
+
+    while (!m_process->output().contains(QLatin1String("tick")))
+        QVERIFY(QQmlDebugTest::waitForSignal(m_process, SIGNAL(readyReadStandardOutput())));
+    m_client->client->setRecording(false);
+
+    checkTraceReceived();
+
+    // The time the sync was deferred by, the time spent polishing and
+    // syncing, and the time from then until the frame is presented
+    int latencyFrames = 0;
+    for (const QQmlProfilerEvent &msg : std::as_const(m_client->asynchronousMessages)) {
+        const QQmlProfilerEventType &type = m_client->types.at(msg.typeIndex());
+        if (type.message() != SceneGraphFrame || type.detailType() != SceneGraphFrameLatency)
+            continue;
+        const QVector<qint64> numbers = msg.numbers<QVector<qint64>>();
+        QCOMPARE(numbers.size(), 3);
+        for (qint64 number : numbers)
+            QCOMPARE_GE(number, 0);
+        ++latencyFrames;
+    }
+    QCOMPARE_GT(latencyFrames, 0);
+}
+
 void tst_QQmlProfilerService::profileOnExit()
 {
     QCOMPARE(connectTo(true, "exit.qml"), ConnectSuccess);
@@ -0,0 +1,14 @@
+import QtQml
+
+QtObject {
+    property int value: 5 + 5
+    onValueChanged: function() { console.log(value) }
+
+    function typed(a: int): int {
+        return a + 1;
+    }
+
+    function untyped(a) {
+        return a + 1;
+    }
+}
@@ -10,6 +10,10 @@
 #include <QStandardPaths>
 #include <QSysInfo>
 #include <QLoggingCategory>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDirIterator>
 #include <private/qqmlcomponent_p.h>
 #include <private/qqmlscriptdata_p.h>
 #include <private/qv4compileddata_p.h>
@@ -67,6 +71,10 @@ private slots:
 
     void scriptStringCachegenInteraction();
     void saveableUnitPointer();
+    void aotReport();
+    void compilationCache();
+    void batchMode();
+    void batchModeImportWarnings();
 };
 
 // A wrapper around QQmlComponent to ensure the temporary reference counts
@@ -895,6 +903,354 @@ void tst_qmlcachegen::saveableUnitPointer()
     QCOMPARE(unit.flags, flags);
 }
 
+void tst_qmlcachegen::aotReport()
+{
+#if defined(QTEST_CROSS_COMPILED)
+    QSKIP("You cannot call qmlcachegen on the target.");
+#endif
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    QProcess proc;
+    proc.setProcessChannelMode(QProcess::ForwardedChannels);
+    proc.setProgram(QLibraryInfo::path(QLibraryInfo::LibraryExecutablesPath)
+                    + QLatin1String("/qmlcachegen"));
+    proc.setArguments({
+            QStringLiteral("--resource-path"), QStringLiteral("/aotReport.qml"),
+            QStringLiteral("--aot-report"),
+            QStringLiteral("-o"), tempDir.filePath(QStringLiteral("aotReport.cpp")),
+            testFile("aotReport.qml") });
+    proc.start();
+    QVERIFY(proc.waitForFinished());
+    QCOMPARE(proc.exitStatus(), QProcess::NormalExit);
+    QCOMPARE(proc.exitCode(), 0);
+
+    QFile reportFile(tempDir.filePath(QStringLiteral("aotReport.aotreport.json")));
+    QVERIFY(reportFile.open(QIODevice::ReadOnly));
+    const QJsonObject report = QJsonDocument::fromJson(reportFile.readAll()).object();
+    QCOMPARE(report[QStringLiteral("file")].toString(), QStringLiteral("/aotReport.qml"));
+
+    const QJsonArray functions = report[QStringLiteral("functions")].toArray();
+    QCOMPARE(functions.size(), 5);
+
+    QHash<QString, QJsonObject> byName;
+    QList<QJsonObject> signalHandlers;
+    for (const QJsonValue &function : functions) {
+        const QString name = function[QStringLiteral("name")].toString();
+        if (name == QStringLiteral("onValueChanged"))
+            signalHandlers.append(function.toObject());
+        else
+            byName.insert(name, function.toObject());
+    }
+
+    const QJsonObject value = byName.value(QStringLiteral("value"));
+    QCOMPARE(value[QStringLiteral("kind")].toString(), QStringLiteral("binding"));
+    QVERIFY(value[QStringLiteral("compiled")].toBool());
+    QCOMPARE(value[QStringLiteral("line")].toInt(), 4);
+
+    const QJsonObject typed = byName.value(QStringLiteral("typed"));
+    QCOMPARE(typed[QStringLiteral("kind")].toString(), QStringLiteral("function"));
+    QVERIFY(typed[QStringLiteral("compiled")].toBool());
+    QVERIFY(!typed.contains(QStringLiteral("rejection")));
+
+    const QJsonObject untyped = byName.value(QStringLiteral("untyped"));
+    QCOMPARE(untyped[QStringLiteral("kind")].toString(), QStringLiteral("function"));
+    QVERIFY(!untyped[QStringLiteral("compiled")].toBool());
+    QVERIFY(!untyped[QStringLiteral("rejection")][QStringLiteral("message")].toString().isEmpty());
+
+    // The handler returning a closure is listed as not compiled, next to the
+    // closure itself.
+    QCOMPARE(signalHandlers.size(), 2);
+    const auto handler = std::find_if(
+            signalHandlers.cbegin(), signalHandlers.cend(), [](const QJsonObject &entry) {
+        return !entry[QStringLiteral("compiled")].toBool();
+    });
+    QVERIFY(handler != signalHandlers.cend());
+    QCOMPARE((*handler)[QStringLiteral("kind")].toString(), QStringLiteral("binding"));
+    QCOMPARE((*handler)[QStringLiteral("line")].toInt(), 5);
+    QVERIFY(!(*handler)[QStringLiteral("rejection")][QStringLiteral("message")].toString().isEmpty());
+}
+
+void tst_qmlcachegen::compilationCache()
+{
+#if defined(QTEST_CROSS_COMPILED)
+    QSKIP("You cannot call qmlcachegen on the target.");
+#endif
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString cacheDir = tempDir.filePath(QStringLiteral("cache"));
+    const QString outputFile = tempDir.filePath(QStringLiteral("aotReport.cpp"));
+
+    const auto runQmlcachegen = [&]() {
+        QProcess proc;
+        proc.setProcessChannelMode(QProcess::ForwardedChannels);
+        proc.setProgram(QLibraryInfo::path(QLibraryInfo::LibraryExecutablesPath)
+                        + QLatin1String("/qmlcachegen"));
+        proc.setArguments({
+                QStringLiteral("--resource-path"), QStringLiteral("/aotReport.qml"),
+                QStringLiteral("--cache-dir"), cacheDir,
+                QStringLiteral("-o"), outputFile,
+                testFile("aotReport.qml") });
+        proc.start();
+        return proc.waitForFinished() && proc.exitStatus() == QProcess::NormalExit
+                && proc.exitCode() == 0;
+    };
+
+    const auto readFile = [](const QString &fileName) {
+        QFile file(fileName);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    };
+
+    QVERIFY(runQmlcachegen());
+    const QByteArray generated = readFile(outputFile);
+    QVERIFY(!generated.isEmpty());
+
+    QStringList entries;
+    QDirIterator it(cacheDir, { QStringLiteral("*.cpp") }, QDir::Files,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext())
+        entries.append(it.next());
+    QCOMPARE(entries.size(), 1);
+    QCOMPARE(readFile(entries.first()), generated);
+
+    // A second run with the same input produces its output from the cache entry.
+    QFile entry(entries.first());
+    QVERIFY(entry.open(QIODevice::WriteOnly | QIODevice::Append));
+    entry.write("// from cache\n");
+    entry.close();
+    QVERIFY(QFile::remove(outputFile));
+
+    QVERIFY(runQmlcachegen());
+    QCOMPARE(readFile(outputFile), generated + "// from cache\n");
+
+    // A document using an imported module. Its key has to follow the interfaces of the
+    // module's types, but not their implementations.
+    const QString moduleDir = tempDir.filePath(QStringLiteral("imports/CacheKeyModule"));
+    QVERIFY(QDir().mkpath(moduleDir));
+
+    const auto writeFile = [](const QString &fileName, const QByteArray &contents) {
+        QFile file(fileName);
+        return file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+                && file.write(contents) == contents.size();
+    };
+
+    const QByteArray qmldir = "module CacheKeyModule\n"
+                              "typeinfo plugins.qmltypes\n"
+                              "Derived 1.0 Derived.qml\n";
+    const QByteArray qmltypes = "import QtQuick.tooling 1.2\n"
+                                "Module {\n"
+                                "    Component {\n"
+                                "        file: \"base.h\"\n"
+                                "        name: \"Base\"\n"
+                                "        accessSemantics: \"reference\"\n"
+                                "        prototype: \"QObject\"\n"
+                                "        exports: [\"CacheKeyModule/Base 1.0\"]\n"
+                                "        exportMetaObjectRevisions: [256]\n"
+                                "        Property { name: \"count\"; type: \"int\"; index: 0 }\n"
+                                "%1"
+                                "    }\n"
+                                "}\n";
+    const QByteArray derived = "import QtQml\n"
+                               "import CacheKeyModule\n"
+                               "Base {\n"
+                               "    count: %1\n"
+                               "    function twice(): int { return %2 }\n"
+                               "}\n";
+
+    QVERIFY(writeFile(moduleDir + QStringLiteral("/qmldir"), qmldir));
+    QVERIFY(writeFile(moduleDir + QStringLiteral("/plugins.qmltypes"),
+                      QByteArray(qmltypes).replace("%1", "")));
+    QVERIFY(writeFile(moduleDir + QStringLiteral("/Derived.qml"),
+                      QByteArray(derived).replace("%1", "1").replace("%2", "count * 2")));
+
+    const QString userFile = tempDir.filePath(QStringLiteral("user.qml"));
+    QVERIFY(writeFile(userFile, "import QtQml\n"
+                                "import CacheKeyModule\n"
+                                "Derived {\n"
+                                "    property int quadruple: twice() * 2\n"
+                                "}\n"));
+
+    const QString userOutputFile = tempDir.filePath(QStringLiteral("user.cpp"));
+    const auto runOnUser = [&]() {
+        QProcess proc;
+        proc.setProcessChannelMode(QProcess::ForwardedChannels);
+        proc.setProgram(QLibraryInfo::path(QLibraryInfo::LibraryExecutablesPath)
+                        + QLatin1String("/qmlcachegen"));
+        proc.setArguments({
+                QStringLiteral("--resource-path"), QStringLiteral("/user.qml"),
+                QStringLiteral("--cache-dir"), cacheDir,
+                QStringLiteral("-I"), tempDir.filePath(QStringLiteral("imports")),
+                QStringLiteral("-o"), userOutputFile,
+                userFile });
+        proc.start();
+        return proc.waitForFinished() && proc.exitStatus() == QProcess::NormalExit
+                && proc.exitCode() == 0;
+    };
+
+    const auto countEntries = [&]() {
+        int count = 0;
+        QDirIterator it(cacheDir, { QStringLiteral("*.cpp") }, QDir::Files,
+                        QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            it.next();
+            ++count;
+        }
+        return count;
+    };
+
+    QVERIFY(runOnUser());
+    QCOMPARE(countEntries(), 2);
+
+    // Changing only the binding and the function body of Derived keeps the key.
+    QVERIFY(writeFile(moduleDir + QStringLiteral("/Derived.qml"),
+                      QByteArray(derived).replace("%1", "2").replace("%2", "count + count")));
+    QVERIFY(runOnUser());
+    QCOMPARE(countEntries(), 2);
+
+    // A new property in the qmltypes of the base type changes the interface.
+    QVERIFY(writeFile(moduleDir + QStringLiteral("/plugins.qmltypes"),
+                      QByteArray(qmltypes).replace(
+                              "%1", "        Property { name: \"label\"; type: \"QString\"; "
+                                    "index: 1 }\n")));
+    QVERIFY(runOnUser());
+    QCOMPARE(countEntries(), 3);
+
+    // So does a new version of Derived in the qmldir.
+    QVERIFY(writeFile(moduleDir + QStringLiteral("/qmldir"),
+                      qmldir + "Derived 1.1 Derived.qml\n"));
+    QVERIFY(runOnUser());
+    QCOMPARE(countEntries(), 4);
+}
+
+void tst_qmlcachegen::batchMode()
+{
+#if defined(QTEST_CROSS_COMPILED)
+    QSKIP("You cannot call qmlcachegen on the target.");
+#endif
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QStringList inputs = {
+        QStringLiteral("aotReport.qml"), QStringLiteral("componentInItem.qml"),
+        QStringLiteral("Enums.qml"), QStringLiteral("script.js")
+    };
+
+    const auto runQmlcachegen = [](const QStringList &arguments) {
+        QProcess proc;
+        proc.setProcessChannelMode(QProcess::ForwardedChannels);
+        proc.setProgram(QLibraryInfo::path(QLibraryInfo::LibraryExecutablesPath)
+                        + QLatin1String("/qmlcachegen"));
+        proc.setArguments(arguments);
+        proc.start();
+        return proc.waitForFinished() && proc.exitStatus() == QProcess::NormalExit
+                && proc.exitCode() == 0;
+    };
+
+    const auto readFile = [](const QString &fileName) {
+        QFile file(fileName);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    };
+
+    QHash<QString, QByteArray> batches;
+    for (const QString &input : inputs) {
+        const QString resourcePath = u'/' + input;
+        const QString single = tempDir.filePath(input + QStringLiteral(".single.cpp"));
+        QVERIFY(runQmlcachegen({
+                QStringLiteral("--resource-path"), resourcePath,
+                QStringLiteral("-o"), single, testFile(input) }));
+
+        for (const QString &mode : { QStringLiteral("serial"), QStringLiteral("parallel") }) {
+            batches[mode] += (testFile(input) + u'\t' + resourcePath + u'\t'
+                              + tempDir.filePath(input + u'.' + mode + QStringLiteral(".cpp"))
+                              + u'\n').toUtf8();
+        }
+    }
+
+    const auto runBatch = [&](const QString &mode, int jobs) {
+        const QString batchFileName = tempDir.filePath(mode + QStringLiteral(".txt"));
+        QFile batchFile(batchFileName);
+        if (!batchFile.open(QIODevice::WriteOnly) || batchFile.write(batches[mode]) < 0)
+            return false;
+        batchFile.close();
+        return runQmlcachegen({
+                QStringLiteral("--batch"), batchFileName,
+                QStringLiteral("--jobs"), QString::number(jobs) });
+    };
+
+    QVERIFY(runBatch(QStringLiteral("serial"), 1));
+    QVERIFY(runBatch(QStringLiteral("parallel"), 4));
+
+    for (const QString &input : inputs) {
+        const QByteArray single = readFile(tempDir.filePath(input + QStringLiteral(".single.cpp")));
+        QVERIFY(!single.isEmpty());
+        QCOMPARE(readFile(tempDir.filePath(input + QStringLiteral(".serial.cpp"))), single);
+        QCOMPARE(readFile(tempDir.filePath(input + QStringLiteral(".parallel.cpp"))), single);
+    }
+}
+
+void tst_qmlcachegen::batchModeImportWarnings()
+{
+#if defined(QTEST_CROSS_COMPILED)
+    QSKIP("You cannot call qmlcachegen on the target.");
+#endif
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const auto writeFile = [](const QString &fileName, const QByteArray &contents) {
+        QFile file(fileName);
+        return file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+                && file.write(contents) == contents.size();
+    };
+
+    // The qmldir lists a missing file, which is reported when importing the module, and
+    // doesn't declare a singleton, which is reported when loading the type.
+    const QString moduleDir = tempDir.filePath(QStringLiteral("imports/WarningModule"));
+    QVERIFY(QDir().mkpath(moduleDir));
+    QVERIFY(writeFile(moduleDir + QStringLiteral("/qmldir"),
+                      "module WarningModule\n"
+                      "Single 1.0 Single.qml\n"
+                      "Missing 1.0 Missing.qml\n"));
+    QVERIFY(writeFile(moduleDir + QStringLiteral("/Single.qml"),
+                      "pragma Singleton\n"
+                      "import QtQml\n"
+                      "QtObject {}\n"));
+
+    const QStringList inputs = {
+        QStringLiteral("first.qml"), QStringLiteral("second.qml"), QStringLiteral("third.qml")
+    };
+
+    QByteArray batch;
+    for (const QString &input : inputs) {
+        const QString inputFile = tempDir.filePath(input);
+        QVERIFY(writeFile(inputFile, "import QtQml\n"
+                                     "import WarningModule\n"
+                                     "Single {}\n"));
+        batch += (inputFile + QStringLiteral("\t/") + input + u'\t'
+                  + tempDir.filePath(input + QStringLiteral(".cpp")) + u'\n').toUtf8();
+    }
+
+    const QString batchFileName = tempDir.filePath(QStringLiteral("batch.txt"));
+    QVERIFY(writeFile(batchFileName, batch));
+
+    // A single worker loads the module only once, but each file reports its warnings.
+    QProcess proc;
+    proc.setProgram(QLibraryInfo::path(QLibraryInfo::LibraryExecutablesPath)
+                    + QLatin1String("/qmlcachegen"));
+    proc.setArguments({
+            QStringLiteral("--verbose"),
+            QStringLiteral("-I"), tempDir.filePath(QStringLiteral("imports")),
+            QStringLiteral("--batch"), batchFileName,
+            QStringLiteral("--jobs"), QStringLiteral("1") });
+    proc.start();
+    QVERIFY(proc.waitForFinished());
+    QCOMPARE(proc.exitStatus(), QProcess::NormalExit);
+
+    const QByteArray output = proc.readAllStandardError();
+    QCOMPARE(output.count("Missing.qml is listed as component"), inputs.size());
+    QCOMPARE(output.count("but using pragma Singleton"), inputs.size());
+}
+
 const QQmlScriptString &ScriptStringProps::undef() const
 {
     return m_undef;
@@ -85,8 +85,11 @@ QtObject {
 
     property unconstructibleWithLength uwl: 12 + 1
 
-    // Cannot generate code for getters
-    property rect r3: ({ get x() { return 42; }, y: 4 })
+    // Cannot generate code for getters that capture locals
+    property rect r3: {
+        const k = 42;
+        return { get x() { return k; }, y: 4 };
+    }
 
     property int nonIterable: {
         var result = 1;
@@ -0,0 +1,51 @@
+pragma ComponentBehavior: Bound
+
+import QtQml
+
+QtObject {
+    id: root
+    objectName: "root"
+
+    property string plain: root.objectName
+
+    property Component nested: Component {
+        QtObject {
+            objectName: "nested"
+            property string outer: root.objectName
+        }
+    }
+    property QtObject nestedObject: nested.createObject()
+
+    // The id is declared again in the inner component, which hides the outer one
+    property Component shadowing: Component {
+        QtObject {
+            id: root
+            objectName: "shadowing"
+            property string own: root.objectName
+            property Component deeper: Component {
+                QtObject {
+                    property string outer: root.objectName
+                }
+            }
+            property QtObject deeperObject: deeper.createObject()
+        }
+    }
+    property QtObject shadowingObject: shadowing.createObject()
+
+    property Instantiator delegates: Instantiator {
+        model: 2
+        delegate: QtObject {
+            id: root
+            required property int index
+            objectName: "delegate" + index
+            property string own: root.objectName
+        }
+    }
+
+    component Inner: QtObject {
+        id: root
+        objectName: "inner"
+        property string own: root.objectName
+    }
+    property Inner inner: Inner {}
+}
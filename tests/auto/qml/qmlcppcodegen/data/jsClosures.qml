@@ -0,0 +1,17 @@
+import QtQml
+import "script.js" as Script
+
+QtObject {
+    function twice(x: int): int {
+        const f = (a) => a * 2;
+        return f(x);
+    }
+
+    function parse(s: string): int {
+        return parseInt(s);
+    }
+
+    function fromScript(): int {
+        return Script.getter();
+    }
+}
@@ -0,0 +1,21 @@
+import QtQml
+
+QtObject {
+    function computed(key: string): var {
+        return { [key]: 5, plain: 3 };
+    }
+
+    function withGetter(): var {
+        return { get x() { return 7; } };
+    }
+
+    function withMethod(): var {
+        return { twice(a) { return a * 2; } };
+    }
+
+    function dynamicWrite(target: var) {
+        target.foo = 12;
+    }
+
+    property rect withGetterRect: ({ get x() { return 42; }, y: 4 })
+}
@@ -0,0 +1,49 @@
+import QtQml
+
+QtObject {
+    property int caught: 0
+    property string lastError
+
+    function check(value: int): real {
+        try {
+            if (value < 0)
+                throw "negative";
+            return value * 2;
+        } catch (e) {
+            ++caught;
+            lastError = e;
+            return -1;
+        }
+    }
+
+    function nested(fail: bool): string {
+        let result = "a";
+        try {
+            try {
+                result += "b";
+                if (fail)
+                    throw "inner";
+                result += "c";
+            } catch (inner) {
+                result += "d";
+                throw "outer";
+            }
+        } catch (outer) {
+            result += "e";
+        }
+        return result;
+    }
+
+    function firstFailure(limit: int): int {
+        let index = 0;
+        for (; index < limit; ++index) {
+            try {
+                if (index === 3)
+                    throw index;
+            } catch (e) {
+                break;
+            }
+        }
+        return index;
+    }
+}
@@ -117,6 +117,7 @@ private slots:
     void getOptionalLookupShadowed();
     void globals();
     void idAccess();
+    void idLookupsInContexts();
     void ignoredFunctionReturn();
     void importsFromImportPath();
     void inPlaceDecrement();
@@ -142,6 +143,7 @@ private slots:
     void jsArrayMethods();
     void jsArrayMethodsWithParams();
     void jsArrayMethodsWithParams_data();
+    void jsClosures();
     void jsImport();
     void jsMathObject();
     void jsmoduleImport();
@@ -174,6 +176,7 @@ private slots:
     void nullComparison();
     void numbersInJsPrimitive();
     void objectInVar();
+    void objectLiteralsComplex();
     void objectLookupOnListElement();
     void objectToString();
     void objectWithStringListMethod();
@@ -223,6 +226,7 @@ private slots:
     void topLevelComponent();
     void translation();
     void trivialSignalHandler();
+    void tryCatch();
     void typePropagationLoop();
     void typePropertyClash();
     void typedArray();
@@ -255,6 +259,25 @@ namespace QmlCacheGeneratedCode {
 namespace _qt_qml_TestTypes_failures_qml {
 extern const QQmlPrivate::AOTCompiledFunction aotBuiltFunctions[];
 }
+namespace _qt_qml_TestTypes_jsClosures_qml {
+extern const QQmlPrivate::AOTCompiledFunction aotBuiltFunctions[];
+}
+namespace _qt_qml_TestTypes_objectLiteralsComplex_qml {
+extern const QQmlPrivate::AOTCompiledFunction aotBuiltFunctions[];
+}
+namespace _qt_qml_TestTypes_tryCatch_qml {
+extern const QQmlPrivate::AOTCompiledFunction aotBuiltFunctions[];
+}
+}
+
+// The list is terminated by an entry without function
+static bool isAotCompiled(const QQmlPrivate::AOTCompiledFunction *functions, qintptr index)
+{
+    for (; functions->functionPtr; ++functions) {
+        if (functions->extraData == index)
+            return true;
+    }
+    return false;
 }
 
 static void checkColorProperties(QQmlComponent *component)
@@ -2227,6 +2250,54 @@ void tst_QmlCppCodegen::idAccess()
     QCOMPARE(f.pointSize(), 22);
 }
 
+void tst_QmlCppCodegen::idLookupsInContexts()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, QUrl(u"qrc:/qt/qml/TestTypes/idLookupsInContexts.qml"_s));
+    QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY(!object.isNull());
+
+    // QQmlExpression is never compiled ahead of time, it resolves the id by name
+    const auto check = [](QObject *o, const char *property, const QString &expected) {
+        QVERIFY(o);
+        QQmlExpression expression(qmlContext(o), o, u"root.objectName"_s);
+        const QVariant interpreted = expression.evaluate();
+        QVERIFY(!expression.hasError());
+        QCOMPARE(o->property(property).toString(), expected);
+        QCOMPARE(o->property(property), interpreted);
+    };
+
+    check(object.data(), "plain", u"root"_s);
+
+    QObject *nested = object->property("nestedObject").value<QObject *>();
+    check(nested, "outer", u"root"_s);
+
+    QObject *shadowing = object->property("shadowingObject").value<QObject *>();
+    check(shadowing, "own", u"shadowing"_s);
+    QObject *deeper = shadowing->property("deeperObject").value<QObject *>();
+    check(deeper, "outer", u"shadowing"_s);
+
+    QObject *delegates = object->property("delegates").value<QObject *>();
+    QVERIFY(delegates);
+    QCOMPARE(delegates->property("count").toInt(), 2);
+    for (int i = 0; i < 2; ++i) {
+        QObject *delegate = nullptr;
+        QMetaObject::invokeMethod(delegates, "objectAt", Q_RETURN_ARG(QObject *, delegate),
+                                  Q_ARG(int, i));
+        check(delegate, "own", u"delegate"_s + QString::number(i));
+    }
+
+    QObject *inner = object->property("inner").value<QObject *>();
+    check(inner, "own", u"inner"_s);
+
+    // Changing the object behind the id re-evaluates through the same lookups
+    object->setObjectName(u"renamed"_s);
+    check(object.data(), "plain", u"renamed"_s);
+    check(nested, "outer", u"renamed"_s);
+    check(deeper, "outer", u"shadowing"_s);
+}
+
 void tst_QmlCppCodegen::ignoredFunctionReturn()
 {
     QQmlEngine engine;
@@ -2767,6 +2838,34 @@ void tst_QmlCppCodegen::jsArrayMethodsWithParams_data()
     }
 }
 
+void tst_QmlCppCodegen::jsClosures()
+{
+    // twice(), parse() and fromScript() must not fall back to the interpreter.
+    // The arrow function in twice() is number 1 and stays interpreted.
+    const auto *aotFunctions = QmlCacheGeneratedCode::_qt_qml_TestTypes_jsClosures_qml::aotBuiltFunctions;
+    QVERIFY(isAotCompiled(aotFunctions, 0));
+    QVERIFY(isAotCompiled(aotFunctions, 2));
+    QVERIFY(isAotCompiled(aotFunctions, 3));
+
+    QQmlEngine engine;
+    QQmlComponent c(&engine, QUrl(u"qrc:/qt/qml/TestTypes/jsClosures.qml"_s));
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    QScopedPointer<QObject> o(c.create());
+    QVERIFY(!o.isNull());
+
+    int result = 0;
+    QVERIFY(QMetaObject::invokeMethod(
+            o.data(), "twice", Q_RETURN_ARG(int, result), Q_ARG(int, 21)));
+    QCOMPARE(result, 42);
+
+    QVERIFY(QMetaObject::invokeMethod(
+            o.data(), "parse", Q_RETURN_ARG(int, result), Q_ARG(QString, u"17"_s)));
+    QCOMPARE(result, 17);
+
+    QVERIFY(QMetaObject::invokeMethod(o.data(), "fromScript", Q_RETURN_ARG(int, result)));
+    QCOMPARE(result, 42);
+}
+
 void tst_QmlCppCodegen::jsImport()
 {
     QQmlEngine engine;
@@ -3576,6 +3675,47 @@ void tst_QmlCppCodegen::objectInVar()
     QVERIFY(!result);
 }
 
+void tst_QmlCppCodegen::objectLiteralsComplex()
+{
+    // computed(), withGetter(), withMethod(), dynamicWrite() and the binding of
+    // withGetterRect must not fall back to the interpreter. The getters and the
+    // method in the literals are numbers 2, 4 and 7 and stay interpreted.
+    const auto *aotFunctions
+            = QmlCacheGeneratedCode::_qt_qml_TestTypes_objectLiteralsComplex_qml::aotBuiltFunctions;
+    QVERIFY(isAotCompiled(aotFunctions, 0));
+    QVERIFY(isAotCompiled(aotFunctions, 1));
+    QVERIFY(isAotCompiled(aotFunctions, 3));
+    QVERIFY(isAotCompiled(aotFunctions, 5));
+    QVERIFY(isAotCompiled(aotFunctions, 6));
+
+    QQmlEngine engine;
+    QQmlComponent c(&engine, QUrl(u"qrc:/qt/qml/TestTypes/objectLiteralsComplex.qml"_s));
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    QScopedPointer<QObject> o(c.create());
+    QVERIFY(!o.isNull());
+
+    QVariant result;
+    QVERIFY(QMetaObject::invokeMethod(
+            o.data(), "computed", Q_RETURN_ARG(QVariant, result), Q_ARG(QString, u"dyn"_s)));
+    QJSValue computed = engine.toScriptValue(result);
+    QCOMPARE(computed.property(u"dyn"_s).toInt(), 5);
+    QCOMPARE(computed.property(u"plain"_s).toInt(), 3);
+
+    QVERIFY(QMetaObject::invokeMethod(o.data(), "withGetter", Q_RETURN_ARG(QVariant, result)));
+    QCOMPARE(engine.toScriptValue(result).property(u"x"_s).toInt(), 7);
+
+    QVERIFY(QMetaObject::invokeMethod(o.data(), "withMethod", Q_RETURN_ARG(QVariant, result)));
+    QJSValue withMethod = engine.toScriptValue(result);
+    QCOMPARE(withMethod.property(u"twice"_s).callWithInstance(withMethod, { 21 }).toInt(), 42);
+
+    QCOMPARE(o->property("withGetterRect").toRectF(), QRectF(42, 4, 0, 0));
+
+    QJSValue target = engine.newObject();
+    QVERIFY(QMetaObject::invokeMethod(
+            o.data(), "dynamicWrite", Q_ARG(QVariant, QVariant::fromValue(target))));
+    QCOMPARE(target.property(u"foo"_s).toInt(), 12);
+}
+
 void tst_QmlCppCodegen::objectLookupOnListElement()
 {
     QQmlEngine engine;
@@ -4451,6 +4591,52 @@ void tst_QmlCppCodegen::trivialSignalHandler()
     QCOMPARE(o->property("c").toDouble(), 2.5);
 }
 
+void tst_QmlCppCodegen::tryCatch()
+{
+    // check(), nested() and firstFailure() must not fall back to the interpreter
+    const auto *aotFunctions = QmlCacheGeneratedCode::_qt_qml_TestTypes_tryCatch_qml::aotBuiltFunctions;
+    QVERIFY(isAotCompiled(aotFunctions, 0));
+    QVERIFY(isAotCompiled(aotFunctions, 1));
+    QVERIFY(isAotCompiled(aotFunctions, 2));
+
+    QQmlEngine engine;
+    QQmlComponent c(&engine, QUrl(u"qrc:/qt/qml/TestTypes/tryCatch.qml"_s));
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    QScopedPointer<QObject> o(c.create());
+    QVERIFY(!o.isNull());
+
+    double checked = 0;
+    QVERIFY(QMetaObject::invokeMethod(
+            o.data(), "check", Q_RETURN_ARG(double, checked), Q_ARG(int, 4)));
+    QCOMPARE(checked, 8.0);
+    QCOMPARE(o->property("caught").toInt(), 0);
+
+    QVERIFY(QMetaObject::invokeMethod(
+            o.data(), "check", Q_RETURN_ARG(double, checked), Q_ARG(int, -4)));
+    QCOMPARE(checked, -1.0);
+    QCOMPARE(o->property("caught").toInt(), 1);
+    QCOMPARE(o->property("lastError").toString(), u"negative"_s);
+
+    QString nested;
+    QVERIFY(QMetaObject::invokeMethod(
+            o.data(), "nested", Q_RETURN_ARG(QString, nested), Q_ARG(bool, false)));
+    QCOMPARE(nested, u"abc"_s);
+    QVERIFY(QMetaObject::invokeMethod(
+            o.data(), "nested", Q_RETURN_ARG(QString, nested), Q_ARG(bool, true)));
+    QCOMPARE(nested, u"abde"_s);
+
+    int failure = 0;
+    QVERIFY(QMetaObject::invokeMethod(
+            o.data(), "firstFailure", Q_RETURN_ARG(int, failure), Q_ARG(int, 10)));
+    QCOMPARE(failure, 3);
+    QVERIFY(QMetaObject::invokeMethod(
+            o.data(), "firstFailure", Q_RETURN_ARG(int, failure), Q_ARG(int, 2)));
+    QCOMPARE(failure, 2);
+
+    // Nothing may be left pending once the exceptions are caught.
+    QVERIFY(!engine.hasError());
+}
+
 void tst_QmlCppCodegen::typePropagationLoop()
 {
     QQmlEngine engine;
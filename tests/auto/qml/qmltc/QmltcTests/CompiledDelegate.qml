@@ -0,0 +1,11 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick
+
+Item {
+    required property string modelData
+    property string objName: "Delegate_" + modelData
+    property bool completed: false
+    Component.onCompleted: completed = true
+}
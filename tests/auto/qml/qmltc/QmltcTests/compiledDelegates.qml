@@ -0,0 +1,88 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick
+
+Item {
+    component Cell: Item {
+        required property int index
+        property string objName: "Cell" + index
+    }
+
+    component Plain: Item {
+        property string objName: "Plain"
+        implicitWidth: 10
+        implicitHeight: 10
+    }
+
+    component TableCell: Item {
+        required property int row
+        required property int column
+        property string objName: "TableCell" + row + "_" + column
+        implicitWidth: 10
+        implicitHeight: 10
+    }
+
+    component TreeCell: Item {
+        required property int row
+        required property bool expanded
+        property string objName: "TreeCell" + row + (expanded ? "+" : "-")
+        implicitWidth: 10
+        implicitHeight: 10
+    }
+
+    Repeater {
+        model: 3
+        delegate: Cell {}
+    }
+
+    Repeater {
+        model: ["a", "b"]
+        delegate: CompiledDelegate {}
+    }
+
+    ListView {
+        objectName: "listRequired"
+        width: 100; height: 100
+        model: ["a", "b"]
+        delegate: CompiledDelegate {}
+    }
+
+    ListView {
+        objectName: "listPlain"
+        width: 100; height: 100
+        model: 2
+        delegate: Plain {}
+    }
+
+    // the models of the table and tree views are set by the test
+    TableView {
+        objectName: "tableRequired"
+        width: 100; height: 100
+        delegate: TableCell {}
+    }
+
+    TableView {
+        objectName: "tablePlain"
+        width: 100; height: 100
+        delegate: Plain {}
+    }
+
+    TreeView {
+        objectName: "treeRequired"
+        width: 100; height: 100
+        delegate: TreeCell {}
+    }
+
+    TreeView {
+        objectName: "treePlain"
+        width: 100; height: 100
+        delegate: Plain {}
+    }
+
+    // not a plain instance of a compiled type, goes through QQmlObjectCreator
+    Repeater {
+        model: 1
+        delegate: Cell { objName: "Modified" + index }
+    }
+}
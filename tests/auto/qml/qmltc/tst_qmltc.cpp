@@ -89,6 +89,8 @@
 #include "qmltablemodel.h"
 #include "stringtourl.h"
 #include "signalconnections.h"
+#include "compileddelegates.h"
+#include "compileddelegate.h"
 
 // Qt:
 #include <QtCore/qstring.h>
@@ -98,6 +100,7 @@
 #include <QtQml/qqmlcomponent.h>
 #include <QtQml/qqmlengine.h>
 #include <QtQml/qqmllist.h>
+#include <QtGui/qstandarditemmodel.h>
 #include <private/qqmltimer_p.h>
 
 #include <QtTest/qsignalspy.h>
@@ -3294,4 +3297,67 @@ void tst_qmltc::signalConnections()
     QCOMPARE(createdByQmltc.objectName(), QLatin1String("second"));
 }
 
+void tst_qmltc::compiledDelegates()
+{
+    QQmlEngine e;
+    PREPEND_NAMESPACE(compiledDelegates) createdByQmltc(&e);
+
+    QStringList cells;
+    QStringList delegates;
+    QStringList others;
+    const auto children = createdByQmltc.childItems();
+    for (QQuickItem *child : children) {
+        if (auto cell = qobject_cast<PREPEND_NAMESPACE(compiledDelegates_Cell) *>(child)) {
+            // plain instances of the inline component are created by the compiled code
+            QCOMPARE(cell->index(), cells.size());
+            cells << cell->objName();
+        } else if (auto delegate = qobject_cast<PREPEND_NAMESPACE(CompiledDelegate) *>(child)) {
+            QVERIFY(delegate->completed());
+            delegates << delegate->objName();
+        } else if (child->metaObject()->indexOfProperty("objName") >= 0) {
+            others << child->property("objName").toString();
+        }
+    }
+
+    QCOMPARE(cells, QStringList({ u"Cell0"_s, u"Cell1"_s, u"Cell2"_s }));
+    QCOMPARE(delegates, QStringList({ u"Delegate_a"_s, u"Delegate_b"_s }));
+    QCOMPARE(others, QStringList({ u"Modified0"_s }));
+
+    // The views set required properties of their delegates after incubation, whether or
+    // not the delegates declare any.
+    QStandardItemModel model(2, 1);
+    const auto delegateNames = [&](const QString &viewName) {
+        QStringList names;
+        auto view = createdByQmltc.findChild<QQuickItem *>(viewName);
+        if (!view)
+            return names;
+        if (view->inherits("QQuickTableView"))
+            view->setProperty("model", QVariant::fromValue<QObject *>(&model));
+        QMetaObject::invokeMethod(view, "forceLayout");
+        const auto contentItem = view->property("contentItem").value<QQuickItem *>();
+        const auto items = contentItem ? contentItem->childItems() : QList<QQuickItem *>();
+        for (QQuickItem *item : items) {
+            if (item->metaObject()->indexOfProperty("objName") < 0)
+                continue;
+            QString name = item->property("objName").toString();
+            auto delegate = qobject_cast<PREPEND_NAMESPACE(CompiledDelegate) *>(item);
+            if (delegate && !delegate->completed())
+                name += u" (not completed)"_s;
+            names << name;
+        }
+        names.sort();
+        return names;
+    };
+
+    QCOMPARE(delegateNames(u"listRequired"_s),
+             QStringList({ u"Delegate_a"_s, u"Delegate_b"_s }));
+    QCOMPARE(delegateNames(u"listPlain"_s), QStringList({ u"Plain"_s, u"Plain"_s }));
+    QCOMPARE(delegateNames(u"tableRequired"_s),
+             QStringList({ u"TableCell0_0"_s, u"TableCell1_0"_s }));
+    QCOMPARE(delegateNames(u"tablePlain"_s), QStringList({ u"Plain"_s, u"Plain"_s }));
+    QCOMPARE(delegateNames(u"treeRequired"_s),
+             QStringList({ u"TreeCell0-"_s, u"TreeCell1-"_s }));
+    QCOMPARE(delegateNames(u"treePlain"_s), QStringList({ u"Plain"_s, u"Plain"_s }));
+}
+
 QTEST_MAIN(tst_qmltc)
@@ -103,4 +103,5 @@ private slots:
 #endif
     void urlToString();
     void signalConnections();
+    void compiledDelegates();
 };
@@ -553,7 +553,9 @@ inline QV4::Function *getRuntimeFunction(QQmlEngine *engine, const QUrl &url, qs
     QQmlEnginePrivate *priv = QQmlEnginePrivate::get(engine);
     Q_ASSERT(priv);
     const auto unit = priv->compilationUnitFromUrl(url);
-    return unit->runtimeFunctions.value(index, nullptr);
+    return (index >= 0 && index < unit->runtimeFunctions.size())
+            ? unit->runtimeFunction(index)
+            : nullptr;
 }
 
 // test utility that sets up the binding call arguments
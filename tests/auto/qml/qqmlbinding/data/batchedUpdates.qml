@@ -0,0 +1,18 @@
+import QtQml
+
+QtObject {
+    property int value: 0
+    property int a: value + 1
+    property int b: value + 2
+    property int sum: a + b
+
+    property int aChanges: 0
+    property int sumChanges: 0
+    property string sums
+
+    onAChanged: ++aChanges
+    onSumChanged: {
+        ++sumChanges
+        sums += sum + ";"
+    }
+}
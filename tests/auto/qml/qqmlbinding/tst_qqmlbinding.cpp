@@ -5,6 +5,7 @@
 #include <QtQml/qqmlcomponent.h>
 #include <QtQml/private/qqmlbind_p.h>
 #include <QtQml/private/qqmlcomponentattached_p.h>
+#include <QtQml/private/qqmlengine_p.h>
 #include <QtQuick/private/qquickrectangle_p.h>
 #include <QtQuickTestUtils/private/qmlutils_p.h>
 #include "WithBindableProperties.h"
@@ -40,6 +41,8 @@ private slots:
     void localSignalHandler();
     void whenEvaluatedEarlyEnough();
     void propertiesAttachedToBindingItself();
+    void batchedUpdates_data();
+    void batchedUpdates();
 
 private:
     QQmlEngine engine;
@@ -625,6 +628,63 @@ void tst_qqmlbinding::propertiesAttachedToBindingItself()
     QTRY_COMPARE(root->property("check").toInt(), 3);
 }
 
+void tst_qqmlbinding::batchedUpdates_data()
+{
+    QTest::addColumn<bool>("batched");
+    QTest::addRow("immediate") << false;
+    QTest::addRow("batched") << true;
+}
+
+void tst_qqmlbinding::batchedUpdates()
+{
+    QFETCH(bool, batched);
+
+    QQmlEngine e;
+    QQmlEnginePrivate::get(&e)->batchedBindingUpdates = batched;
+    QQmlComponent c(&e, testFileUrl("batchedUpdates.qml"));
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    std::unique_ptr<QObject> root { c.create() };
+    QVERIFY(root);
+
+    // Bindings are evaluated right away during creation in both modes
+    QCOMPARE(root->property("a").toInt(), 1);
+    QCOMPARE(root->property("b").toInt(), 2);
+    QCOMPARE(root->property("sum").toInt(), 3);
+
+    // Creation may already have emitted change signals, count from here
+    const int aChanges = root->property("aChanges").toInt();
+    const int sumChanges = root->property("sumChanges").toInt();
+    root->setProperty("sums", QString());
+
+    root->setProperty("value", 5);
+    if (batched) {
+        // Nothing is evaluated until the queue is flushed
+        QCOMPARE(root->property("a").toInt(), 1);
+        QCOMPARE(root->property("sum").toInt(), 3);
+        QQmlEnginePrivate::flushAllDirtyBindings();
+    }
+
+    QCOMPARE(root->property("a").toInt(), 6);
+    QCOMPARE(root->property("b").toInt(), 7);
+    QCOMPARE(root->property("sum").toInt(), 13);
+    QCOMPARE(root->property("aChanges").toInt(), aChanges + 1);
+    if (batched) {
+        // sum is evaluated once, after both of its inputs
+        QCOMPARE(root->property("sumChanges").toInt(), sumChanges + 1);
+        QCOMPARE(root->property("sums").toString(), QStringLiteral("13;"));
+    } else {
+        // sum is evaluated after each of its inputs
+        QCOMPARE(root->property("sumChanges").toInt(), sumChanges + 2);
+        QVERIFY(root->property("sums").toString().endsWith(QStringLiteral(";13;")));
+    }
+
+    // Without an explicit flush, the queued invocation on the engine flushes
+    root->setProperty("value", 10);
+    QTRY_COMPARE(root->property("sum").toInt(), 23);
+    QCOMPARE(root->property("aChanges").toInt(), aChanges + 2);
+    QCOMPARE(root->property("sumChanges").toInt(), sumChanges + (batched ? 2 : 4));
+}
+
 QTEST_MAIN(tst_qqmlbinding)
 
 #include "tst_qqmlbinding.moc"
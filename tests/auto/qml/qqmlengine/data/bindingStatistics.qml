@@ -0,0 +1,8 @@
+import QtQml
+
+QtObject {
+    property bool useA: true
+    property int a: 1
+    property int b: 2
+    property int value: useA ? a : b
+}
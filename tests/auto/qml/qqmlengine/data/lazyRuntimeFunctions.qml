@@ -0,0 +1,18 @@
+import QtQml
+
+QtObject {
+    id: root
+    property int value: 1
+
+    property Component unused: Component {
+        QtObject {
+            property int doubled: root.value * 2
+            function triple() { return root.value * 3 }
+        }
+    }
+
+    function outer() {
+        const inner = () => value + 1
+        return inner()
+    }
+}
@@ -18,8 +18,10 @@
 #include <QTemporaryDir>
  #include <QQmlEngineExtensionPlugin>
 #include <private/qqmlengine_p.h>
+#include <private/qqmlbindingstatistics_p.h>
 #include <private/qqmltypedata_p.h>
 #include <private/qqmlcomponentattached_p.h>
+#include <private/qv4executablecompilationunit_p.h>
 #include <QQmlAbstractUrlInterceptor>
 #include <QtQuickTestUtils/private/qmlutils_p.h>
 
@@ -69,6 +71,7 @@ private slots:
     void uiLanguage();
     void markCurrentFunctionAsTranslationBinding();
     void executeRuntimeFunction();
+    void lazyRuntimeFunctions();
     void captureQProperty();
     void listWrapperAsListReference();
     void attachedObjectAsObject();
@@ -80,6 +83,7 @@ private slots:
     void lockedRootObject();
     void crossReferencingSingletonsDeletion();
     void bindingInstallUseAfterFree();
+    void bindingStatistics();
 
 public slots:
     QObject *createAQObjectForOwnershipTest ()
@@ -1462,6 +1466,37 @@ void tst_qqmlengine::executeRuntimeFunction()
     QCOMPARE(dummy->property("baz").toInt(), -100);
 }
 
+void tst_qqmlengine::lazyRuntimeFunctions()
+{
+    QQmlEngine engine;
+    QQmlEnginePrivate *priv = QQmlEnginePrivate::get(std::addressof(engine));
+
+    const QUrl url = testFileUrl("lazyRuntimeFunctions.qml");
+    QQmlComponent component(&engine, url);
+    QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+    QScopedPointer<QObject> root(component.create());
+    QVERIFY(root);
+
+    const QV4::ExecutableCompilationUnit *unit = priv->compilationUnitFromUrl(url);
+    QVERIFY(unit);
+
+    // Neither the nested arrow function nor anything in the inner component is needed yet.
+    const qsizetype afterCreation = unit->createdRuntimeFunctionCount();
+    QVERIFY(afterCreation < unit->runtimeFunctions.size());
+
+    QVariant result;
+    QVERIFY(QMetaObject::invokeMethod(root.get(), "outer", Q_RETURN_ARG(QVariant, result)));
+    QCOMPARE(result.toInt(), 2);
+    QCOMPARE(unit->createdRuntimeFunctionCount(), afterCreation + 1);
+
+    QQmlComponent *inner = root->property("unused").value<QQmlComponent *>();
+    QVERIFY(inner);
+    QScopedPointer<QObject> innerObject(inner->create());
+    QVERIFY(innerObject);
+    QCOMPARE(innerObject->property("doubled").toInt(), 2);
+    QCOMPARE(unit->createdRuntimeFunctionCount(), afterCreation + 3);
+}
+
 class WithQProperty : public QObject
 {
     Q_OBJECT
@@ -1734,6 +1769,45 @@ void tst_qqmlengine::bindingInstallUseAfterFree()
     QVERIFY(o);
 }
 
+void tst_qqmlengine::bindingStatistics()
+{
+    QQmlEngine engine;
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(&engine);
+    QVERIFY(!ep->bindingStatistics);
+    ep->setBindingStatisticsEnabled(true);
+    QVERIFY(ep->bindingStatistics);
+
+    QQmlComponent c(&engine, testFileUrl("bindingStatistics.qml"));
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    std::unique_ptr<QObject> o{ c.create() };
+    QVERIFY(o);
+    QCOMPARE(o->property("value").toInt(), 1);
+
+    // Same dependencies as before
+    o->setProperty("a", 5);
+    QCOMPARE(o->property("value").toInt(), 5);
+
+    // Drops the dependency on a and captures b instead
+    o->setProperty("useA", false);
+    QCOMPARE(o->property("value").toInt(), 2);
+
+    const QList<QQmlBindingStatistics::Entry> entries = ep->bindingStatistics->entries();
+    QCOMPARE(entries.size(), 1);
+    const QQmlBindingStatistics::Entry &entry = entries.first();
+    QVERIFY(entry.location.sourceFile.endsWith(QLatin1String("bindingStatistics.qml")));
+    QCOMPARE(entry.location.line, quint16(7));
+    QCOMPARE(entry.evaluations, quint64(3));
+    QCOMPARE(entry.capturedDependencies, quint64(6));
+    QCOMPARE(entry.dependencyChurn, quint64(2));
+    QCOMPARE(entry.recaptures, quint64(1));
+
+    QCOMPARE(ep->bindingStatistics->takeEntries().size(), 1);
+    QVERIFY(ep->bindingStatistics->entries().isEmpty());
+
+    ep->setBindingStatisticsEnabled(false);
+    QVERIFY(!ep->bindingStatistics);
+}
+
 QTEST_MAIN(tst_qqmlengine)
 
 #include "tst_qqmlengine.moc"
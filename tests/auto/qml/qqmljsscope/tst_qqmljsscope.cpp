@@ -10,17 +10,20 @@
 #include <QtCore/qurl.h>
 #include <QtCore/qlibraryinfo.h>
 #include <QtCore/qscopedpointer.h>
+#include <QtCore/qtemporarydir.h>
 #include <QtQml/qqmlengine.h>
 #include <QtQml/qqmlcomponent.h>
 #include <QtGui/qfont.h>
 
 #include <QtQml/private/qqmlirbuilder_p.h>
+#include <private/qqmljsbinarytypedescription_p.h>
 #include <private/qqmljscompiler_p.h>
 #include <private/qqmljsscope_p.h>
 #include <private/qqmljsimporter_p.h>
 #include <private/qqmljslogger_p.h>
 #include <private/qqmljsimportvisitor_p.h>
 #include <private/qqmljstyperesolver_p.h>
+#include <private/qqmljstypedescriptionreader_p.h>
 #include <QtQml/private/qqmljslexer_p.h>
 #include <QtQml/private/qqmljsparser_p.h>
 #include <private/qqmlcomponent_p.h>
@@ -112,6 +115,7 @@ private Q_SLOTS:
     void attachedTypeResolution();
     void builtinTypeResolution_data();
     void builtinTypeResolution();
+    void binaryTypeDescription();
 
 public:
     tst_qqmljsscope()
@@ -898,5 +902,70 @@ void tst_qqmljsscope::builtinTypeResolution()
     QCOMPARE(element.isNull(), !valid);
 }
 
+void tst_qqmljsscope::binaryTypeDescription()
+{
+    const QString fileName = u":/qt-project.org/qml/builtins/builtins.qmltypes"_s;
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray source = file.readAll();
+
+    QQmlJSTypeDescriptionReader reader(fileName, QString::fromUtf8(source));
+    QList<QQmlJSExportedScope> parsed;
+    QStringList parsedDependencies;
+    QVERIFY(reader(&parsed, &parsedDependencies));
+    QVERIFY(!parsed.isEmpty());
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString binaryFileName
+            = QQmlJSBinaryTypeDescription::fileNameFor(dir.filePath(u"builtins.qmltypes"_s));
+    const QByteArray hash = QQmlJSBinaryTypeDescription::sourceHash(source);
+    QString errorString;
+    QVERIFY2(QQmlJSBinaryTypeDescription::write(binaryFileName, hash, parsed, parsedDependencies,
+                                                reader.warningMessage(), &errorString),
+             qPrintable(errorString));
+
+    QList<QQmlJSExportedScope> loaded;
+    QStringList loadedDependencies;
+    QString loadedWarningMessage;
+    QVERIFY(!QQmlJSBinaryTypeDescription::read(
+            binaryFileName, QQmlJSBinaryTypeDescription::sourceHash(source + ' '),
+            &loaded, &loadedDependencies, &loadedWarningMessage));
+    QVERIFY(loaded.isEmpty());
+    QVERIFY(QQmlJSBinaryTypeDescription::read(
+            binaryFileName, hash, &loaded, &loadedDependencies, &loadedWarningMessage));
+
+    QCOMPARE(loadedDependencies, parsedDependencies);
+    QCOMPARE(loadedWarningMessage, reader.warningMessage());
+    QCOMPARE(loaded.size(), parsed.size());
+    for (qsizetype i = 0; i < parsed.size(); ++i) {
+        const QQmlJSScope::ConstPtr expected = parsed[i].scope;
+        const QQmlJSScope::ConstPtr actual = loaded[i].scope;
+        QCOMPARE(actual->internalName(), expected->internalName());
+        QCOMPARE(actual->baseTypeName(), expected->baseTypeName());
+        QCOMPARE(actual->valueTypeName(), expected->valueTypeName());
+        QCOMPARE(actual->extensionTypeName(), expected->extensionTypeName());
+        QCOMPARE(actual->ownAttachedTypeName(), expected->ownAttachedTypeName());
+        QCOMPARE(actual->ownDefaultPropertyName(), expected->ownDefaultPropertyName());
+        QCOMPARE(actual->flags(), expected->flags());
+        QCOMPARE(actual->accessSemantics(), expected->accessSemantics());
+        QCOMPARE(actual->interfaceNames(), expected->interfaceNames());
+        QCOMPARE(actual->ownProperties(), expected->ownProperties());
+        QCOMPARE(actual->ownEnumerations(), expected->ownEnumerations());
+
+        const auto methods = expected->ownMethods();
+        QCOMPARE(actual->ownMethods().size(), methods.size());
+        for (const QString &name : methods.uniqueKeys())
+            QCOMPARE(actual->ownMethods(name), expected->ownMethods(name));
+
+        QCOMPARE(loaded[i].exports.size(), parsed[i].exports.size());
+        for (qsizetype j = 0; j < parsed[i].exports.size(); ++j) {
+            QCOMPARE(loaded[i].exports[j].type(), parsed[i].exports[j].type());
+            QCOMPARE(loaded[i].exports[j].version(), parsed[i].exports[j].version());
+            QCOMPARE(loaded[i].exports[j].revision(), parsed[i].exports[j].revision());
+        }
+    }
+}
+
 QTEST_MAIN(tst_qqmljsscope)
 #include "tst_qqmljsscope.moc"
@@ -198,7 +198,7 @@ void CustomBinding::componentComplete()
         QV4::Scope scope(qmlEngine(this)->handle());
         QV4::Scoped<QV4::QmlContext> qmlContext(scope, QV4::QmlContext::create(scope.engine->rootContext(), context, m_target));
         QQmlBinding *qmlBinding = QQmlBinding::create(&QQmlPropertyPrivate::get(property)->core,
-                                                      compilationUnit->runtimeFunctions[bindingId], m_target, context, qmlContext);
+                                                      compilationUnit->runtimeFunction(bindingId), m_target, context, qmlContext);
         qmlBinding->setTarget(property);
         QQmlPropertyPrivate::setBinding(property, qmlBinding);
     }
@@ -0,0 +1,27 @@
+import QtQuick
+
+Item {
+    width: 320
+    height: 60
+
+    property bool bold: false
+
+    FontLoader {
+        id: ocr
+        source: "tarzeau_ocr_a.ttf"
+    }
+
+    // Punctuation, digits and capitals, each a glyph not shown before
+    Text {
+        objectName: "text"
+        font.family: ocr.font.family
+        font.pixelSize: 20
+        font.bold: parent.bold
+        text: {
+            let glyphs = "";
+            for (let c = 33; c < 96; ++c)
+                glyphs += String.fromCharCode(c);
+            return glyphs;
+        }
+    }
+}
@@ -0,0 +1,108 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+
+#include <QtQuick/qquickview.h>
+#include <QtQuick/qsgnode.h>
+#include <QtQuick/private/qquickitem_p.h>
+#include <QtQuick/private/qquicktext_p.h>
+
+#include <QtQuickTestUtils/private/qmlutils_p.h>
+
+class tst_AsyncDistanceFieldGlyphs : public QQmlDataTest
+{
+    Q_OBJECT
+
+public:
+    tst_AsyncDistanceFieldGlyphs();
+
+private slots:
+    void initTestCase() override;
+
+    void destroyWhileGenerating();
+    void glyphsArrive();
+
+private:
+    void showAllGlyphs(bool bold);
+};
+
+tst_AsyncDistanceFieldGlyphs::tst_AsyncDistanceFieldGlyphs()
+    : QQmlDataTest(QT_QMLTEST_DATADIR)
+{
+}
+
+void tst_AsyncDistanceFieldGlyphs::initTestCase()
+{
+    // Both are read once, before the first glyph cache is created. Without
+    // the disk cache every glyph is generated.
+    qputenv("QSG_ASYNC_DISTANCEFIELD_GLYPHS", "1");
+    qputenv("QSG_DISABLE_DISTANCEFIELD_DISK_CACHE", "1");
+
+    QQmlDataTest::initTestCase();
+}
+
+// Each glyph is a quad in the geometry of a glyph node, or of one of its sub
+// nodes, once its distance field is in the cache
+static int vertexCount(QSGNode *node)
+{
+    int count = 0;
+    if (node->type() == QSGNode::GeometryNode)
+        count += static_cast<QSGGeometryNode *>(node)->geometry()->vertexCount();
+    for (QSGNode *child = node->firstChild(); child; child = child->nextSibling())
+        count += vertexCount(child);
+    return count;
+}
+
+void tst_AsyncDistanceFieldGlyphs::showAllGlyphs(bool bold)
+{
+    QQuickView view;
+    view.setSource(testFileUrl("glyphs.qml"));
+    QVERIFY(view.rootObject());
+    view.rootObject()->setProperty("bold", bold);
+    QQuickText *text = view.rootObject()->findChild<QQuickText *>("text");
+    QVERIFY(text);
+
+    // The nodes are only safe to look at on the render thread
+    QAtomicInt glyphVertexCount(-1);
+    connect(&view, &QQuickWindow::afterRendering, &view, [&glyphVertexCount, text]() {
+        QSGNode *node = QQuickItemPrivate::get(text)->paintNode;
+        glyphVertexCount.storeRelaxed(node ? vertexCount(node) : 0);
+    }, Qt::DirectConnection);
+
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+    if (!QSGRendererInterface::isApiRhiBased(view.rendererInterface()->graphicsApi()))
+        QSKIP("Distance field text needs QRhi");
+
+    // The window is updated for the generated glyphs, without anything else
+    // changing
+    QTRY_COMPARE(glyphVertexCount.loadRelaxed(), 4 * int(text->text().size()));
+}
+
+void tst_AsyncDistanceFieldGlyphs::destroyWhileGenerating()
+{
+    QScopedPointer<QQuickView> view(new QQuickView);
+    view->setSource(testFileUrl("glyphs.qml"));
+    QVERIFY(view->rootObject());
+    view->rootObject()->setProperty("bold", true);
+    view->show();
+    QVERIFY(QTest::qWaitForWindowExposed(view.data()));
+    if (!QSGRendererInterface::isApiRhiBased(view->rendererInterface()->graphicsApi()))
+        QSKIP("Distance field text needs QRhi");
+
+    // The glyphs that didn't fit into the first frame are still being
+    // generated, their results are dropped along with the glyph cache
+    view.reset();
+
+    showAllGlyphs(true);
+}
+
+void tst_AsyncDistanceFieldGlyphs::glyphsArrive()
+{
+    showAllGlyphs(false);
+}
+
+QTEST_MAIN(tst_AsyncDistanceFieldGlyphs)
+
+#include "tst_asyncdistancefieldglyphs.moc"
@@ -0,0 +1,300 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qtemporarydir.h>
+#if QT_CONFIG(process)
+#include <QtCore/qprocess.h>
+#endif
+#include <QtGui/qrawfont.h>
+#include <QtGui/private/qdistancefield_p.h>
+
+#include <private/qsgdistancefielddiskcache_p.h>
+
+#include <QtQuickTestUtils/private/qmlutils_p.h>
+
+typedef QSharedPointer<QSGDistanceFieldDiskCache> DiskCachePtr;
+
+class tst_DistanceFieldDiskCache : public QQmlDataTest
+{
+    Q_OBJECT
+
+public:
+    tst_DistanceFieldDiskCache();
+
+private slots:
+    void initTestCase() override;
+    void init();
+
+    void roundTrip_data();
+    void roundTrip();
+    void truncatedRecord();
+    void corruptedPayload();
+    void badFileHeader_data();
+    void badFileHeader();
+    void disabled();
+
+private:
+    QList<QDistanceField> generate(const QString &text, bool doubleResolution = false) const;
+    static bool release(DiskCachePtr &cache);
+    static QByteArray bytes(const QDistanceField &field);
+
+    QTemporaryDir m_cacheDir;
+    QRawFont m_font;
+};
+
+// Fixed size of the file header, and of each glyph header before its data
+static const qint64 FileHeaderSize = 8;
+static const qint64 GlyphHeaderSize = 12;
+
+tst_DistanceFieldDiskCache::tst_DistanceFieldDiskCache()
+    : QQmlDataTest(QT_QMLTEST_DATADIR)
+{
+}
+
+void tst_DistanceFieldDiskCache::initTestCase()
+{
+    QQmlDataTest::initTestCase();
+
+    // The cache directory is read once, before the first cache is created
+    QVERIFY(m_cacheDir.isValid());
+    qputenv("QSG_DISTANCEFIELD_DISK_CACHE_PATH", QFile::encodeName(m_cacheDir.path()));
+
+    m_font = QRawFont(testFile("tarzeau_ocr_a.ttf"), QT_DISTANCEFIELD_BASEFONTSIZE(false));
+    QVERIFY(m_font.isValid());
+}
+
+void tst_DistanceFieldDiskCache::init()
+{
+    QDir dir(m_cacheDir.path());
+    const QStringList files = dir.entryList(QDir::Files);
+    for (const QString &file : files)
+        QVERIFY(dir.remove(file));
+}
+
+QList<QDistanceField> tst_DistanceFieldDiskCache::generate(const QString &text,
+                                                           bool doubleResolution) const
+{
+    QList<QDistanceField> fields;
+    const QList<quint32> glyphs = m_font.glyphIndexesForString(text);
+    for (quint32 glyph : glyphs)
+        fields.append(QDistanceField(m_font, glyph, doubleResolution));
+    return fields;
+}
+
+// Drops the reference to cache and waits until the writes it has queued
+// are done, so that the next cacheForFont() loads the file again
+bool tst_DistanceFieldDiskCache::release(DiskCachePtr &cache)
+{
+    const QWeakPointer<QSGDistanceFieldDiskCache> weak = cache;
+    cache.reset();
+    return QTest::qWaitFor([&weak]() { return weak.isNull(); });
+}
+
+QByteArray tst_DistanceFieldDiskCache::bytes(const QDistanceField &field)
+{
+    return QByteArray(reinterpret_cast<const char *>(field.constBits()),
+                      qsizetype(field.width()) * field.height());
+}
+
+void tst_DistanceFieldDiskCache::roundTrip_data()
+{
+    QTest::addColumn<bool>("doubleResolution");
+
+    QTest::newRow("single resolution") << false;
+    QTest::newRow("double resolution") << true;
+}
+
+void tst_DistanceFieldDiskCache::roundTrip()
+{
+    QFETCH(bool, doubleResolution);
+
+    const QList<QDistanceField> fields = generate(QStringLiteral("QT5G"), doubleResolution);
+    QCOMPARE(fields.size(), 4);
+
+    DiskCachePtr cache = QSGDistanceFieldDiskCache::cacheForFont(m_font, doubleResolution);
+    QVERIFY(cache);
+    QCOMPARE(QSGDistanceFieldDiskCache::cacheForFont(m_font, doubleResolution), cache);
+    QVERIFY(QSGDistanceFieldDiskCache::cacheForFont(m_font, !doubleResolution) != cache);
+    const QString fileName = cache->fileName();
+    QVERIFY(fileName.startsWith(m_cacheDir.path()));
+
+    for (const QDistanceField &field : fields)
+        QVERIFY(cache->glyph(field.glyph()).isNull());
+
+    cache->storeGlyphs(fields);
+    // Only read from the file when it is loaded
+    for (const QDistanceField &field : fields)
+        QVERIFY(cache->glyph(field.glyph()).isNull());
+    QVERIFY(release(cache));
+
+    cache = QSGDistanceFieldDiskCache::cacheForFont(m_font, doubleResolution);
+    QVERIFY(cache);
+    QCOMPARE(cache->fileName(), fileName);
+    for (const QDistanceField &field : fields) {
+        const QDistanceField cached = cache->glyph(field.glyph());
+        QVERIFY(!cached.isNull());
+        QCOMPARE(cached.glyph(), field.glyph());
+        QCOMPARE(cached.width(), field.width());
+        QCOMPARE(cached.height(), field.height());
+        QCOMPARE(bytes(cached), bytes(field));
+    }
+
+    // Glyphs that are in the file already are not written again
+    const qint64 size = QFileInfo(fileName).size();
+    cache->storeGlyphs(fields);
+    QVERIFY(release(cache));
+    QCOMPARE(QFileInfo(fileName).size(), size);
+}
+
+void tst_DistanceFieldDiskCache::truncatedRecord()
+{
+    const QList<QDistanceField> fields = generate(QStringLiteral("QT5"));
+    QCOMPARE(fields.size(), 3);
+
+    DiskCachePtr cache = QSGDistanceFieldDiskCache::cacheForFont(m_font, false);
+    QVERIFY(cache);
+    const QString fileName = cache->fileName();
+    cache->storeGlyphs(fields);
+    QVERIFY(release(cache));
+
+    // Cut the last glyph short, as if the process writing it was killed
+    const qint64 fullSize = QFileInfo(fileName).size();
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.resize(fullSize - 5));
+    }
+
+    cache = QSGDistanceFieldDiskCache::cacheForFont(m_font, false);
+    QVERIFY(cache);
+    QCOMPARE(bytes(cache->glyph(fields.at(0).glyph())), bytes(fields.at(0)));
+    QCOMPARE(bytes(cache->glyph(fields.at(1).glyph())), bytes(fields.at(1)));
+    QVERIFY(cache->glyph(fields.at(2).glyph()).isNull());
+
+    // The next write drops the incomplete glyph before appending
+    cache->storeGlyphs(fields);
+    QVERIFY(release(cache));
+    QCOMPARE(QFileInfo(fileName).size(), fullSize);
+
+    cache = QSGDistanceFieldDiskCache::cacheForFont(m_font, false);
+    QVERIFY(cache);
+    for (const QDistanceField &field : fields)
+        QCOMPARE(bytes(cache->glyph(field.glyph())), bytes(field));
+}
+
+void tst_DistanceFieldDiskCache::corruptedPayload()
+{
+    const QList<QDistanceField> fields = generate(QStringLiteral("QT"));
+    QCOMPARE(fields.size(), 2);
+    const QDistanceField &first = fields.at(0);
+    QVERIFY(first.width() > 0 && first.height() > 0);
+
+    DiskCachePtr cache = QSGDistanceFieldDiskCache::cacheForFont(m_font, false);
+    QVERIFY(cache);
+    const QString fileName = cache->fileName();
+    cache->storeGlyphs(fields);
+    QVERIFY(release(cache));
+
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        const qint64 offset = FileHeaderSize + GlyphHeaderSize
+                + qint64(first.width()) * first.height() / 2;
+        QVERIFY(file.seek(offset));
+        char byte;
+        QVERIFY(file.getChar(&byte));
+        QVERIFY(file.seek(offset));
+        QVERIFY(file.putChar(char(~byte)));
+    }
+
+    // A null distance field makes the glyph cache generate it instead
+    cache = QSGDistanceFieldDiskCache::cacheForFont(m_font, false);
+    QVERIFY(cache);
+    QVERIFY(cache->glyph(first.glyph()).isNull());
+    QCOMPARE(bytes(cache->glyph(fields.at(1).glyph())), bytes(fields.at(1)));
+    QVERIFY(release(cache));
+}
+
+void tst_DistanceFieldDiskCache::badFileHeader_data()
+{
+    QTest::addColumn<qint64>("offset");
+
+    QTest::newRow("magic") << qint64(0);
+    QTest::newRow("version") << qint64(4);
+}
+
+void tst_DistanceFieldDiskCache::badFileHeader()
+{
+    QFETCH(qint64, offset);
+
+    const QList<QDistanceField> fields = generate(QStringLiteral("QT"));
+    QCOMPARE(fields.size(), 2);
+
+    DiskCachePtr cache = QSGDistanceFieldDiskCache::cacheForFont(m_font, false);
+    QVERIFY(cache);
+    const QString fileName = cache->fileName();
+    cache->storeGlyphs(fields);
+    QVERIFY(release(cache));
+
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.seek(offset));
+        const quint32 value = 0xdeadbeef;
+        QCOMPARE(file.write(reinterpret_cast<const char *>(&value), sizeof(value)),
+                 qint64(sizeof(value)));
+    }
+
+    cache = QSGDistanceFieldDiskCache::cacheForFont(m_font, false);
+    QVERIFY(cache);
+    for (const QDistanceField &field : fields)
+        QVERIFY(cache->glyph(field.glyph()).isNull());
+
+    // The file is started over by the next write
+    cache->storeGlyphs(fields);
+    QVERIFY(release(cache));
+
+    cache = QSGDistanceFieldDiskCache::cacheForFont(m_font, false);
+    QVERIFY(cache);
+    for (const QDistanceField &field : fields)
+        QCOMPARE(bytes(cache->glyph(field.glyph())), bytes(field));
+}
+
+/* QSG_DISABLE_DISTANCEFIELD_DISK_CACHE is read once per process, so it is
+ * tested by running this test function in a child process.
+ */
+void tst_DistanceFieldDiskCache::disabled()
+{
+    const char *disableKey = "QSG_DISABLE_DISTANCEFIELD_DISK_CACHE";
+    if (qEnvironmentVariableIsSet(disableKey)) {
+        QVERIFY(!QSGDistanceFieldDiskCache::cacheForFont(m_font, false));
+        QVERIFY(QDir(m_cacheDir.path()).isEmpty());
+        return;
+    }
+
+#ifdef Q_OS_ANDROID
+    QSKIP("Android seems to have problems with QProcess");
+#endif
+#if !QT_CONFIG(process)
+    QSKIP("Needs QProcess");
+#else
+    QProcess child;
+    child.setProgram(QCoreApplication::applicationFilePath());
+    child.setArguments(QStringList(QLatin1String("disabled")));
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    env.insert(QLatin1String(disableKey), QLatin1String("1"));
+    child.setProcessEnvironment(env);
+    child.start();
+    QVERIFY(child.waitForFinished());
+    QVERIFY2(child.exitCode() == 0, child.readAllStandardOutput().constData());
+#endif
+}
+
+QTEST_MAIN(tst_DistanceFieldDiskCache)
+
+#include "tst_distancefielddiskcache.moc"
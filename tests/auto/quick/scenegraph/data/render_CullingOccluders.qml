@@ -0,0 +1,49 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick 2.2
+
+/*
+    The test verifies that content exactly behind an opaque Rectangle or
+    Image is hidden and drawn again once the cover is hidden, and that
+    translucent covers don't hide what is behind them.
+
+    #samples: 8
+                 PixelPos     R    G    B    Error-tolerance
+    #base:        30  30     0.0  0.0  1.0        0.0
+    #base:       130  40     0.0  1.0  0.0        0.05
+    #base:        30 120     0.5  0.0  0.5        0.05
+    #base:       130 120     0.5  0.0  0.5        0.05
+
+    #final:       30  30     1.0  0.0  0.0        0.0
+    #final:      130  40     1.0  0.0  0.0        0.0
+    #final:       30 120     0.5  0.0  0.5        0.05
+    #final:      130 120     0.5  0.0  0.5        0.05
+*/
+
+RenderTestBase
+{
+    id: root
+    property bool covered: true
+
+    Rectangle { x: 10; y: 10; width: 40; height: 40; color: "#ff0000" }
+    Rectangle { x: 0; y: 0; width: 60; height: 60; color: "#0000ff"; visible: root.covered }
+
+    Rectangle { x: 110; y: 20; width: 40; height: 40; color: "#ff0000" }
+    Image {
+        x: 100; y: 10; width: 60; height: 60
+        source: "opaque-green.png"
+        visible: root.covered
+    }
+
+    Rectangle { x: 10; y: 100; width: 40; height: 40; color: "#ff0000" }
+    Rectangle { x: 0; y: 90; width: 60; height: 60; color: "#800000ff" }
+
+    Rectangle { x: 110; y: 100; width: 40; height: 40; color: "#ff0000" }
+    Rectangle { x: 100; y: 90; width: 60; height: 60; color: "#0000ff"; opacity: 0.5 }
+
+    onEnterFinalStage: {
+        root.covered = false;
+        root.finalStageComplete = true;
+    }
+}
@@ -0,0 +1,31 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick 2.2
+
+/*
+    Both rectangles are far outside the window when their corners are
+    mapped without the perspective division of the projected rotation.
+    Which of them is in the window after the division depends on which side
+    the rotation turns away from the viewer, so this one is only compared
+    with the output without culling.
+*/
+
+RenderTestBase
+{
+    id: root
+
+    Rectangle {
+        x: -1900; y: 20; width: 1000; height: 60
+        color: "#ff0000"
+        transform: Rotation { origin.x: 2000; axis { x: 0; y: 1; z: 0 } angle: 80 }
+    }
+
+    Rectangle {
+        x: 1100; y: 120; width: 1000; height: 60
+        color: "#0000ff"
+        transform: Rotation { origin.x: -1000; axis { x: 0; y: 1; z: 0 } angle: 80 }
+    }
+
+    onEnterFinalStage: finalStageComplete = true;
+}
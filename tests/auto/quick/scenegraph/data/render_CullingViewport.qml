@@ -0,0 +1,54 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick 2.2
+
+/*
+    The test verifies that content partly outside the window is drawn, and
+    that content which is culled for being outside the window is drawn
+    once it is moved into it.
+
+    #samples: 10
+                 PixelPos     R    G    B    Error-tolerance
+    #base:         5  20     1.0  0.0  0.0        0.0
+    #base:        45  20     1.0  0.0  0.0        0.0
+    #base:       160 190     0.0  0.0  1.0        0.0
+    #base:        20  60     1.0  1.0  1.0        0.0
+    #base:        20 110     1.0  1.0  1.0        0.0
+
+    #final:        5  20     1.0  0.0  0.0        0.0
+    #final:       45  20     1.0  0.0  0.0        0.0
+    #final:      160 190     0.0  0.0  1.0        0.0
+    #final:       20  60     0.0  1.0  0.0        0.0
+    #final:       20 110     0.0  0.0  1.0        0.0
+*/
+
+RenderTestBase
+{
+    id: root
+    property bool inside: false
+
+    Rectangle { x: -50; y: 10; width: 100; height: 20; color: "#ff0000" }
+    Rectangle { x: 150; y: 180; width: 20; height: 100; color: "#0000ff" }
+
+    Rectangle {
+        x: root.inside ? 10 : -1000
+        y: 50
+        width: 20
+        height: 20
+        color: "#00ff00"
+    }
+
+    Item {
+        y: root.inside ? 0 : 1000
+        Repeater {
+            model: 10
+            Rectangle { x: 10 + index * 2; y: 100; width: 2; height: 20; color: "#0000ff" }
+        }
+    }
+
+    onEnterFinalStage: {
+        root.inside = true;
+        root.finalStageComplete = true;
+    }
+}
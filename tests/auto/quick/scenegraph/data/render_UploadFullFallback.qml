@@ -0,0 +1,54 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick 2.2
+
+/*
+    The test verifies that changes which only uploading the changed items
+    can't handle upload the whole merged batch again: first more than half
+    of the items move, then one of them gets more vertices.
+
+    #samples: 8
+                 PixelPos     R    G    B    Error-tolerance
+    #base:        15  15     0.0  0.0  1.0        0.0
+    #base:        15  45     1.0  1.0  1.0        0.0
+    #base:       175  15     0.0  0.0  1.0        0.0
+    #base:       175  45     1.0  1.0  1.0        0.0
+
+    #final:       15  15     0.0  0.0  1.0        0.0
+    #final:       15  45     1.0  1.0  1.0        0.0
+    #final:      175  15     1.0  1.0  1.0        0.0
+    #final:      175  45     0.0  0.0  1.0        0.0
+*/
+
+RenderTestBase
+{
+    id: root
+    property real shift: 0
+    property real radius: 0
+
+    Repeater {
+        model: 8
+        Rectangle {
+            x: 5 + index * 24
+            y: 5 + (index >= 2 ? root.shift : 0)
+            width: 20
+            height: 20
+            radius: index == 7 ? root.radius : 0
+            color: "#0000ff"
+        }
+    }
+
+    SequentialAnimation {
+        id: animation
+        PropertyAction { target: root; property: "shift"; value: 30 }
+        PauseAnimation { duration: 50 }
+        PropertyAction { target: root; property: "radius"; value: 5 }
+        PauseAnimation { duration: 50 }
+        PropertyAction { target: root; property: "finalStageComplete"; value: true; }
+    }
+
+    onEnterFinalStage: {
+        animation.running = true;
+    }
+}
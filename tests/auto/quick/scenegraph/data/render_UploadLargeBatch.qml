@@ -0,0 +1,42 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick 2.2
+
+/*
+    The test verifies that a merged batch of 10000 vertices is drawn in
+    full, and again after all of its items changed color. Every item has
+    its own color, so that items landing in the wrong place show.
+
+    #samples: 6
+                 PixelPos     R    G    B    Error-tolerance
+    #base:         2   2     0.0  0.0  0.0        0.0
+    #base:       102   2     0.51 0.0  0.0        0.05
+    #base:       198 198     1.0  1.0  0.0        0.0
+
+    #final:        2   2     0.0  0.0  1.0        0.0
+    #final:      102   2     0.51 0.0  1.0        0.05
+    #final:      198 198     1.0  1.0  1.0        0.0
+*/
+
+RenderTestBase
+{
+    id: root
+    property real blue: 0
+
+    Repeater {
+        model: 2500
+        Rectangle {
+            x: (index % 50) * 4
+            y: Math.floor(index / 50) * 4
+            width: 4
+            height: 4
+            color: Qt.rgba((index % 50) / 49, Math.floor(index / 50) / 49, root.blue, 1)
+        }
+    }
+
+    onEnterFinalStage: {
+        root.blue = 1;
+        root.finalStageComplete = true;
+    }
+}
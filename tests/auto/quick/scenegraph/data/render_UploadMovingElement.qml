@@ -0,0 +1,55 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick 2.2
+
+/*
+    The test verifies that moving one item of a large merged batch over
+    several frames, which only uploads that item's vertices again, draws
+    it at its new place and the rest of the batch where it was.
+
+    #samples: 8
+                 PixelPos     R    G    B    Error-tolerance
+    #base:        10  10     1.0  0.0  0.0        0.0
+    #base:        30  10     0.0  1.0  0.0        0.0
+    #base:       110 110     0.0  1.0  0.0        0.0
+    #base:       195 195     0.0  1.0  0.0        0.0
+
+    #final:       10  10     0.0  1.0  0.0        0.0
+    #final:       30  10     0.0  1.0  0.0        0.0
+    #final:      110 110     1.0  0.0  0.0        0.0
+    #final:      195 195     0.0  1.0  0.0        0.0
+*/
+
+RenderTestBase
+{
+    id: root
+
+    Repeater {
+        model: 400
+        Rectangle {
+            x: (index % 20) * 10
+            y: Math.floor(index / 20) * 10
+            width: 10
+            height: 10
+            color: "#00ff00"
+        }
+    }
+
+    Rectangle {
+        id: mover
+        width: 20
+        height: 20
+        color: "#ff0000"
+    }
+
+    SequentialAnimation {
+        id: animation
+        NumberAnimation { target: mover; properties: "x,y"; from: 0; to: 100; duration: 200 }
+        PropertyAction { target: root; property: "finalStageComplete"; value: true; }
+    }
+
+    onEnterFinalStage: {
+        animation.running = true;
+    }
+}
@@ -0,0 +1,47 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick 2.2
+
+/*
+    The test verifies that changing items in the middle of a merged batch
+    of triangle strips, which only uploads their vertices and indices
+    again, keeps the degenerate triangles between the strips intact. Two
+    neighbours change color, one further back moves.
+
+    #samples: 10
+                 PixelPos     R    G    B    Error-tolerance
+    #base:        50  30     0.0  0.0  1.0        0.0
+    #base:        70  30     0.0  0.0  1.0        0.0
+    #base:       130  30     0.0  0.0  1.0        0.0
+    #base:       130  60     1.0  1.0  1.0        0.0
+    #base:       170  30     0.0  0.0  1.0        0.0
+
+    #final:       50  30     1.0  0.0  0.0        0.0
+    #final:       70  30     1.0  0.0  0.0        0.0
+    #final:      130  30     1.0  1.0  1.0        0.0
+    #final:      130  60     0.0  0.0  1.0        0.0
+    #final:      170  30     0.0  0.0  1.0        0.0
+*/
+
+RenderTestBase
+{
+    id: root
+    property bool changed: false
+
+    Repeater {
+        model: 9
+        Rectangle {
+            x: 5 + index * 20
+            y: index == 6 && root.changed ? 45 : 20
+            width: 20
+            height: 20
+            color: (index == 2 || index == 3) && root.changed ? "#ff0000" : "#0000ff"
+        }
+    }
+
+    onEnterFinalStage: {
+        root.changed = true;
+        root.finalStageComplete = true;
+    }
+}
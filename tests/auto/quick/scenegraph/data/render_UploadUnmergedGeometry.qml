@@ -0,0 +1,38 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick 2.2
+
+/*
+    The test verifies that changing the geometry of one node of an opaque
+    unmerged batch, which only uploads that node's vertices again, draws
+    the new geometry and keeps the other nodes of the batch. Images have
+    no indices, so they are not merged.
+
+    #samples: 8
+                 PixelPos     R    G    B    Error-tolerance
+    #base:        30  30     0.0  1.0  0.0        0.05
+    #base:       120  30     0.0  1.0  0.0        0.05
+    #base:       170  30     1.0  1.0  1.0        0.0
+    #base:        30 130     0.0  1.0  0.0        0.05
+
+    #final:       30  30     0.0  1.0  0.0        0.05
+    #final:      120  30     0.0  1.0  0.0        0.05
+    #final:      170  30     0.0  1.0  0.0        0.05
+    #final:       30 130     0.0  1.0  0.0        0.05
+*/
+
+RenderTestBase
+{
+    id: root
+    property bool wide: false
+
+    Image { x: 10; y: 10; width: 40; height: 40; source: "opaque-green.png" }
+    Image { x: 100; y: 10; width: root.wide ? 90 : 40; height: 40; source: "opaque-green.png" }
+    Image { x: 10; y: 110; width: 40; height: 40; source: "opaque-green.png" }
+
+    onEnterFinalStage: {
+        root.wide = true;
+        root.finalStageComplete = true;
+    }
+}
@@ -12,6 +12,11 @@
 #include <QtQuick>
 #include <QtQml>
 
+#include <QtCore/qtemporarydir.h>
+#if QT_CONFIG(process)
+#include <QtCore/qprocess.h>
+#endif
+
 #if QT_CONFIG(opengl)
 #include <private/qopenglcontext_p.h>
 #endif
@@ -19,6 +24,9 @@
 #include <private/qsgcontext_p.h>
 #include <private/qsgrenderloop_p.h>
 #include <private/qsgrhisupport_p.h>
+#if QT_CONFIG(thread)
+#include <private/qsgthreadedrenderloop_p.h>
+#endif
 #include <private/qsgplaintexture_p.h>
 
 #include <QtQuickTestUtils/private/qmlutils_p.h>
@@ -89,6 +97,13 @@ private slots:
 
     void render_data();
     void render();
+    void cullingMatchesNoCulling_data();
+    void cullingMatchesNoCulling();
+    void concurrentUploadMatchesSingleThreaded();
+#if QT_CONFIG(thread)
+    void lowLatencyDeadlines_data();
+    void lowLatencyDeadlines();
+#endif
 #if QT_CONFIG(opengl)
     void hideWithOtherContext();
 #endif
@@ -100,6 +115,10 @@ private slots:
 private:
     QQuickView *createView(const QString &file, QWindow *parent = nullptr, int x = -1, int y = -1, int w = -1, int h = -1);
     bool isRunningOnRhi();
+#if QT_CONFIG(process)
+    void compareStagesWithChildProcess(const QString &file, const QString &envName,
+                                       const QString &envValue);
+#endif
 };
 
 template <typename T> class ScopedList : public QList<T> {
@@ -365,7 +384,14 @@ void tst_SceneGraph::render_data()
           << "render_bug37422.qml"
           << "render_OpacityThroughBatchRoot.qml"
           << "render_Mipmap.qml"
-          << "render_AlphaOverlapRebuild.qml";
+          << "render_AlphaOverlapRebuild.qml"
+          << "render_CullingViewport.qml"
+          << "render_CullingOccluders.qml"
+          << "render_UploadMovingElement.qml"
+          << "render_UploadUnmergedGeometry.qml"
+          << "render_UploadStripOffsets.qml"
+          << "render_UploadFullFallback.qml"
+          << "render_UploadLargeBatch.qml";
 
     QRegularExpression sampleCount("#samples: *(\\d+)");
     //                          X:int   Y:int   R:float       G:float       B:float       Error:float
@@ -458,6 +484,156 @@ void tst_SceneGraph::render()
     }
 }
 
+void tst_SceneGraph::cullingMatchesNoCulling_data()
+{
+    QTest::addColumn<QString>("file");
+
+    QTest::newRow("viewport") << QStringLiteral("render_CullingViewport.qml");
+    QTest::newRow("occluders") << QStringLiteral("render_CullingOccluders.qml");
+    QTest::newRow("rotation") << QStringLiteral("render_CullingRotation.qml");
+}
+
+#if QT_CONFIG(process)
+/* Grabs the base and the final stage of file, and compares them with the ones
+ * grabbed by running the current test function in a child process, with
+ * envName set to envValue. For settings that are read once per process.
+ */
+void tst_SceneGraph::compareStagesWithChildProcess(const QString &file, const QString &envName,
+                                                   const QString &envValue)
+{
+    const char *grabKey = "QT_TST_SCENEGRAPH_GRAB_PATH";
+    const QString grabPath = qEnvironmentVariable(grabKey);
+
+    QQuickView view;
+    view.setSource(testFileUrl(file));
+    view.setResizeMode(QQuickView::SizeViewToRootObject);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    const QImage baseImage = view.grabWindow();
+    QQuickItem *rootItem = view.rootObject();
+    QMetaObject::invokeMethod(rootItem, "enterFinalStage");
+    QTRY_VERIFY(rootItem->property("finalStageComplete").toBool());
+    const QImage finalImage = view.grabWindow();
+
+    if (!grabPath.isEmpty()) {
+        QVERIFY(baseImage.save(grabPath + QLatin1String("/base.png")));
+        QVERIFY(finalImage.save(grabPath + QLatin1String("/final.png")));
+        return;
+    }
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString testFunction = QLatin1String(QTest::currentTestFunction());
+    if (QTest::currentDataTag())
+        testFunction += u':' + QLatin1String(QTest::currentDataTag());
+    QProcess child;
+    child.setProgram(QCoreApplication::applicationFilePath());
+    child.setArguments(QStringList(testFunction));
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    env.insert(envName, envValue);
+    env.insert(QLatin1String(grabKey), dir.path());
+    child.setProcessEnvironment(env);
+    child.start();
+    QVERIFY(child.waitForFinished());
+    QVERIFY2(child.exitCode() == 0, child.readAllStandardOutput().constData());
+
+    QString errorMessage;
+    const QImage expectedBase(dir.filePath(QLatin1String("base.png")));
+    QVERIFY2(compareImages(baseImage.convertToFormat(expectedBase.format()), expectedBase,
+                           &errorMessage),
+             qPrintable(errorMessage));
+    const QImage expectedFinal(dir.filePath(QLatin1String("final.png")));
+    QVERIFY2(compareImages(finalImage.convertToFormat(expectedFinal.format()), expectedFinal,
+                           &errorMessage),
+             qPrintable(errorMessage));
+}
+#endif
+
+// QSG_RENDERER_DEBUG is read once per process
+void tst_SceneGraph::cullingMatchesNoCulling()
+{
+#ifdef Q_OS_ANDROID
+    QSKIP("Android seems to have problems with QProcess");
+#endif
+#if !QT_CONFIG(process)
+    QSKIP("Needs QProcess");
+#else
+    if (!isRunningOnRhi())
+        QSKIP("Skipping complex rendering tests due to not running with QRhi");
+
+    QFETCH(QString, file);
+    compareStagesWithChildProcess(file, QLatin1String("QSG_RENDERER_DEBUG"),
+                                  QLatin1String("noculling"));
+#endif
+}
+
+/* Compares a merged batch of more than 8192 vertices, which is uploaded in
+ * chunks on several threads, with the one uploaded on the render thread.
+ */
+void tst_SceneGraph::concurrentUploadMatchesSingleThreaded()
+{
+#ifdef Q_OS_ANDROID
+    QSKIP("Android seems to have problems with QProcess");
+#endif
+#if !QT_CONFIG(process)
+    QSKIP("Needs QProcess");
+#else
+    if (!isRunningOnRhi())
+        QSKIP("Skipping complex rendering tests due to not running with QRhi");
+
+    compareStagesWithChildProcess(QStringLiteral("render_UploadLargeBatch.qml"),
+                                  QLatin1String("QSG_RENDERER_UPLOAD_THREADS"),
+                                  QLatin1String("4"));
+#endif
+}
+
+#if QT_CONFIG(thread)
+void tst_SceneGraph::lowLatencyDeadlines_data()
+{
+    // All in ms, with a vsync every 16 ms
+    QTest::addColumn<qint64>("lastPresent");
+    QTest::addColumn<qint64>("now");
+    QTest::addColumn<qint64>("work");
+    QTest::addColumn<qint64>("present");
+    QTest::addColumn<qint64>("delay");
+
+    QTest::newRow("never presented") << qint64(0) << qint64(5) << qint64(1)
+                                     << qint64(0) << qint64(0);
+    QTest::newRow("idle") << qint64(1000) << qint64(1065) << qint64(1)
+                          << qint64(0) << qint64(0);
+    QTest::newRow("just presented") << qint64(1000) << qint64(1000) << qint64(0)
+                                    << qint64(1016) << qint64(14);
+    QTest::newRow("next vsync") << qint64(1000) << qint64(1002) << qint64(5)
+                                << qint64(1016) << qint64(7);
+    // Without the margin the frame would be just in time for the first vsync
+    QTest::newRow("margin") << qint64(1000) << qint64(1004) << qint64(12)
+                            << qint64(1016) << qint64(14);
+    QTest::newRow("too late for the next vsync") << qint64(1000) << qint64(1010) << qint64(8)
+                                                 << qint64(1032) << qint64(12);
+    QTest::newRow("longer than a frame") << qint64(1000) << qint64(1002) << qint64(20)
+                                         << qint64(1032) << qint64(8);
+    QTest::newRow("frames skipped") << qint64(1000) << qint64(1040) << qint64(4)
+                                    << qint64(1048) << qint64(2);
+}
+
+void tst_SceneGraph::lowLatencyDeadlines()
+{
+    QFETCH(qint64, lastPresent);
+    QFETCH(qint64, now);
+    QFETCH(qint64, work);
+    QFETCH(qint64, present);
+    QFETCH(qint64, delay);
+
+    const qint64 ms = 1000000;
+    const qint64 interval = 16 * ms;
+
+    QCOMPARE(qsg_predictPresentTime(lastPresent * ms, interval, now * ms, work * ms),
+             present * ms);
+    QCOMPARE(qsg_syncDelay(lastPresent * ms, interval, now * ms, work * ms), delay * ms);
+}
+#endif
+
 #if QT_CONFIG(opengl)
 // Testcase for QTBUG-34898. We make another context current on another surface
 // in the GUI thread and hide the QQuickWindow while the other context is
@@ -0,0 +1,95 @@
+import QtQuick
+
+Rectangle {
+    width: 200
+    height: 200
+    color: "white"
+
+    function changeNode() {
+        inner.color = "orange"
+    }
+
+    function moveSubtree() {
+        group.x += 23
+        group.y -= 7
+    }
+
+    function removeSubtree() {
+        group.parent = null
+    }
+
+    Item {
+        x: 90
+        y: 100
+        width: 100
+        height: 90
+
+        Rectangle {
+            width: 100
+            height: 90
+            color: "#8040c040"
+        }
+
+        Rectangle {
+            x: 20
+            y: 20
+            width: 50
+            height: 50
+            rotation: 30
+            antialiasing: true
+            color: "purple"
+        }
+    }
+
+    Item {
+        id: group
+        x: 20
+        y: 20
+        width: 120
+        height: 120
+
+        Rectangle {
+            width: 120
+            height: 120
+            radius: 8
+            color: "#c0ffe080"
+        }
+
+        Image {
+            x: 10
+            y: 10
+            width: 60
+            height: 60
+            rotation: 15
+            source: "colors.png"
+        }
+
+        Item {
+            x: 50
+            y: 50
+            width: 60
+            height: 60
+            clip: true
+
+            Rectangle {
+                id: inner
+                x: 10
+                y: -10
+                width: 70
+                height: 50
+                rotation: -20
+                antialiasing: true
+                color: "steelblue"
+            }
+
+            Rectangle {
+                x: 30
+                y: 30
+                width: 40
+                height: 40
+                opacity: 0.5
+                color: "crimson"
+            }
+        }
+    }
+}
@@ -0,0 +1,87 @@
+import QtQuick
+
+Rectangle {
+    width: 200
+    height: 200
+    color: "white"
+
+    function change() {
+        rotated.rotation += 17
+        clipped.x += 13
+        faded.opacity = 0.3
+    }
+
+    Rectangle {
+        id: rotated
+        x: 30
+        y: 20
+        width: 120
+        height: 40
+        rotation: 33
+        antialiasing: true
+        color: "#80ff4000"
+        border.color: "navy"
+        border.width: 3
+    }
+
+    Image {
+        x: 70
+        y: 60
+        width: 110
+        height: 90
+        rotation: -12
+        source: "colors.png"
+    }
+
+    Item {
+        x: 10
+        y: 110
+        width: 90
+        height: 70
+        clip: true
+
+        Rectangle {
+            id: clipped
+            x: -20
+            y: 10
+            width: 100
+            height: 100
+            rotation: 20
+            antialiasing: true
+            color: "seagreen"
+        }
+    }
+
+    Item {
+        id: faded
+        x: 100
+        y: 120
+        width: 90
+        height: 70
+        opacity: 0.6
+
+        Rectangle {
+            width: 60
+            height: 60
+            radius: 10
+            color: "crimson"
+        }
+
+        Rectangle {
+            x: 25
+            y: 15
+            width: 60
+            height: 50
+            rotation: 45
+            antialiasing: true
+            color: "steelblue"
+        }
+    }
+
+    Text {
+        x: 5
+        y: 5
+        font.pixelSize: 24
+        text: "Tiles"
+    }
+}
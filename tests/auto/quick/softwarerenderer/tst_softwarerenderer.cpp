@@ -6,6 +6,7 @@
 #include <QGuiApplication>
 
 #include <private/qsgrenderloop_p.h>
+#include <private/qsgsoftwareblitter_p.h>
 
 #include <QtQuickTestUtils/private/qmlutils_p.h>
 #include <QtQuickTestUtils/private/viewtestutils_p.h>
@@ -22,8 +23,88 @@ private slots:
     void initTestCase() override;
 
     void renderTarget();
+    void blitterFillRect_data();
+    void blitterFillRect();
+    void blitterDrawImage_data();
+    void blitterDrawImage();
+    void tiledRendering_data();
+    void tiledRendering();
+    void layerCache_data();
+    void layerCache();
 };
 
+// Renders a scene into an image through QQuickRenderControl. The image is kept
+// between frames, so that later frames only repaint what has changed.
+class OffscreenScene
+{
+public:
+    OffscreenScene(QQmlEngine *engine, const QUrl &url);
+
+    QQuickItem *rootItem() const { return m_rootItem.data(); }
+    QImage renderFrame();
+
+private:
+    QQuickRenderControl m_renderControl;
+    QScopedPointer<QQuickWindow> m_window;
+    QScopedPointer<QQuickItem> m_rootItem;
+    QImage m_target;
+};
+
+OffscreenScene::OffscreenScene(QQmlEngine *engine, const QUrl &url)
+    : m_window(new QQuickWindow(&m_renderControl))
+{
+    QQmlComponent component(engine, url);
+    m_rootItem.reset(qobject_cast<QQuickItem *>(component.create()));
+    if (!m_rootItem) {
+        qWarning() << component.errorString();
+        return;
+    }
+    m_window->resize(m_rootItem->size().toSize());
+    m_rootItem->setParentItem(m_window->contentItem());
+
+    m_target = QImage(m_window->size(), QImage::Format_ARGB32_Premultiplied);
+    m_target.fill(Qt::transparent);
+    m_window->setRenderTarget(QQuickRenderTarget::fromPaintDevice(&m_target));
+}
+
+QImage OffscreenScene::renderFrame()
+{
+    m_renderControl.polishItems();
+    m_renderControl.beginFrame();
+    m_renderControl.sync();
+    m_renderControl.render();
+    m_renderControl.endFrame();
+    return m_target.copy();
+}
+
+// Every pixel different, with opaque, translucent and transparent ones when
+// the format has alpha
+static QImage blitterTestImage(QImage::Format format, const QSize &size, int seed)
+{
+    QImage image(size, format);
+    for (int y = 0; y < size.height(); ++y) {
+        for (int x = 0; x < size.width(); ++x) {
+            int alpha = 255;
+            if (image.hasAlphaChannel()) {
+                switch ((x + y + seed) % 4) {
+                case 0: alpha = 0; break;
+                case 1: alpha = 255; break;
+                default: alpha = (x * 29 + y * 13 + seed) % 256; break;
+                }
+            }
+            const QRgb color = qRgba((x * 37 + seed) % 256, (y * 53 + seed) % 256,
+                                     ((x + y) * 11 + seed) % 256, alpha);
+            image.setPixel(x, y, qPremultiply(color));
+        }
+    }
+    return image;
+}
+
+static QString blitterFormatName(QImage::Format format)
+{
+    return format == QImage::Format_RGB32 ? QStringLiteral("rgb32") : QStringLiteral("argb32pm");
+}
+
 tst_SoftwareRenderer::tst_SoftwareRenderer()
     : QQmlDataTest(QT_QMLTEST_DATADIR)
 {
@@ -93,6 +174,266 @@ void tst_SoftwareRenderer::renderTarget()
              qPrintable(errorMessage));
 }
 
+void tst_SoftwareRenderer::blitterFillRect_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+    QTest::addColumn<QColor>("color");
+    QTest::addColumn<bool>("blend");
+    QTest::addColumn<QRect>("rect");
+    QTest::addColumn<QRect>("clip");
+
+    const QList<std::pair<const char *, QColor>> colors = {
+        { "opaque", QColor(51, 102, 153) },
+        { "translucent", QColor(200, 40, 90, 128) },
+        { "faint", QColor(10, 250, 130, 3) },
+        { "transparent", QColor(255, 255, 255, 0) }
+    };
+    // Not multiples of 4 or 8, so that the SIMD loops have tails
+    const int widths[] = { 1, 3, 4, 5, 7, 8, 9, 13, 17, 31 };
+    const QRect noClip(0, 0, 40, 24);
+
+    for (QImage::Format format : { QImage::Format_ARGB32_Premultiplied, QImage::Format_RGB32 }) {
+        for (const auto &color : colors) {
+            for (bool blend : { true, false }) {
+                // Like QSGSoftwareRenderableNode, which leaves these to QPainter
+                if (!blend && format == QImage::Format_RGB32 && color.second.alpha() != 255)
+                    continue;
+                for (int width : widths) {
+                    const QString name = QString::fromLatin1("%1-%2-%3-%4")
+                            .arg(blitterFormatName(format), QLatin1String(color.first),
+                                 QLatin1String(blend ? "blend" : "source"))
+                            .arg(width);
+                    QTest::newRow(qPrintable(name))
+                            << format << color.second << blend << QRect(3, 2, width, 5) << noClip;
+                    QTest::newRow(qPrintable(name + QLatin1String("-clipped")))
+                            << format << color.second << blend << QRect(1, 1, width, 20)
+                            << QRect(2, 4, 11, 9);
+                }
+                QTest::newRow(qPrintable(QString::fromLatin1("%1-%2-%3-outside")
+                                                 .arg(blitterFormatName(format),
+                                                      QLatin1String(color.first),
+                                                      QLatin1String(blend ? "blend" : "source"))))
+                        << format << color.second << blend << QRect(-5, 20, 60, 10) << noClip;
+            }
+        }
+    }
+}
+
+void tst_SoftwareRenderer::blitterFillRect()
+{
+    QFETCH(QImage::Format, format);
+    QFETCH(QColor, color);
+    QFETCH(bool, blend);
+    QFETCH(QRect, rect);
+    QFETCH(QRect, clip);
+
+    QImage expected = blitterTestImage(format, QSize(40, 24), 0);
+    QImage actual = expected;
+
+    {
+        QPainter painter(&expected);
+        painter.setClipRect(clip);
+        painter.setCompositionMode(blend ? QPainter::CompositionMode_SourceOver
+                                         : QPainter::CompositionMode_Source);
+        painter.fillRect(rect, color);
+    }
+
+    QVERIFY(QSGSoftwareBlitter::isSupportedFormat(actual.format()));
+    QSGSoftwareBlitter::fillRect(&actual, rect, qPremultiply(color.rgba()), blend, clip);
+
+    QCOMPARE(actual, expected);
+}
+
+void tst_SoftwareRenderer::blitterDrawImage_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+    QTest::addColumn<QImage::Format>("sourceFormat");
+    QTest::addColumn<bool>("blend");
+    QTest::addColumn<QRect>("sourceRect");
+    QTest::addColumn<int>("scale");
+    QTest::addColumn<QRect>("clip");
+
+    const QImage::Format formats[] = { QImage::Format_ARGB32_Premultiplied, QImage::Format_RGB32 };
+    const int widths[] = { 1, 3, 4, 5, 7, 8, 9, 13, 17 };
+    const QRect noClip(0, 0, 64, 40);
+
+    for (QImage::Format format : formats) {
+        for (QImage::Format sourceFormat : formats) {
+            for (bool blend : { true, false }) {
+                if (!blend && format == QImage::Format_RGB32 && sourceFormat != QImage::Format_RGB32)
+                    continue;
+                for (int scale : { 1, 2, 3 }) {
+                    for (int width : widths) {
+                        const QString name = QString::fromLatin1("%1-on-%2-%3-x%4-%5")
+                                .arg(blitterFormatName(sourceFormat), blitterFormatName(format),
+                                     QLatin1String(blend ? "blend" : "source"))
+                                .arg(scale).arg(width);
+                        QTest::newRow(qPrintable(name))
+                                << format << sourceFormat << blend << QRect(1, 2, width, 4)
+                                << scale << noClip;
+                        QTest::newRow(qPrintable(name + QLatin1String("-clipped")))
+                                << format << sourceFormat << blend << QRect(2, 0, width, 9)
+                                << scale << QRect(5, 4, 13, 11);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void tst_SoftwareRenderer::blitterDrawImage()
+{
+    QFETCH(QImage::Format, format);
+    QFETCH(QImage::Format, sourceFormat);
+    QFETCH(bool, blend);
+    QFETCH(QRect, sourceRect);
+    QFETCH(int, scale);
+    QFETCH(QRect, clip);
+
+    const QImage source = blitterTestImage(sourceFormat, QSize(20, 12), 7);
+    const QRect targetRect(QPoint(3, 1), sourceRect.size() * scale);
+
+    QImage expected = blitterTestImage(format, QSize(64, 40), 0);
+    QImage actual = expected;
+
+    {
+        QPainter painter(&expected);
+        painter.setClipRect(clip);
+        painter.setCompositionMode(blend ? QPainter::CompositionMode_SourceOver
+                                         : QPainter::CompositionMode_Source);
+        painter.drawImage(QRectF(targetRect), source, QRectF(sourceRect));
+    }
+
+    QSGSoftwareBlitter::drawImage(&actual, targetRect, source, sourceRect, blend, clip);
+
+    QCOMPARE(actual, expected);
+}
+
+void tst_SoftwareRenderer::tiledRendering_data()
+{
+    QTest::addColumn<QByteArray>("tileSize");
+
+    QTest::newRow("7") << QByteArray("7");
+    QTest::newRow("32") << QByteArray("32");
+    QTest::newRow("50") << QByteArray("50");
+    QTest::newRow("128") << QByteArray("128");
+}
+
+void tst_SoftwareRenderer::tiledRendering()
+{
+    if (QQuickWindow::sceneGraphBackend() != "software")
+        QSKIP("Skipping complex rendering tests due to not running with software");
+    if (QThread::idealThreadCount() < 2)
+        QSKIP("Tiles are only rendered with more than one thread");
+
+    QFETCH(QByteArray, tileSize);
+
+    QQmlEngine engine;
+    OffscreenScene plain(&engine, testFileUrl("tiles.qml"));
+    QVERIFY(plain.rootItem());
+    // The tile size is read when the renderer is created, in the first frame
+    const QImage plainImage = plain.renderFrame();
+
+    qputenv("QSG_SOFTWARE_TILE_SIZE", tileSize);
+    const auto unsetTileSize = qScopeGuard([]() { qunsetenv("QSG_SOFTWARE_TILE_SIZE"); });
+    OffscreenScene tiled(&engine, testFileUrl("tiles.qml"));
+    QVERIFY(tiled.rootItem());
+
+    // Everything is painted in the first frame, only what changed in the second
+    QCOMPARE(tiled.renderFrame(), plainImage);
+
+    QVERIFY(QMetaObject::invokeMethod(plain.rootItem(), "change"));
+    QVERIFY(QMetaObject::invokeMethod(tiled.rootItem(), "change"));
+    QCOMPARE(tiled.renderFrame(), plain.renderFrame());
+}
+
+// The number of layers the last frame had in the cache, from the renderer's
+// debug output
+static int cachedLayers = -1;
+static QtMessageHandler previousMessageHandler = nullptr;
+
+static void layerCacheMessageHandler(QtMsgType type, const QMessageLogContext &context,
+                                     const QString &message)
+{
+    static const QRegularExpression layerCacheMessage(
+            QStringLiteral("^layer cache: (\\d+) layers"));
+    const QRegularExpressionMatch match = layerCacheMessage.match(message);
+    if (match.hasMatch())
+        cachedLayers = match.captured(1).toInt();
+    else if (previousMessageHandler)
+        previousMessageHandler(type, context, message);
+}
+
+void tst_SoftwareRenderer::layerCache_data()
+{
+    QTest::addColumn<QByteArray>("change");
+
+    QTest::newRow("change node") << QByteArray("changeNode");
+    QTest::newRow("move subtree") << QByteArray("moveSubtree");
+    QTest::newRow("remove subtree") << QByteArray("removeSubtree");
+}
+
+void tst_SoftwareRenderer::layerCache()
+{
+    if (QQuickWindow::sceneGraphBackend() != "software")
+        QSKIP("Skipping complex rendering tests due to not running with software");
+
+    QFETCH(QByteArray, change);
+
+    QLoggingCategory::setFilterRules(
+            QStringLiteral("qt.scenegraph.softwarecontext.abstractrenderer.debug=true"));
+    cachedLayers = -1;
+    previousMessageHandler = qInstallMessageHandler(layerCacheMessageHandler);
+    const auto restoreLogging = qScopeGuard([]() {
+        qInstallMessageHandler(previousMessageHandler);
+        QLoggingCategory::setFilterRules(QString());
+    });
+
+    QQmlEngine engine;
+    OffscreenScene plain(&engine, testFileUrl("layers.qml"));
+    QVERIFY(plain.rootItem());
+    // The cache size is read when the renderer is created, in the first frame
+    const QImage plainImage = plain.renderFrame();
+
+    qputenv("QSG_SOFTWARE_LAYER_CACHE_SIZE", "16");
+    const auto unsetCacheSize = qScopeGuard([]() {
+        qunsetenv("QSG_SOFTWARE_LAYER_CACHE_SIZE");
+    });
+    OffscreenScene cached(&engine, testFileUrl("layers.qml"));
+    QVERIFY(cached.rootItem());
+
+    // Layers are composed onto the scene instead of painting their nodes
+    // directly, which may round translucent pixels differently
+    QString errorMessage;
+    const auto compareFrames = [&](int frames) {
+        for (int i = 0; i < frames; ++i) {
+            const QImage cachedImage = cached.renderFrame();
+            if (!QQuickVisualTestUtils::compareImages(cachedImage, plain.renderFrame(),
+                                                      &errorMessage)) {
+                errorMessage.prepend(QStringLiteral("Frame %1: ").arg(i));
+                return false;
+            }
+        }
+        return true;
+    };
+
+    QVERIFY2(QQuickVisualTestUtils::compareImages(cached.renderFrame(), plainImage,
+                                                  &errorMessage),
+             qPrintable(errorMessage));
+
+    // The subtrees are cached after 10 unchanged frames
+    QVERIFY2(compareFrames(12), qPrintable(errorMessage));
+    QVERIFY(cachedLayers > 0);
+
+    QVERIFY(QMetaObject::invokeMethod(plain.rootItem(), change.constData()));
+    QVERIFY(QMetaObject::invokeMethod(cached.rootItem(), change.constData()));
+    QVERIFY2(compareFrames(1), qPrintable(errorMessage));
+
+    // And cached again once they stay the same
+    QVERIFY2(compareFrames(12), qPrintable(errorMessage));
+    QVERIFY(cachedLayers > 0);
+}
+
 #include "tst_softwarerenderer.moc"
 
 QTEST_MAIN(tst_SoftwareRenderer)
@@ -15,7 +15,7 @@ class MyQmlObject : public QObject
     Q_PROPERTY(QQmlListProperty<QObject> data READ data)
     Q_CLASSINFO("DefaultProperty", "data")
 public:
-    MyQmlObject() : m_result(0), m_value(0), m_object(0) {}
+    MyQmlObject() : m_result(0), m_value(0), m_object(0), m_evaluations(0) {}
 
     int result() const { return m_result; }
     void setResult(int r) { m_result = r; }
@@ -28,6 +28,10 @@ public:
     MyQmlObject *object() const { return m_object; }
     void setObject(MyQmlObject *o) { m_object = o; emit objectChanged(); }
 
+    Q_INVOKABLE int countEvaluation(int v) { ++m_evaluations; return v; }
+    int evaluations() const { return m_evaluations; }
+    void resetEvaluations() { m_evaluations = 0; }
+
 signals:
     void valueChanged();
     void objectChanged();
@@ -37,6 +41,7 @@ private:
     int m_result;
     int m_value;
     MyQmlObject *m_object;
+    int m_evaluations;
 };
 QML_DECLARE_TYPE(MyQmlObject);
 
@@ -7,6 +7,8 @@
 #include <QQmlComponent>
 #include <QFile>
 #include <QDebug>
+#include <QtCore/qscopeguard.h>
+#include <private/qqmlengine_p.h>
 #include "testtypes.h"
 
 class tst_binding : public QObject
@@ -28,6 +30,8 @@ private slots:
     void basicproperty();
     void creation_data();
     void creation();
+    void fanout_data();
+    void fanout();
 
 private:
     QQmlEngine engine;
@@ -150,5 +154,47 @@ void tst_binding::creation()
     }
 }
 
+void tst_binding::fanout_data()
+{
+    QTest::addColumn<bool>("batched");
+
+    QTest::newRow("immediate") << false;
+    QTest::newRow("batched") << true;
+}
+
+void tst_binding::fanout()
+{
+    QFETCH(bool, batched);
+
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(&engine);
+    ep->batchedBindingUpdates = batched;
+    auto guard = qScopeGuard([ep]() { ep->batchedBindingUpdates = false; });
+
+    COMPONENT(SRCDIR "/data/fanout.txt", QString());
+
+    QScopedPointer<MyQmlObject> object(qobject_cast<MyQmlObject *>(c.create()));
+    QVERIFY(object);
+
+    int value = 0;
+    const auto change = [&]() {
+        object->setValue(++value);
+        if (batched)
+            ep->flushDirtyBindings();
+    };
+
+    change();
+    object->resetEvaluations();
+    change();
+
+    // The result depends on eight properties that all depend on value. Updated one by
+    // one, each of them re-evaluates the result. Batched, the result is evaluated once.
+    QCOMPARE(object->evaluations(), batched ? 1 : 8);
+    QCOMPARE(object->result(), 8 * value + 36);
+
+    QBENCHMARK {
+        change();
+    }
+}
+
 QTEST_MAIN(tst_binding)
 #include "tst_binding.moc"
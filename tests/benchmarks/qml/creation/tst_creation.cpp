@@ -6,9 +6,18 @@
 #include <QQmlComponent>
 #include <private/qqmlmetatype_p.h>
 #include <QDebug>
+#include <QFile>
 #include <QQuickItem>
 #include <QQmlContext>
 #include <private/qobject_p.h>
+#include <private/qqmldata_p.h>
+
+#include <memory>
+#include <vector>
+
+#if defined(Q_OS_LINUX)
+#include <unistd.h>
+#endif
 
 class tst_creation : public QObject
 {
@@ -46,6 +55,9 @@ private slots:
     void anchors_creation();
     void anchors_heightChange();
 
+    void multipleEngines_data();
+    void multipleEngines();
+
 private:
     QQmlEngine engine;
 };
@@ -419,6 +431,65 @@ void tst_creation::anchors_heightChange()
     delete obj;
 }
 
+static qint64 residentSetSize()
+{
+#if defined(Q_OS_LINUX)
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (!statm.open(QIODevice::ReadOnly))
+        return -1;
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2)
+        return -1;
+    return fields.at(1).toLongLong() * qint64(sysconf(_SC_PAGESIZE));
+#else
+    return -1;
+#endif
+}
+
+void tst_creation::multipleEngines_data()
+{
+    QTest::addColumn<int>("engineCount");
+
+    QTest::newRow("1 engine") << 1;
+    QTest::newRow("4 engines") << 4;
+    QTest::newRow("16 engines") << 16;
+}
+
+// Reports the resident memory each additional engine costs when all of them load the same
+// document. Property caches of C++ types are process-wide and must not be duplicated.
+void tst_creation::multipleEngines()
+{
+    QFETCH(int, engineCount);
+
+    std::vector<std::unique_ptr<QQmlEngine>> engines;
+    std::vector<std::unique_ptr<QObject>> objects;
+    QQmlPropertyCache::ConstPtr itemCache;
+
+    const qint64 before = residentSetSize();
+    for (int i = 0; i < engineCount; ++i) {
+        engines.push_back(std::make_unique<QQmlEngine>());
+        QQmlComponent component(engines.back().get(), TEST_FILE("itemWithProperties.qml"));
+        QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+        objects.emplace_back(component.create());
+        QVERIFY(objects.back());
+
+        const QQmlData *ddata = QQmlData::get(objects.back().get());
+        QVERIFY(ddata && ddata->propertyCache);
+        const QQmlPropertyCache::ConstPtr parentCache = ddata->propertyCache->parent();
+        QVERIFY(parentCache);
+        if (itemCache)
+            QCOMPARE(parentCache.data(), itemCache.data());
+        else
+            itemCache = parentCache;
+    }
+    const qint64 after = residentSetSize();
+
+    if (before < 0 || after < 0)
+        QSKIP("Resident set size is not available on this platform");
+
+    QTest::setBenchmarkResult(qreal(after - before) / engineCount, QTest::BytesAllocated);
+}
+
 QTEST_MAIN(tst_creation)
 
 #include "tst_creation.moc"
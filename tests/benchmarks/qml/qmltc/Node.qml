@@ -0,0 +1,26 @@
+import QtQuick
+
+Rectangle {
+    id: node
+    property int level: 0
+    property real ratio: 0.5
+    readonly property real area: width * height
+
+    width: parent ? parent.width * ratio : 100
+    height: parent ? parent.height * ratio : 100
+    color: level % 2 ? "steelblue" : "lightgray"
+    opacity: area > 100 ? 1.0 : 0.5
+    border.width: level + 1
+    border.color: Qt.darker(color)
+
+    signal activated(int level)
+    onActivated: (level) => node.ratio = level > 2 ? 0.25 : 0.5
+    onWidthChanged: label.visible = width > 20
+
+    Text {
+        id: label
+        anchors.centerIn: parent
+        text: "level " + node.level
+        font.pixelSize: Math.max(8, node.height / 4)
+    }
+}
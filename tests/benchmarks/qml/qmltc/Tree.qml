@@ -0,0 +1,38 @@
+import QtQuick
+
+Item {
+    id: root
+    width: 640
+    height: 480
+    property int depth: 3
+
+    Node {
+        id: left
+        level: 0
+        Node {
+            level: left.level + 1
+            Node { level: left.level + 2 }
+            Node { level: left.level + 2; ratio: 0.25 }
+        }
+        Node {
+            level: left.level + 1
+            x: parent.width / 2
+            NumberAnimation on x { from: 0; to: 100; running: false }
+        }
+    }
+
+    Node {
+        id: right
+        level: 1
+        x: root.width / 2
+        Node {
+            level: right.level + 1
+            Node { level: right.level + 2; visible: root.depth > 2 }
+            Node { level: right.level + 2; y: parent.height / 2 }
+        }
+        Node {
+            level: right.level + 1
+            Behavior on opacity { NumberAnimation { duration: 100 } }
+        }
+    }
+}
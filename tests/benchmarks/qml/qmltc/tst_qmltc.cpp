@@ -0,0 +1,46 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QQmlEngine>
+#include <QQmlComponent>
+
+#include "tree.h"
+
+class tst_qmltc : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void qmltc();
+    void qqmlcomponent();
+
+private:
+    QQmlEngine engine;
+};
+
+void tst_qmltc::qmltc()
+{
+    // Warm up, so that the compilation unit is loaded outside of the benchmark
+    delete new QmltcBenchmark::Tree(&engine);
+
+    QBENCHMARK {
+        QmltcBenchmark::Tree tree(&engine);
+    }
+}
+
+void tst_qmltc::qqmlcomponent()
+{
+    // Compilation is not part of the benchmark, only the creation of the tree
+    QQmlComponent c(&engine, QUrl(QStringLiteral("qrc:/qt/qml/QmltcBenchmark/Tree.qml")));
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    delete c.create();
+
+    QBENCHMARK {
+        QObject *obj = c.create();
+        delete obj;
+    }
+}
+
+QTEST_MAIN(tst_qmltc)
+#include "tst_qmltc.moc"
@@ -0,0 +1,34 @@
+import QtQuick
+
+// One level of clipping, with the next level inside
+Item {
+    id: level
+    clip: true
+
+    property int depth
+    property int frame
+
+    Rectangle {
+        anchors.fill: parent
+        color: level.depth % 2 ? "steelblue" : "lightsteelblue"
+    }
+
+    // Moves inside all the clips around it
+    Rectangle {
+        x: level.frame % 10
+        width: 4
+        height: 4
+        color: "red"
+    }
+
+    Loader {
+        anchors.fill: parent
+        anchors.margins: 2
+        active: level.depth > 0
+        source: "ClipLevel.qml"
+        onLoaded: {
+            item.depth = level.depth - 1
+            item.frame = Qt.binding(() => level.frame)
+        }
+    }
+}
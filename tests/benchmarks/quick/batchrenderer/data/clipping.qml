@@ -0,0 +1,25 @@
+import QtQuick
+
+Item {
+    id: root
+    width: 400
+    height: 400
+
+    property int frame
+
+    Grid {
+        columns: 4
+        Repeater {
+            model: 16
+            ClipLevel {
+                required property int index
+                width: 100
+                height: 100
+                depth: 15
+                frame: root.frame
+                // Rotated clips need the stencil buffer instead of scissoring
+                rotation: index % 2 ? 5 : 0
+            }
+        }
+    }
+}
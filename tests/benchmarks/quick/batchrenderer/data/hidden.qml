@@ -0,0 +1,34 @@
+import QtQuick
+
+// Most of the moving rectangles are either outside of the window or behind
+// the opaque panel on top of them
+Item {
+    id: root
+    width: 400
+    height: 400
+
+    property int frame
+
+    Grid {
+        x: -400 + root.frame % 2
+        columns: 80
+        Repeater {
+            model: 3200
+            Rectangle {
+                width: 10
+                height: 10
+                color: "steelblue"
+                border.width: 1
+                border.color: "black"
+            }
+        }
+    }
+
+    Rectangle {
+        x: 20
+        y: 20
+        width: 360
+        height: 360
+        color: "white"
+    }
+}
@@ -0,0 +1,24 @@
+import QtQuick
+
+// Every rectangle switches between opaque and translucent in each frame
+Item {
+    id: root
+    width: 400
+    height: 400
+
+    property int frame
+
+    Grid {
+        columns: 40
+        Repeater {
+            model: 1600
+            Rectangle {
+                required property int index
+                width: 10
+                height: 10
+                color: "steelblue"
+                opacity: (index + root.frame) % 2 ? 1 : 0.5
+            }
+        }
+    }
+}
@@ -0,0 +1,23 @@
+import QtQuick
+
+// Rectangles of the same color end up in one merged, opaque batch
+Item {
+    id: root
+    width: 400
+    height: 400
+
+    property int frame
+    property real offset: frame % 2
+    property int moving: -1
+
+    Repeater {
+        model: 5000
+        Rectangle {
+            x: (index % 100) * 4 + (root.moving < 0 || root.moving === index ? root.offset : 0)
+            y: Math.floor(index / 100) * 8
+            width: 3
+            height: 6
+            color: "steelblue"
+        }
+    }
+}
@@ -0,0 +1,19 @@
+import QtQuick
+
+// Scrolls through a list of text delegates, creating new ones on the way
+ListView {
+    id: root
+    width: 400
+    height: 400
+
+    property int frame
+    contentY: (frame % 500) * 4
+
+    model: 1000
+    delegate: Text {
+        required property int index
+        width: ListView.view.width
+        height: 20
+        text: "Item " + index + ": The quick brown fox jumps over the lazy dog"
+    }
+}
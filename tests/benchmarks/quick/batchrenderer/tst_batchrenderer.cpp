@@ -0,0 +1,287 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QScopeGuard>
+#include <QtQml/QQmlComponent>
+#include <QtQml/QQmlEngine>
+#include <QtQuick/QQuickItem>
+#include <QtQuick/QQuickRenderControl>
+#include <QtQuick/QQuickRenderTarget>
+#include <QtQuick/QQuickWindow>
+#include <QtQuick/private/qquickwindow_p.h>
+#include <QtQuick/private/qsgrenderer_p.h>
+#include <QtQuickTestUtils/private/qmlutils_p.h>
+
+#include <rhi/qrhi.h>
+
+#include <memory>
+#include <utility>
+
+// Renders a scene with QQuickRenderControl on the Null QRhi backend, so that
+// only the CPU side of the renderer is measured.
+class NullRhiScene
+{
+public:
+    NullRhiScene()
+        : renderControl(new QQuickRenderControl)
+        , window(new QQuickWindow(renderControl.get()))
+    {
+    }
+
+    ~NullRhiScene()
+    {
+        // The QRhi belongs to the render control
+        renderTarget.reset();
+        renderPassDescriptor.reset();
+        depthStencil.reset();
+        texture.reset();
+        root.reset();
+        window.reset();
+        renderControl.reset();
+    }
+
+    bool load(const QUrl &url)
+    {
+        QQmlComponent component(&engine, url);
+        root.reset(qobject_cast<QQuickItem *>(component.create()));
+        if (!root) {
+            qWarning() << component.errors();
+            return false;
+        }
+        const QSize size = root->size().toSize();
+        window->contentItem()->setSize(size);
+        window->setGeometry(0, 0, size.width(), size.height());
+        root->setParentItem(window->contentItem());
+
+        if (!renderControl->initialize())
+            return false;
+        QRhi *rhi = renderControl->rhi();
+        texture.reset(rhi->newTexture(QRhiTexture::RGBA8, size, 1, QRhiTexture::RenderTarget));
+        if (!texture->create())
+            return false;
+        depthStencil.reset(rhi->newRenderBuffer(QRhiRenderBuffer::DepthStencil, size, 1));
+        if (!depthStencil->create())
+            return false;
+        QRhiTextureRenderTargetDescription description{ QRhiColorAttachment(texture.get()) };
+        description.setDepthStencilBuffer(depthStencil.get());
+        renderTarget.reset(rhi->newTextureRenderTarget(description));
+        renderPassDescriptor.reset(renderTarget->newCompatibleRenderPassDescriptor());
+        renderTarget->setRenderPassDescriptor(renderPassDescriptor.get());
+        if (!renderTarget->create())
+            return false;
+        window->setRenderTarget(QQuickRenderTarget::fromRhiRenderTarget(renderTarget.get()));
+        return true;
+    }
+
+    void renderFrame()
+    {
+        renderControl->polishItems();
+        renderControl->beginFrame();
+        renderControl->sync();
+        renderControl->render();
+        renderControl->endFrame();
+    }
+
+    std::unique_ptr<QQuickRenderControl> renderControl;
+    std::unique_ptr<QQuickWindow> window;
+    QQmlEngine engine;
+    std::unique_ptr<QQuickItem> root;
+    std::unique_ptr<QRhiTexture> texture;
+    std::unique_ptr<QRhiRenderBuffer> depthStencil;
+    std::unique_ptr<QRhiTextureRenderTarget> renderTarget;
+    std::unique_ptr<QRhiRenderPassDescriptor> renderPassDescriptor;
+};
+
+// The renderer's timings are only taken while QSG_LOG_TIME_RENDERER is
+// enabled, but there is no need to see them for every frame
+static QtMessageHandler defaultMessageHandler = nullptr;
+
+static void dropRendererTimings(QtMsgType type, const QMessageLogContext &context,
+                                const QString &message)
+{
+    if (qstrcmp(context.category, "qt.scenegraph.time.renderer") != 0)
+        defaultMessageHandler(type, context, message);
+}
+
+class tst_batchrenderer : public QQmlDataTest
+{
+    Q_OBJECT
+
+public:
+    enum Phase {
+        Update, // QSGRenderer::preprocess() and updating the nodes
+        BuildBatches,
+        Upload,
+        Record
+    };
+    Q_ENUM(Phase)
+
+    tst_batchrenderer();
+
+private slots:
+    void initTestCase() override;
+    void render_data();
+    void render();
+    void phases_data();
+    void phases();
+    void moveAll_data();
+    void moveAll();
+    void moveOne();
+};
+
+tst_batchrenderer::tst_batchrenderer()
+    : QQmlDataTest(QT_QMLTEST_DATADIR)
+{
+}
+
+void tst_batchrenderer::initTestCase()
+{
+    QQmlDataTest::initTestCase();
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::Null);
+}
+
+void tst_batchrenderer::render_data()
+{
+    QTest::addColumn<QString>("scene");
+
+    QTest::newRow("rectangles") << QStringLiteral("rectangles.qml");
+    QTest::newRow("text list") << QStringLiteral("textlist.qml");
+    QTest::newRow("deep clipping") << QStringLiteral("clipping.qml");
+    QTest::newRow("opacity churn") << QStringLiteral("opacity.qml");
+    QTest::newRow("hidden") << QStringLiteral("hidden.qml");
+}
+
+// Each scene changes something in every frame depending on its frame property
+void tst_batchrenderer::render()
+{
+    QFETCH(QString, scene);
+
+    NullRhiScene nullRhiScene;
+    QVERIFY(nullRhiScene.load(testFileUrl(scene)));
+    nullRhiScene.renderFrame();
+
+    int frame = 0;
+    QBENCHMARK {
+        nullRhiScene.root->setProperty("frame", ++frame);
+        nullRhiScene.renderFrame();
+    }
+}
+
+void tst_batchrenderer::phases_data()
+{
+    QTest::addColumn<QString>("scene");
+    QTest::addColumn<Phase>("phase");
+
+    const std::pair<const char *, QString> scenes[] = {
+        { "rectangles", QStringLiteral("rectangles.qml") },
+        { "text list", QStringLiteral("textlist.qml") },
+        { "deep clipping", QStringLiteral("clipping.qml") },
+        { "opacity churn", QStringLiteral("opacity.qml") },
+        { "hidden", QStringLiteral("hidden.qml") },
+    };
+    const std::pair<const char *, Phase> phases[] = {
+        { "update", Update },
+        { "build batches", BuildBatches },
+        { "upload", Upload },
+        { "record", Record },
+    };
+    for (const auto &scene : scenes) {
+        for (const auto &phase : phases) {
+            QTest::addRow("%s: %s", scene.first, phase.first) << scene.second << phase.second;
+        }
+    }
+}
+
+// Reports the average time of one phase of the renderer per frame, as
+// measured by the renderer itself
+void tst_batchrenderer::phases()
+{
+    QFETCH(QString, scene);
+    QFETCH(Phase, phase);
+
+    QLoggingCategory::setFilterRules(QStringLiteral("qt.scenegraph.time.renderer.debug=true"));
+    defaultMessageHandler = qInstallMessageHandler(dropRendererTimings);
+    const auto reset = qScopeGuard([] {
+        qInstallMessageHandler(defaultMessageHandler);
+        QLoggingCategory::setFilterRules(QString());
+    });
+
+    NullRhiScene nullRhiScene;
+    QVERIFY(nullRhiScene.load(testFileUrl(scene)));
+    nullRhiScene.renderFrame();
+    QSGRenderer *renderer = QQuickWindowPrivate::get(nullRhiScene.window.get())->renderer;
+    QVERIFY(renderer);
+
+    const int frames = 100;
+    qint64 total = 0;
+    for (int frame = 1; frame <= frames; ++frame) {
+        nullRhiScene.root->setProperty("frame", frame);
+        nullRhiScene.renderFrame();
+        const QSGRenderer::Timings &timings = renderer->timings();
+        switch (phase) {
+        case Update:
+            total += timings.preprocess + timings.update;
+            break;
+        case BuildBatches:
+            total += timings.buildBatches;
+            break;
+        case Upload:
+            total += timings.upload;
+            break;
+        case Record:
+            total += timings.record;
+            break;
+        }
+    }
+    QTest::setBenchmarkResult(qreal(total) / frames, QTest::WalltimeNanoseconds);
+}
+
+void tst_batchrenderer::moveAll_data()
+{
+    QTest::addColumn<int>("uploadThreads");
+
+    QTest::newRow("render thread only") << 0;
+    QTest::newRow("4 upload threads") << 4;
+}
+
+// Every rectangle moves, so the whole merged batch is transformed and
+// uploaded again
+void tst_batchrenderer::moveAll()
+{
+    QFETCH(int, uploadThreads);
+
+    // Read when the renderer is created
+    qputenv("QSG_RENDERER_UPLOAD_THREADS", QByteArray::number(uploadThreads));
+    const auto resetEnvironment = qScopeGuard([] { qunsetenv("QSG_RENDERER_UPLOAD_THREADS"); });
+
+    NullRhiScene scene;
+    QVERIFY(scene.load(testFileUrl("rectangles.qml")));
+    scene.renderFrame();
+
+    int frame = 0;
+    QBENCHMARK {
+        scene.root->setProperty("offset", ++frame % 2);
+        scene.renderFrame();
+    }
+}
+
+// Only one rectangle of the batch moves
+void tst_batchrenderer::moveOne()
+{
+    NullRhiScene scene;
+    QVERIFY(scene.load(testFileUrl("rectangles.qml")));
+    scene.root->setProperty("moving", 2500);
+    scene.renderFrame();
+
+    int frame = 0;
+    QBENCHMARK {
+        scene.root->setProperty("offset", ++frame % 2);
+        scene.renderFrame();
+    }
+}
+
+QTEST_MAIN(tst_batchrenderer)
+
+#include "tst_batchrenderer.moc"
@@ -0,0 +1,61 @@
+import QtQuick
+
+Item {
+    id: root
+    width: 400
+    height: 400
+
+    property string kind
+
+    Component {
+        id: rectangle
+        Rectangle { width: 20; height: 20; color: "steelblue" }
+    }
+    Component {
+        id: translucentRectangle
+        Rectangle { width: 20; height: 20; color: "#804682b4" }
+    }
+    Component {
+        id: image
+        Image { source: "opaque.png" }
+    }
+    Component {
+        id: translucentImage
+        Image { source: "translucent.png" }
+    }
+    Component {
+        id: borderImage
+        BorderImage {
+            width: 20; height: 20
+            source: "border.png"
+            border { left: 2; top: 2; right: 2; bottom: 2 }
+            smooth: false
+        }
+    }
+
+    Grid {
+        columns: 20
+        Repeater {
+            model: 400
+            Loader {
+                sourceComponent: {
+                    switch (root.kind) {
+                    case "rectangle": return rectangle
+                    case "translucentRectangle": return translucentRectangle
+                    case "image": return image
+                    case "translucentImage": return translucentImage
+                    case "borderImage": return borderImage
+                    }
+                    return null
+                }
+            }
+        }
+    }
+
+    // Changing its color makes the whole scene dirty
+    Rectangle {
+        objectName: "overlay"
+        anchors.fill: parent
+        color: "#01000000"
+    }
+}
@@ -0,0 +1,74 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtQuick/QQuickView>
+#include <QtQuick/QQuickItem>
+#include <QtQuick/QSGRendererInterface>
+#include <QtQuickTestUtils/private/qmlutils_p.h>
+
+// Paints 400 items of the same kind with the software backend, every frame
+// repainting the whole window. Run with QSG_SOFTWARE_DISABLE_BLIT=1 to
+// compare against drawing everything with QPainter.
+class tst_softwarerenderer : public QQmlDataTest
+{
+    Q_OBJECT
+
+public:
+    tst_softwarerenderer();
+
+private slots:
+    void initTestCase() override;
+    void paint_data();
+    void paint();
+};
+
+tst_softwarerenderer::tst_softwarerenderer()
+    : QQmlDataTest(QT_QMLTEST_DATADIR)
+{
+}
+
+void tst_softwarerenderer::initTestCase()
+{
+    QQmlDataTest::initTestCase();
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+}
+
+void tst_softwarerenderer::paint_data()
+{
+    QTest::addColumn<QString>("kind");
+
+    QTest::newRow("rectangles") << QStringLiteral("rectangle");
+    QTest::newRow("translucentRectangles") << QStringLiteral("translucentRectangle");
+    QTest::newRow("images") << QStringLiteral("image");
+    QTest::newRow("translucentImages") << QStringLiteral("translucentImage");
+    QTest::newRow("borderImages") << QStringLiteral("borderImage");
+}
+
+void tst_softwarerenderer::paint()
+{
+    QFETCH(QString, kind);
+
+    QQuickView window;
+    window.setInitialProperties({ { QStringLiteral("kind"), kind } });
+    window.setSource(testFileUrl("nodes.qml"));
+    QCOMPARE(window.status(), QQuickView::Ready);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    QQuickItem *overlay = window.rootObject()->findChild<QQuickItem *>(QStringLiteral("overlay"));
+    QVERIFY(overlay);
+
+    // grabWindow() only repaints what changed, so make everything change
+    const QColor colors[] = { QColor(0, 0, 0, 1), QColor(0, 0, 0, 2) };
+    int frame = 0;
+    QBENCHMARK {
+        overlay->setProperty("color", colors[++frame % 2]);
+        const QImage image = window.grabWindow();
+        QVERIFY(!image.isNull());
+    }
+}
+
+QTEST_MAIN(tst_softwarerenderer)
+
+#include "tst_softwarerenderer.moc"
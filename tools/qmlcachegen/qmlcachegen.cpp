@@ -11,6 +11,8 @@
 #include <QSaveFile>
 #include <QScopedPointer>
 #include <QScopeGuard>
+#include <QThread>
+#include <QThreadPool>
 #include <QLibraryInfo>
 #include <QLoggingCategory>
 
@@ -20,9 +22,14 @@
 #include <private/qqmljsresourcefilemapper_p.h>
 #include <private/qqmljsloadergenerator_p.h>
 #include <private/qqmljscompiler_p.h>
+#include <private/qqmljscompilationcache_p.h>
+#include <private/qqmljsbinarytypedescription_p.h>
+#include <private/qqmljstypedescriptionreader_p.h>
 #include <private/qresourcerelocater_p.h>
 
 #include <algorithm>
+#include <atomic>
+#include <optional>
 
 using namespace Qt::Literals::StringLiterals;
 
@@ -55,6 +62,269 @@ static bool argumentsFromCommandLineAndFile(QStringList& allArguments, const QSt
     return true;
 }
 
+enum Output {
+    GenerateCpp,
+    GenerateCacheFile,
+    GenerateLoader,
+    GenerateLoaderStandAlone,
+};
+
+struct CompileOptions
+{
+    QStringList importPaths;
+    QStringList qmldirFiles;
+    QString cacheDirectory;
+    bool useResourceFiles = false;
+    bool onlyBytecode = false;
+    bool verbose = false;
+    bool warningsAreErrors = false;
+    bool validateBasicBlocks = false;
+    bool aotReport = false;
+};
+
+static bool preparseQmltypes(
+        const QString &inputFile, const QString &outputFileName, QString *errorString)
+{
+    QFile file(inputFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *errorString = file.errorString();
+        return false;
+    }
+
+    const QByteArray source = file.readAll();
+    QQmlJSTypeDescriptionReader reader(inputFile, QString::fromUtf8(source));
+    QList<QQmlJSExportedScope> objects;
+    QStringList dependencies;
+    if (!reader(&objects, &dependencies)) {
+        *errorString = reader.errorMessage();
+        return false;
+    }
+
+    return QQmlJSBinaryTypeDescription::write(
+            outputFileName, QQmlJSBinaryTypeDescription::sourceHash(source), objects,
+            dependencies, reader.warningMessage(), errorString);
+}
+
+static int compileFile(
+        const CompileOptions &options, QQmlJSImporter *importer, const QString &inputFile,
+        const QString &inputResourcePath, const QString &outputFileName, Output target)
+{
+    QString inputFileUrl = inputFile;
+    QQmlJSSaveFunction saveFunction;
+
+    if (target == GenerateCpp) {
+        inputFileUrl = "qrc://"_L1 + inputResourcePath;
+        saveFunction = [inputResourcePath, outputFileName](
+                               const QV4::CompiledData::SaveableUnitPointer &unit,
+                               const QQmlJSAotFunctionMap &aotFunctions,
+                               QString *errorString) {
+            return qSaveQmlJSUnitAsCpp(inputResourcePath, outputFileName, unit, aotFunctions, errorString);
+        };
+
+    } else {
+        saveFunction = [outputFileName](const QV4::CompiledData::SaveableUnitPointer &unit,
+                                        const QQmlJSAotFunctionMap &aotFunctions,
+                                        QString *errorString) {
+            Q_UNUSED(aotFunctions);
+            return unit.saveToDisk<char>(
+                    [&outputFileName, errorString](const char *data, quint32 size) {
+                        return QV4::CompiledData::SaveableUnitPointer::writeDataToFile(
+                                outputFileName, data, size, errorString);
+            });
+        };
+    }
+
+    if (inputFile.endsWith(".qml"_L1)) {
+        QQmlJSCompileError error;
+        if (target != GenerateCpp || inputResourcePath.isEmpty() || options.onlyBytecode) {
+            if (!qCompileQmlFile(inputFile, saveFunction, nullptr, &error,
+                                 /* storeSourceLocation */ false)) {
+                error.augment("Error compiling qml file: "_L1).print();
+                return EXIT_FAILURE;
+            }
+        } else {
+            QQmlJSLogger logger;
+
+            // Always trigger the qFatal() on "pragma Strict" violations.
+            logger.setCategoryLevel(qmlCompiler, QtWarningMsg);
+            logger.setCategoryIgnored(qmlCompiler, false);
+            logger.setCategoryFatal(qmlCompiler, true);
+
+            if (!options.verbose && !options.warningsAreErrors)
+                logger.setSilent(true);
+
+            QQmlJSAotCompiler cppCodeGen(
+                        importer, u':' + inputResourcePath, options.qmldirFiles, &logger);
+
+            if (options.validateBasicBlocks)
+                cppCodeGen.m_flags.setFlag(QQmlJSAotCompiler::ValidateBasicBlocks);
+
+            const QString reportSuffix = ".aotreport.json"_L1;
+            QString reportFileName = outputFileName;
+            if (reportFileName.endsWith(".cpp"_L1))
+                reportFileName.chop(".cpp"_L1.size());
+            reportFileName += reportSuffix;
+
+            // Warnings are only printed when compiling. Don't hide them behind the cache.
+            std::optional<QQmlJSCompilationCache> cache;
+            QByteArray cacheKey;
+            if (!options.cacheDirectory.isEmpty() && !options.verbose
+                    && !options.warningsAreErrors) {
+                QFile source(inputFile);
+                if (source.open(QIODevice::ReadOnly)) {
+                    cache.emplace(options.cacheDirectory);
+                    QStringList keyOptions;
+                    if (options.validateBasicBlocks)
+                        keyOptions.append("validate"_L1);
+                    if (options.aotReport)
+                        keyOptions.append("report"_L1);
+                    cacheKey = cache->key(importer, u':' + inputResourcePath,
+                                          options.qmldirFiles,
+                                          QString::fromUtf8(source.readAll()), keyOptions);
+                }
+
+                if (!cacheKey.isEmpty()
+                        && cache->restore(cacheKey, ".cpp"_L1, outputFileName)
+                        && (!options.aotReport
+                            || cache->restore(cacheKey, reportSuffix, reportFileName))) {
+                    // The warnings would be silenced anyway. Don't leave them to the next file.
+                    importer->takeGlobalWarnings();
+                    return EXIT_SUCCESS;
+                }
+            }
+
+            if (!qCompileQmlFile(inputFile, saveFunction, &cppCodeGen, &error,
+                                 /* storeSourceLocation */ true)) {
+                error.augment("Error compiling qml file: "_L1).print();
+                return EXIT_FAILURE;
+            }
+
+            if (options.aotReport) {
+                QQmlJSCompileError error;
+                if (!qSaveQmlJSAotReport(inputResourcePath, reportFileName,
+                                         cppCodeGen.report(), &error.message)) {
+                    error.augment("Error writing AOT report: "_L1).print();
+                    return EXIT_FAILURE;
+                }
+            }
+
+            QList<QQmlJS::DiagnosticMessage> warnings = importer->takeGlobalWarnings();
+
+            if (!warnings.isEmpty()) {
+                logger.log("Type warnings occurred while compiling file:"_L1,
+                           qmlImport, QQmlJS::SourceLocation());
+                logger.processMessages(warnings, qmlImport);
+                if (options.warningsAreErrors)
+                    return EXIT_FAILURE;
+            }
+
+            if (!cacheKey.isEmpty()) {
+                // Failing to populate the cache is not fatal. We've produced the output.
+                QQmlJSCompileError error;
+                if (!cache->store(cacheKey, ".cpp"_L1, outputFileName, &error.message)
+                        || (options.aotReport
+                            && !cache->store(cacheKey, reportSuffix, reportFileName,
+                                             &error.message))) {
+                    error.augment("Error storing result in cache: "_L1).print();
+                }
+            }
+        }
+    } else if (inputFile.endsWith(".js"_L1) || inputFile.endsWith(".mjs"_L1)) {
+        QQmlJSCompileError error;
+        if (!qCompileJSFile(inputFile, inputFileUrl, saveFunction, &error)) {
+            error.augment("Error compiling js file: "_L1).print();
+            return EXIT_FAILURE;
+        }
+    } else if (inputFile.endsWith(".qmltypes"_L1)) {
+        if (target != GenerateCacheFile) {
+            fprintf(stderr, "A .qmltypes file can only be pre-parsed into a cache file: %s\n",
+                    qPrintable(inputFile));
+            return EXIT_FAILURE;
+        }
+
+        QQmlJSCompileError error;
+        if (!preparseQmltypes(inputFile, outputFileName, &error.message)) {
+            error.augment("Error pre-parsing qmltypes file: "_L1).print();
+            return EXIT_FAILURE;
+        }
+    } else {
+        fprintf(stderr, "Ignoring %s input file as it is not QML source code - maybe remove from QML_FILES?\n", qPrintable(inputFile));
+        if (options.warningsAreErrors)
+            return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+struct BatchEntry
+{
+    QString inputFile;
+    QString resourcePath;
+    QString outputFile;
+};
+
+static bool readBatchFile(const QString &batchFileName, QList<BatchEntry> *entries)
+{
+    QFile batchFile(batchFileName);
+    if (!batchFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        fprintf(stderr, "Cannot open batch file %s: %s\n",
+                qPrintable(batchFileName), qPrintable(batchFile.errorString()));
+        return false;
+    }
+
+    while (!batchFile.atEnd()) {
+        const QString line = QString::fromUtf8(batchFile.readLine()).trimmed();
+        if (line.isEmpty())
+            continue;
+        const QStringList fields = line.split(u'\t');
+        if (fields.size() != 3) {
+            fprintf(stderr, "Invalid line in batch file %s: %s\n",
+                    qPrintable(batchFileName), qPrintable(line));
+            return false;
+        }
+        entries->append({ fields[0], fields[1], fields[2] });
+    }
+    return true;
+}
+
+// Compiles all entries on a thread pool. QQmlJSImporter is not thread safe. Each worker has
+// its own, and reuses it for all the files it compiles. The imports are therefore loaded once
+// per worker rather than once per file. Each file still gets the warnings of the imports it
+// uses, so the output doesn't depend on which worker compiled what.
+static int compileBatch(
+        const CompileOptions &options, const QQmlJSResourceFileMapper &fileMapper,
+        const QList<BatchEntry> &entries, int jobs)
+{
+    std::atomic<qsizetype> next = 0;
+    std::atomic<bool> failed = false;
+
+    const auto work = [&]() {
+        QQmlJSImporter importer(
+                    options.importPaths, options.useResourceFiles ? &fileMapper : nullptr);
+        for (qsizetype i = next++; i < entries.size(); i = next++) {
+            const BatchEntry &entry = entries[i];
+            importer.beginDocument();
+            const Output target = entry.outputFile.endsWith(".cpp"_L1)
+                    ? GenerateCpp
+                    : GenerateCacheFile;
+            if (compileFile(options, &importer, entry.inputFile, entry.resourcePath,
+                            entry.outputFile, target) != EXIT_SUCCESS) {
+                failed = true;
+            }
+        }
+    };
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(std::max(1, jobs));
+    const int workers = int(std::min<qsizetype>(pool.maxThreadCount(), entries.size()));
+    for (int i = 1; i < workers; ++i)
+        pool.start(work);
+    work();
+    pool.waitForDone();
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
 int main(int argc, char **argv)
 {
     // Produce reliably the same output for the same input by disabling QHash's random seeding.
@@ -97,6 +367,17 @@ int main(int argc, char **argv)
     QCommandLineOption validateBasicBlocksOption("validate-basic-blocks"_L1, QCoreApplication::translate("main", "Performs checks on the basic blocks of a function compiled ahead of time to validate its structure and coherence"));
     parser.addOption(validateBasicBlocksOption);
 
+    QCommandLineOption aotReportOption("aot-report"_L1, QCoreApplication::translate("main", "Write a JSON report listing the compile status of each binding and function, and the reasons for rejecting them, next to the generated C++ file"));
+    parser.addOption(aotReportOption);
+
+    QCommandLineOption cacheDirOption("cache-dir"_L1, QCoreApplication::translate("main", "Reuse the generated C++ code of earlier runs if neither the QML file nor the interfaces of the types it uses have changed. The results are stored in the given directory"), QCoreApplication::translate("main", "directory"));
+    parser.addOption(cacheDirOption);
+
+    QCommandLineOption batchOption("batch"_L1, QCoreApplication::translate("main", "Compile all files listed in the given file, sharing the loaded imports between them. Each line holds the input file, its resource path, and the output file, separated by tabs"), QCoreApplication::translate("main", "batch file"));
+    parser.addOption(batchOption);
+    QCommandLineOption jobsOption("jobs"_L1, QCoreApplication::translate("main", "Number of threads to use in batch mode. Defaults to the number of CPU cores"), QCoreApplication::translate("main", "number"));
+    parser.addOption(jobsOption);
+
     QCommandLineOption outputFileOption("o"_L1, QCoreApplication::translate("main", "Output file name"), QCoreApplication::translate("main", "file name"));
     parser.addOption(outputFileOption);
 
@@ -111,12 +392,48 @@ int main(int argc, char **argv)
 
     parser.process(arguments);
 
-    enum Output {
-        GenerateCpp,
-        GenerateCacheFile,
-        GenerateLoader,
-        GenerateLoaderStandAlone,
-    } target = GenerateCacheFile;
+    CompileOptions options;
+    if (parser.isSet(resourceOption)) {
+        options.importPaths.append("qt-project.org/imports"_L1);
+        options.importPaths.append("qt/qml"_L1);
+    }
+
+    if (parser.isSet(importPathOption))
+        options.importPaths.append(parser.values(importPathOption));
+
+    if (!parser.isSet(bareOption))
+        options.importPaths.append(QLibraryInfo::path(QLibraryInfo::QmlImportsPath));
+
+    options.qmldirFiles = parser.values(importsOption);
+    options.cacheDirectory = parser.value(cacheDirOption);
+    options.useResourceFiles = parser.isSet(resourceOption);
+    options.onlyBytecode = parser.isSet(onlyBytecode);
+    options.verbose = parser.isSet(verboseOption);
+    options.warningsAreErrors = parser.isSet(warningsAreErrorsOption);
+    options.validateBasicBlocks = parser.isSet(validateBasicBlocksOption);
+    options.aotReport = parser.isSet(aotReportOption);
+
+    if (parser.isSet(batchOption)) {
+        QList<BatchEntry> entries;
+        if (!readBatchFile(parser.value(batchOption), &entries))
+            return EXIT_FAILURE;
+
+        int jobs = QThread::idealThreadCount();
+        if (parser.isSet(jobsOption)) {
+            bool ok = false;
+            jobs = parser.value(jobsOption).toInt(&ok);
+            if (!ok || jobs < 1) {
+                fprintf(stderr, "Invalid number of jobs: %s\n",
+                        qPrintable(parser.value(jobsOption)));
+                return EXIT_FAILURE;
+            }
+        }
+
+        const QQmlJSResourceFileMapper fileMapper(parser.values(resourceOption));
+        return compileBatch(options, fileMapper, entries, jobs);
+    }
+
+    Output target = GenerateCacheFile;
 
     QString outputFileName;
     if (parser.isSet(outputFileOption))
@@ -168,9 +485,7 @@ int main(int argc, char **argv)
         }
         return EXIT_SUCCESS;
     }
-    QString inputFileUrl = inputFile;
 
-    QQmlJSSaveFunction saveFunction;
     QQmlJSResourceFileMapper fileMapper(parser.values(resourceOption));
     QString inputResourcePath = parser.value(resourcePathOption);
 
@@ -197,95 +512,7 @@ int main(int argc, char **argv)
         }
     }
 
-    if (target == GenerateCpp) {
-        inputFileUrl = "qrc://"_L1 + inputResourcePath;
-        saveFunction = [inputResourcePath, outputFileName](
-                               const QV4::CompiledData::SaveableUnitPointer &unit,
-                               const QQmlJSAotFunctionMap &aotFunctions,
-                               QString *errorString) {
-            return qSaveQmlJSUnitAsCpp(inputResourcePath, outputFileName, unit, aotFunctions, errorString);
-        };
-
-    } else {
-        saveFunction = [outputFileName](const QV4::CompiledData::SaveableUnitPointer &unit,
-                                        const QQmlJSAotFunctionMap &aotFunctions,
-                                        QString *errorString) {
-            Q_UNUSED(aotFunctions);
-            return unit.saveToDisk<char>(
-                    [&outputFileName, errorString](const char *data, quint32 size) {
-                        return QV4::CompiledData::SaveableUnitPointer::writeDataToFile(
-                                outputFileName, data, size, errorString);
-            });
-        };
-    }
-
-    if (inputFile.endsWith(".qml"_L1)) {
-        QQmlJSCompileError error;
-        if (target != GenerateCpp || inputResourcePath.isEmpty() || parser.isSet(onlyBytecode)) {
-            if (!qCompileQmlFile(inputFile, saveFunction, nullptr, &error,
-                                 /* storeSourceLocation */ false)) {
-                error.augment("Error compiling qml file: "_L1).print();
-                return EXIT_FAILURE;
-            }
-        } else {
-            QStringList importPaths;
-
-            if (parser.isSet(resourceOption)) {
-                importPaths.append("qt-project.org/imports"_L1);
-                importPaths.append("qt/qml"_L1);
-            };
-
-            if (parser.isSet(importPathOption))
-                importPaths.append(parser.values(importPathOption));
-
-            if (!parser.isSet(bareOption))
-                importPaths.append(QLibraryInfo::path(QLibraryInfo::QmlImportsPath));
-
-            QQmlJSImporter importer(
-                        importPaths, parser.isSet(resourceOption) ? &fileMapper : nullptr);
-            QQmlJSLogger logger;
-
-            // Always trigger the qFatal() on "pragma Strict" violations.
-            logger.setCategoryLevel(qmlCompiler, QtWarningMsg);
-            logger.setCategoryIgnored(qmlCompiler, false);
-            logger.setCategoryFatal(qmlCompiler, true);
-
-            if (!parser.isSet(verboseOption) && !parser.isSet(warningsAreErrorsOption))
-                logger.setSilent(true);
-
-            QQmlJSAotCompiler cppCodeGen(
-                        &importer, u':' + inputResourcePath, parser.values(importsOption), &logger);
-
-            if (parser.isSet(validateBasicBlocksOption))
-                cppCodeGen.m_flags.setFlag(QQmlJSAotCompiler::ValidateBasicBlocks);
-
-            if (!qCompileQmlFile(inputFile, saveFunction, &cppCodeGen, &error,
-                                 /* storeSourceLocation */ true)) {
-                error.augment("Error compiling qml file: "_L1).print();
-                return EXIT_FAILURE;
-            }
-
-            QList<QQmlJS::DiagnosticMessage> warnings = importer.takeGlobalWarnings();
-
-            if (!warnings.isEmpty()) {
-                logger.log("Type warnings occurred while compiling file:"_L1,
-                           qmlImport, QQmlJS::SourceLocation());
-                logger.processMessages(warnings, qmlImport);
-                if (parser.isSet(warningsAreErrorsOption))
-                    return EXIT_FAILURE;
-            }
-        }
-    } else if (inputFile.endsWith(".js"_L1) || inputFile.endsWith(".mjs"_L1)) {
-        QQmlJSCompileError error;
-        if (!qCompileJSFile(inputFile, inputFileUrl, saveFunction, &error)) {
-            error.augment("Error compiling js file: "_L1).print();
-            return EXIT_FAILURE;
-        }
-    } else {
-        fprintf(stderr, "Ignoring %s input file as it is not QML source code - maybe remove from QML_FILES?\n", qPrintable(inputFile));
-        if (parser.isSet(warningsAreErrorsOption))
-            return EXIT_FAILURE;
-    }
-
-    return EXIT_SUCCESS;
+    QQmlJSImporter importer(
+                options.importPaths, options.useResourceFiles ? &fileMapper : nullptr);
+    return compileFile(options, &importer, inputFile, inputResourcePath, outputFileName, target);
 }
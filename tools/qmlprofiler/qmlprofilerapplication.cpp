@@ -44,7 +44,9 @@ static const char *features[] = {
     "binding",
     "handlingsignal",
     "inputevents",
-    "debugmessages"
+    "debugmessages",
+    "quick3d",
+    "bindingstatistics"
 };
 
 Q_STATIC_ASSERT(sizeof(features) == MaximumProfileFeature * sizeof(char *));
@@ -35,7 +35,9 @@ static const char *MESSAGE_STRINGS[] = {
     "PixmapCache",
     "SceneGraph",
     "MemoryAllocation",
-    "DebugMessage"
+    "DebugMessage",
+    "Quick3DFrame",
+    "BindingStatistics"
 };
 
 Q_STATIC_ASSERT(sizeof(MESSAGE_STRINGS) == MaximumMessage * sizeof(const char *));
@@ -184,6 +186,10 @@ void QmlProfilerData::addEventType(const QQmlProfilerEventType &type)
     case DebugMessage:
         displayName = QString::fromLatin1("DebugMessage:%1").arg(type.detailType());
         break;
+    case Quick3DFrame:
+        displayName = QString::fromLatin1("Quick3D:%1").arg(type.detailType());
+        break;
+    case BindingStatistics:
     case MaximumMessage: {
         const QQmlProfilerEventLocation eventLocation = type.location();
         // generate hash
@@ -602,6 +608,12 @@ bool QmlProfilerData::save(const QString &filename)
             stream.writeAttribute("timing5", event, 4, false);
         } else if (type.message() == MemoryAllocation) {
             stream.writeAttribute("amount", event, 0);
+        } else if (type.message() == BindingStatistics) {
+            stream.writeAttribute("evaluations", event, 0);
+            stream.writeAttribute("totalTime", event, 1);
+            stream.writeAttribute("dependencies", event, 2);
+            stream.writeAttribute("churn", event, 3);
+            stream.writeAttribute("recaptures", event, 4);
         }
         stream.writeEndElement();
     };
@@ -124,6 +124,7 @@ void QmltcCodeWriter::writeGlobalHeader(QmltcOutputWrapper &code, const QString
 
     code.rawAppendToHeader(u"#include <private/qqmlengine_p.h>"); // executeRuntimeFunction(), etc.
     code.rawAppendToHeader(u"#include <private/qqmltcobjectcreationhelper_p.h>"); // QmltcSupportLib
+    code.rawAppendToHeader(u"#include <private/qqmlcppcomponent_p.h>"); // QmltcSupportLib
 
     code.rawAppendToHeader(u"#include <QtQml/qqmllist.h>"); // QQmlListProperty
 
@@ -27,6 +27,7 @@ Q_LOGGING_CATEGORY(lcQmltcCompiler, "qml.qmltc.compiler", QtWarningMsg);
 
 const QString QmltcCodeGenerator::privateEngineName = u"ePriv"_s;
 const QString QmltcCodeGenerator::typeCountName = u"q_qmltc_typeCount"_s;
+const QString QmltcCodeGenerator::createForComponentName = u"QML_createForComponent"_s;
 
 QmltcCompiler::QmltcCompiler(const QString &url, QmltcTypeResolver *resolver, QmltcVisitor *visitor,
                              QQmlJSLogger *logger)
@@ -339,6 +340,44 @@ void QmltcCompiler::compileType(
                           << u"%1 *result = new %1(engine, nullptr);"_s.arg(current.cppType)
                           << u"return result;"_s;
     }
+
+    if ((documentRoot || inlineComponent) && !isSingleton) {
+        // same as the external ctor, but with the caller's context and a hook
+        // to set the initial state before the component is completed
+        QmltcMethod createForComponent;
+        createForComponent.comments
+                << u"Used by QQmlCppComponent to create delegates of this type."_s;
+        createForComponent.type = QQmlJSMetaMethodType::StaticMethod;
+        createForComponent.access = QQmlJSMetaMethod::Public;
+        createForComponent.name = QmltcCodeGenerator::createForComponentName;
+        createForComponent.returnType = u"QObject *"_s;
+        createForComponent.parameterList = {
+            engine, ctxtdata,
+            QmltcVariable(u"QQmlCppComponent::InitialState *"_s, u"initialState"_s)
+        };
+        // NB: cast to select the baseline ctor over the external one
+        createForComponent.body
+                << u"auto object = new %1(static_cast<QObject *>(nullptr));"_s.arg(
+                           current.cppType)
+                << u"QQmltcObjectCreationBase<%1> objectHolder;"_s.arg(current.cppType)
+                << u"QQmltcObjectCreationHelper creator = objectHolder.view();"_s
+                << u"creator.set(0, object);"_s
+                << u"object->%1(&creator, engine, parentContext, /* finalize */ false);"_s.arg(
+                           current.init.name)
+                << u"object->%1(&creator, /* finalize */ true);"_s.arg(current.beginClass.name)
+                << u"object->%1(&creator, engine);"_s.arg(current.endInit.name)
+                << u"object->%1(&creator, engine);"_s.arg(current.setComplexBindings.name)
+                << u"if (initialState)"_s
+                << u"    initialState->set(object);"_s
+                << u"object->%1(&creator, /* finalize */ true);"_s.arg(
+                           current.completeComponent.name)
+                << u"object->%1(&creator, /* finalize */ true);"_s.arg(
+                           current.finalizeComponent.name)
+                << u"object->%1(&creator);"_s.arg(current.handleOnCompleted.name)
+                << u"return object;"_s;
+        current.functions.append(std::move(createForComponent));
+    }
+
     auto postponedQmlContextSetup = generator.generate_initCode(current, type);
     generator.generate_endInitCode(current, type);
     generator.generate_setComplexBindingsCode(current, type);
@@ -1056,6 +1095,32 @@ static QString generate_callCompilationUnit(const QString &urlMethodName)
 static std::pair<QQmlJSMetaProperty, int> getMetaPropertyIndex(const QQmlJSScope::ConstPtr &scope,
                                                                const QString &propertyName);
 
+/*!
+ * \internal
+ * Returns the qmltc-compiled type that \a object, wrapped in an implicit
+ * component, merely instantiates (as in \c{delegate: MyDelegate {}}). Objects
+ * of such components can be created by calling the compiled type directly.
+ * Returns null if \a object adds anything of its own to that type.
+ */
+static QQmlJSScope::ConstPtr directlyCreatableType(const QQmlJSScope::ConstPtr &object,
+                                                   qsizetype creationIndex)
+{
+    if (creationIndex != -1) // explicit component
+        return {};
+    const auto base = object->baseType();
+    // qmltc-compiled types are document and inline component roots whose file
+    // path is set to the generated header
+    if (!base || !base->isComposite() || base->isSingleton()
+        || !base->filePath().endsWith(u".h"_s)) {
+        return {};
+    }
+    if (!object->ownPropertyBindings().isEmpty() || !object->ownProperties().isEmpty()
+        || !object->ownMethods().isEmpty() || !object->ownEnumerations().isEmpty()) {
+        return {};
+    }
+    return base;
+}
+
 /*!
  * \internal
  * Helper method used to keep compileBindingByType() readable.
@@ -1106,10 +1171,19 @@ void QmltcCompiler::compileObjectBinding(QmltcType &current,
         *block << u"{"_s;
         *block << QStringLiteral("auto thisContext = QQmlData::get(%1)->outerContext;")
                           .arg(qobjectParent);
-        *block << QStringLiteral("auto %1 = QQmlObjectCreator::createComponent(engine, "
-                                 "%2, %3, %4, thisContext);")
-                          .arg(objectName, generate_callCompilationUnit(m_urlMethodName),
-                               QString::number(index), qobjectParent);
+        if (const auto delegateType = directlyCreatableType(object, creationIndex)) {
+            *block << QStringLiteral("auto %1 = QQmlCppComponent::create(engine, %2, %3, %4, "
+                                     "thisContext, &%5::%6);")
+                              .arg(objectName, generate_callCompilationUnit(m_urlMethodName),
+                                   QString::number(index), qobjectParent,
+                                   delegateType->internalName(),
+                                   QmltcCodeGenerator::createForComponentName);
+        } else {
+            *block << QStringLiteral("auto %1 = QQmlObjectCreator::createComponent(engine, "
+                                     "%2, %3, %4, thisContext);")
+                              .arg(objectName, generate_callCompilationUnit(m_urlMethodName),
+                                   QString::number(index), qobjectParent);
+        }
         *block << QStringLiteral("thisContext->installContext(QQmlData::get(%1), "
                                  "QQmlContextData::OrdinaryObject);")
                           .arg(objectName);
@@ -1201,6 +1275,17 @@ void QmltcCompiler::compileValueSourceOrInterceptorBinding(QmltcType &current,
                 QString::number(m_visitor->creationIndex(object)));
     }
 
+    // C++ properties are known by index, so the property doesn't have to be
+    // looked up by name at run time
+    if (!accessor.isValueType) {
+        if (const int index = getMetaPropertyIndex(type, propertyName).second; index >= 0) {
+            current.endInit.body
+                    << u"QT_PREPEND_NAMESPACE(QQmlCppOnAssignmentHelper)::set(%1, %2, %3);"_s.arg(
+                               objectName, accessor.name, QString::number(index));
+            return;
+        }
+    }
+
     // NB: we expect one "on" assignment per property, so creating
     // QQmlProperty each time should be fine (unlike QQmlListReference)
     current.endInit.body << u"{"_s;
@@ -1730,9 +1815,19 @@ void QmltcCompiler::compileScriptBinding(QmltcType &current,
             absoluteIndex = groupPropertyIndex; // e.g. index of accessor.name
         }
 
+        // All script bindings of an object share the JavaScript scope they are evaluated in.
+        // Create it on first use. NB: always using enclosing object as a scope for the binding
+        auto &bindingScope =
+                m_uniques[UniqueStringId(current, u"$bindingScope"_s)].bindingScopeName;
+        if (bindingScope.isEmpty()) {
+            bindingScope = u"bindingScope"_s;
+            current.setComplexBindings.body
+                    << u"QT_PREPEND_NAMESPACE(QQmlCppBindingScope) %1(%2, this);"_s.arg(
+                               bindingScope, generate_callCompilationUnit(m_urlMethodName));
+        }
+
         QmltcCodeGenerator::generate_createBindingOnProperty(
-                &current.setComplexBindings.body, generate_callCompilationUnit(m_urlMethodName),
-                u"this"_s, // NB: always using enclosing object as a scope for the binding
+                &current.setComplexBindings.body, bindingScope,
                 static_cast<qsizetype>(objectType->ownRuntimeFunctionIndex(binding.scriptIndex())),
                 bindingTarget, // binding target
                 // value types are special and are bound through valueTypeIndex
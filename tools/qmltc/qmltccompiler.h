@@ -180,6 +180,7 @@ private:
         QString qmlListVariableName;
         QString onAssignmentObjectName;
         QString attachedVariableName;
+        QString bindingScopeName;
     };
 
     QHash<QString, qsizetype> m_symbols;
@@ -212,18 +212,25 @@ void QmltcCodeGenerator::generate_callExecuteRuntimeFunction(
         *block << u"return " + returnValueName + u";";
 }
 
+/*!
+    \internal
+
+    Generates code that creates a binding for the JavaScript function at
+    \a functionIndex on the property \a p of \a target. \a bindingScope names
+    a QQmlCppBindingScope variable. All bindings of an object share it, so that
+    the QML context for the binding functions is only created once.
+*/
 void QmltcCodeGenerator::generate_createBindingOnProperty(
-        QStringList *block, const QString &unitVarName, const QString &scope,
-        qsizetype functionIndex, const QString &target, const QQmlJSScope::ConstPtr &targetType,
-        int propertyIndex, const QQmlJSMetaProperty &p, int valueTypeIndex,
-        const QString &subTarget)
+        QStringList *block, const QString &bindingScope, qsizetype functionIndex,
+        const QString &target, const QQmlJSScope::ConstPtr &targetType, int propertyIndex,
+        const QQmlJSMetaProperty &p, int valueTypeIndex, const QString &subTarget)
 {
     const QString propName = QQmlJSUtils::toLiteral(p.propertyName());
     if (QString bindable = p.bindable(); !bindable.isEmpty()) {
         // TODO: test that private properties are bindable
         QString createBindingForBindable = u"QT_PREPEND_NAMESPACE(QQmlCppBinding)::"
                                            u"createBindingForBindable("
-                + unitVarName + u", " + scope + u", " + QString::number(functionIndex) + u", "
+                + bindingScope + u", " + QString::number(functionIndex) + u", "
                 + target + u", " + QString::number(propertyIndex) + u", "
                 + QString::number(valueTypeIndex) + u", " + propName + u")";
         const QString accessor = (valueTypeIndex == -1) ? target : subTarget;
@@ -241,8 +248,8 @@ void QmltcCodeGenerator::generate_createBindingOnProperty(
         *block += epilogue;
     } else {
         QString createBindingForNonBindable =
-                u"QT_PREPEND_NAMESPACE(QQmlCppBinding)::createBindingForNonBindable(" + unitVarName
-                + u", " + scope + u", " + QString::number(functionIndex) + u", " + target + u", "
+                u"QT_PREPEND_NAMESPACE(QQmlCppBinding)::createBindingForNonBindable("
+                + bindingScope + u", " + QString::number(functionIndex) + u", " + target + u", "
                 + QString::number(propertyIndex) + u", " + QString::number(valueTypeIndex) + u", "
                 + propName + u")";
         // Note: in this version, the binding is set implicitly
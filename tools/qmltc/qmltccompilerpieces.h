@@ -28,6 +28,7 @@ struct QmltcCodeGenerator
 {
     static const QString privateEngineName;
     static const QString typeCountName;
+    static const QString createForComponentName;
 
     QString documentUrl;
     QmltcVisitor *visitor = nullptr;
@@ -95,9 +96,8 @@ struct QmltcCodeGenerator
                                                     const QString &returnType,
                                                     const QList<QmltcVariable> &parameters = {});
 
-    static void generate_createBindingOnProperty(QStringList *block, const QString &unitVarName,
-                                                 const QString &scope, qsizetype functionIndex,
-                                                 const QString &target,
+    static void generate_createBindingOnProperty(QStringList *block, const QString &bindingScope,
+                                                 qsizetype functionIndex, const QString &target,
                                                  const QQmlJSScope::ConstPtr &targetType,
                                                  int propertyIndex, const QQmlJSMetaProperty &p,
                                                  int valueTypeIndex, const QString &subTarget);